@@ -0,0 +1,74 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @ingroup     drivers_periph_crc
+ * @{
+ *
+ * @file
+ * @brief       CRC-32C using the SSE4.2 crc32 instruction of the host
+ *
+ * The instruction only implements the Castagnoli polynomial, CRC-32 is left
+ * to the software implementation. On hosts without SSE4.2, all requests are
+ * rejected.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "periph/crc.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("sse4.2")))
+static uint32_t _crc32c(uint32_t crc, const uint8_t *p, size_t len)
+{
+#if defined(__x86_64__)
+    for (; len >= sizeof(uint64_t); len -= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        crc = __builtin_ia32_crc32di(crc, word);
+        p += sizeof(word);
+    }
+#else
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        uint32_t word;
+        memcpy(&word, p, sizeof(word));
+        crc = __builtin_ia32_crc32si(crc, word);
+        p += sizeof(word);
+    }
+#endif
+    while (len--) {
+        crc = __builtin_ia32_crc32qi(crc, *p++);
+    }
+    return crc;
+}
+
+int crc_update(crc_type_t type, uint32_t *crc, const void *buf, size_t len)
+{
+    if ((type != CRC_TYPE_CRC32C) || !__builtin_cpu_supports("sse4.2")) {
+        return -ENOTSUP;
+    }
+
+    *crc = ~_crc32c(~*crc, buf, len);
+    return 0;
+}
+
+#else /* defined(__x86_64__) || defined(__i386__) */
+
+int crc_update(crc_type_t type, uint32_t *crc, const void *buf, size_t len)
+{
+    (void)type;
+    (void)crc;
+    (void)buf;
+    (void)len;
+    return -ENOTSUP;
+}
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @ingroup     drivers_periph_crypto_accel
+ * @{
+ *
+ * @file
+ * @brief       Mock crypto accelerator
+ *
+ * Jobs are computed by the software implementations in an interrupt raised
+ * by @ref crypto_accel_start(), which then signals completion like a DMA
+ * interrupt would. The software implementations don't call back into the
+ * accelerator, as @ref crypto_accel_run() refuses to run in interrupt
+ * context.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "native_internal.h"
+#include "periph/crypto_accel.h"
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ccm.h"
+#include "hashes/sha1.h"
+#include "hashes/sha2xx_common.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* signal used as completion interrupt */
+#define CRYPTO_ACCEL_SIGNAL     SIGUSR2
+
+static const crypto_accel_job_t *_job;
+static crypto_accel_cb_t _cb;
+static void *_arg;
+
+static int _sha1(const crypto_accel_job_t *job)
+{
+    if (!IS_USED(MODULE_HASHES)) {
+        return -ENOTSUP;
+    }
+
+    sha1_context ctx;
+
+    sha1_init(&ctx);
+    memcpy(ctx.state, job->state, sizeof(ctx.state));
+    sha1_update(&ctx, job->input, job->input_len);
+    memcpy(job->state, ctx.state, sizeof(ctx.state));
+    return 0;
+}
+
+static int _sha256(const crypto_accel_job_t *job)
+{
+    if (!IS_USED(MODULE_HASHES)) {
+        return -ENOTSUP;
+    }
+
+    sha2xx_context_t ctx = { 0 };
+
+    memcpy(ctx.state, job->state, sizeof(ctx.state));
+    sha2xx_update(&ctx, job->input, job->input_len);
+    memcpy(job->state, ctx.state, sizeof(ctx.state));
+    return 0;
+}
+
+static int _aes(const crypto_accel_job_t *job)
+{
+    cipher_t cipher;
+
+    if (cipher_init(&cipher, CIPHER_AES, job->key, job->key_len) < 0) {
+        return -ENOTSUP;
+    }
+
+    switch (job->op) {
+    case CRYPTO_ACCEL_AES_ECB_ENCRYPT:
+        cipher_encrypt_blocks(&cipher, job->input, job->output,
+                              job->input_len / AES_BLOCK_SIZE);
+        return 0;
+    case CRYPTO_ACCEL_AES_ECB_DECRYPT:
+        cipher_decrypt_blocks(&cipher, job->input, job->output,
+                              job->input_len / AES_BLOCK_SIZE);
+        return 0;
+    default:
+        break;
+    }
+
+    if (!IS_USED(MODULE_CIPHER_MODES)) {
+        return -ENOTSUP;
+    }
+
+    int res;
+    if (job->op == CRYPTO_ACCEL_AES_CCM_ENCRYPT) {
+        res = cipher_encrypt_ccm(&cipher, job->adata, job->adata_len,
+                                 job->mac_len, job->length_encoding,
+                                 job->nonce, job->nonce_len,
+                                 job->input, job->input_len, job->output);
+    }
+    else {
+        res = cipher_decrypt_ccm(&cipher, job->adata, job->adata_len,
+                                 job->mac_len, job->length_encoding,
+                                 job->nonce, job->nonce_len,
+                                 job->input, job->input_len, job->output);
+        if (res == CCM_ERR_INVALID_CBC_MAC) {
+            return -EBADMSG;
+        }
+    }
+    return (res < 0) ? -EINVAL : 0;
+}
+
+static void _isr(void)
+{
+    const crypto_accel_job_t *job = _job;
+    int res;
+
+    _job = NULL;
+    if (job == NULL) {
+        return;
+    }
+
+    switch (job->op) {
+    case CRYPTO_ACCEL_SHA1:
+        res = _sha1(job);
+        break;
+    case CRYPTO_ACCEL_SHA256:
+        res = _sha256(job);
+        break;
+    default:
+        res = _aes(job);
+        break;
+    }
+
+    DEBUG("crypto_accel: job %u done (%d)\n", (unsigned)job->op, res);
+    _cb(_arg, res);
+}
+
+void crypto_accel_init(void)
+{
+    register_interrupt(CRYPTO_ACCEL_SIGNAL, _isr);
+}
+
+int crypto_accel_start(const crypto_accel_job_t *job, crypto_accel_cb_t cb,
+                       void *arg)
+{
+    if (job->op > CRYPTO_ACCEL_AES_CCM_DECRYPT) {
+        return -ENOTSUP;
+    }
+
+    DEBUG("crypto_accel: starting job %u, %u bytes\n", (unsigned)job->op,
+          (unsigned)job->input_len);
+
+    _cb = cb;
+    _arg = arg;
+    _job = job;
+
+    /* completion interrupt */
+    kill(_native_pid, CRYPTO_ACCEL_SIGNAL);
+    return 0;
+}
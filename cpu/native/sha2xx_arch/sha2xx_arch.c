@@ -0,0 +1,122 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native
+ * @{
+ *
+ * @file
+ * @brief       SHA-256 block transform using the x86 SHA extensions
+ *
+ * Whether the host CPU supports the SHA extensions is checked at runtime,
+ * without them all blocks are left to the generic implementation.
+ *
+ * @}
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashes/sha2xx_common.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define CPUID_EBX_SHA   (1U << 29)
+
+#define TARGET_SHA      __attribute__((target("sha,sse4.1")))
+
+static int _supported = -1;
+
+static int _check_support(void)
+{
+    unsigned eax, ebx, ecx, edx;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    return (ebx & CPUID_EBX_SHA) != 0;
+}
+
+TARGET_SHA
+static void _transform(uint32_t *state, const uint8_t *blocks, size_t numof)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i msg[4];
+    __m128i tmp, state0, state1;
+
+    /* reorder the state words from ABCD EFGH to ABEF CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (numof--) {
+        __m128i abef = state0;
+        __m128i cdgh = state1;
+
+        for (unsigned i = 0; i < 16; i++) {
+            __m128i *m = &msg[i % 4];
+
+            if (i < 4) {
+                *m = _mm_shuffle_epi8(
+                    _mm_loadu_si128((const __m128i *)&blocks[16 * i]), bswap);
+            }
+            else {
+                /* W[t] from W[t - 16], W[t - 15], W[t - 7] and W[t - 2] */
+                *m = _mm_sha256msg1_epu32(*m, msg[(i + 1) % 4]);
+                *m = _mm_add_epi32(*m, _mm_alignr_epi8(msg[(i + 3) % 4],
+                                                       msg[(i + 2) % 4], 4));
+                *m = _mm_sha256msg2_epu32(*m, msg[(i + 3) % 4]);
+            }
+
+            tmp = _mm_add_epi32(*m, _mm_loadu_si128((const __m128i *)&K[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);
+            tmp = _mm_shuffle_epi32(tmp, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, tmp);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+        blocks += 64;
+    }
+
+    /* back to ABCD EFGH */
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+size_t sha2xx_transform_arch(uint32_t *state, const void *blocks, size_t numof)
+{
+    if (_supported < 0) {
+        _supported = _check_support();
+    }
+    if (!_supported || !numof) {
+        return 0;
+    }
+
+    _transform(state, blocks, numof);
+    return numof;
+}
+
+#else /* !(__x86_64__ || __i386__) */
+
+size_t sha2xx_transform_arch(uint32_t *state, const void *blocks, size_t numof)
+{
+    (void)state;
+    (void)blocks;
+    (void)numof;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_stm32
+ * @ingroup     drivers_periph_crc
+ * @{
+ *
+ * @file
+ * @brief       Low-level CRC driver implementation
+ *
+ * Only CRC units with input and output reflection are supported, the
+ * CRC-32C polynomial requires a programmable polynomial.
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crc.h"
+
+/* only build if the CRC unit can compute reflected CRCs */
+#ifdef CRC_CR_REV_IN
+
+/* below this, enabling the unit takes longer than the software
+ * implementation */
+#define CRC_MIN_LEN     (16U)
+
+/* input reflected per byte or per word, output reflected */
+#define CR_BYTES        (CRC_CR_REV_IN_0 | CRC_CR_REV_OUT)
+#define CR_WORDS        (CRC_CR_REV_IN | CRC_CR_REV_OUT)
+
+static mutex_t _lock = MUTEX_INIT;
+
+static void _clk_en(void)
+{
+#if defined(RCC_AHBENR_CRCEN)
+    periph_clk_en(AHB, RCC_AHBENR_CRCEN);
+#else
+    periph_clk_en(AHB1, RCC_AHB1ENR_CRCEN);
+#endif
+}
+
+static void _clk_dis(void)
+{
+#if defined(RCC_AHBENR_CRCEN)
+    periph_clk_dis(AHB, RCC_AHBENR_CRCEN);
+#else
+    periph_clk_dis(AHB1, RCC_AHB1ENR_CRCEN);
+#endif
+}
+
+static void _write_bytes(const uint8_t *p, size_t len)
+{
+    while (len--) {
+        *(__IO uint8_t *)&CRC->DR = *p++;
+    }
+}
+
+int crc_update(crc_type_t type, uint32_t *crc, const void *buf, size_t len)
+{
+    uint32_t poly;
+
+    switch (type) {
+    case CRC_TYPE_CRC32:
+        poly = 0x04C11DB7;
+        break;
+#ifdef CRC_POL_POL
+    case CRC_TYPE_CRC32C:
+        poly = 0x1EDC6F41;
+        break;
+#endif
+    default:
+        return -ENOTSUP;
+    }
+
+    if (len < CRC_MIN_LEN) {
+        return -ENOTSUP;
+    }
+    if (!mutex_trylock(&_lock)) {
+        return -EBUSY;
+    }
+
+    _clk_en();
+#ifdef CRC_POL_POL
+    CRC->POL = poly;
+#else
+    (void)poly;
+#endif
+    /* the unit works on the unreflected register */
+    CRC->INIT = __RBIT(~*crc);
+    CRC->CR = CR_BYTES | CRC_CR_RESET;
+
+    const uint8_t *p = buf;
+    size_t head = -(uintptr_t)p & (sizeof(uint32_t) - 1);
+    _write_bytes(p, head);
+    p += head;
+    len -= head;
+
+    /* little endian words are reflected as a whole */
+    CRC->CR = CR_WORDS;
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        CRC->DR = *(const uint32_t *)p;
+        p += sizeof(uint32_t);
+    }
+    CRC->CR = CR_BYTES;
+    _write_bytes(p, len);
+
+    *crc = ~CRC->DR;
+    _clk_dis();
+
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+#endif /* CRC_CR_REV_IN */
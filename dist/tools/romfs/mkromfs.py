@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Create a RomFS image from the files of a directory.
+
+The image can be written to a flash partition and mounted with the
+`romfs` file system driver. See sys/include/fs/romfs.h for the format.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"RMFS"
+HEADER = struct.Struct("<4sI")
+ENTRY = struct.Struct("<III")
+
+
+def _align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def mkromfs(root, align=4):
+    names = sorted(name for name in os.listdir(root)
+                   if os.path.isfile(os.path.join(root, name)))
+    for name in names:
+        if len(name.encode()) > 255:
+            raise ValueError("file name too long: %s" % name)
+
+    offset = HEADER.size + ENTRY.size * len(names)
+    name_offsets = []
+    for name in names:
+        name_offsets.append(offset)
+        offset += len(name.encode()) + 1
+
+    entries = []
+    for name, name_offset in zip(names, name_offsets):
+        offset = _align(offset, align)
+        with open(os.path.join(root, name), "rb") as f:
+            content = f.read()
+        entries.append((name_offset, offset, content))
+        offset += len(content)
+
+    image = bytearray(HEADER.pack(MAGIC, len(names)))
+    for name_offset, data_offset, content in entries:
+        image += ENTRY.pack(name_offset, data_offset, len(content))
+    for name in names:
+        image += name.encode() + b"\0"
+    for _, data_offset, content in entries:
+        image += b"\xff" * (data_offset - len(image))
+        image += content
+    return bytes(image)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("root", help="directory containing the files")
+    parser.add_argument("output", help="image file to create")
+    parser.add_argument("-a", "--align", type=int, default=4,
+                        help="alignment of the file data in bytes")
+    args = parser.parse_args()
+
+    if args.align < 1:
+        parser.error("alignment must be positive")
+
+    image = mkromfs(args.root, args.align)
+    with open(args.output, "wb") as f:
+        f.write(image)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
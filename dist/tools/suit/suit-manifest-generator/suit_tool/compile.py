@@ -272,6 +272,8 @@ def compile_manifest(options, m):
             }
             if any(['compression-info' in c and not c.get('decompress-on-load', False) for c in choices]):
                 InstParams['compression-info'] = lambda cid, data: data.get('compression-info')
+            if any(['source-component' in c for c in choices]):
+                InstParams['source-component'] = lambda cid, data: ('source-component', data['source-component'])
             InstCmds = {
                 'offset': lambda cid, data: mkCommand(
                     cid, 'condition-component-offset', None)
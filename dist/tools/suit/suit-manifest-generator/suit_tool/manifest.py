@@ -69,7 +69,7 @@ class SUITCommonInformation:
     def component_id_to_index(self, cid):
         id = -1
         for i, c in enumerate(self.component_ids):
-            if c == cid and i >= 0:
+            if c.items == cid.items and i >= 0:
                 id = componentIndex(i)
         for i, d in enumerate(self.dependencies):
             if d.digest == cid and i >= 0:
@@ -84,29 +84,6 @@ static void _at86rf2xx_set_key(ieee802154_sec_dev_t *dev,
     at86rf2xx_aes_key_write_encrypt((at86rf2xx_t *)dev->ctx, key);
 }
 
-/**
- * @brief   Compute CBC-MAC from IEEE 802.15.4 security context
- *
- * @param[in]       dev         Abstract security device descriptor
- * @param[out]      cipher      Buffer to store cipher blocks
- * @param[in]       iv          Initial vector
- * @param[in]       plain       Input data blocks
- * @param[in]       nblocks     Number of blocks
- */
-static void _at86rf2xx_cbc(const ieee802154_sec_dev_t *dev,
-                           uint8_t *cipher,
-                           uint8_t *iv,
-                           const uint8_t *plain,
-                           uint8_t nblocks)
-{
-    at86rf2xx_aes_cbc_encrypt((at86rf2xx_t *)dev->ctx,
-                              (aes_block_t *)cipher,
-                              NULL,
-                              iv,
-                              (aes_block_t *)plain,
-                              nblocks);
-}
-
 /**
  * @brief   Perform ECB encryption
  *
@@ -134,8 +111,7 @@ static void _at86rf2xx_ecb(const ieee802154_sec_dev_t *dev,
  */
 static const ieee802154_radio_cipher_ops_t _at86rf2xx_cipher_ops = {
     .set_key = _at86rf2xx_set_key,
-    .ecb = _at86rf2xx_ecb,
-    .cbc = _at86rf2xx_cbc
+    .ecb = _at86rf2xx_ecb
 };
 #endif /* IS_USED(MODULE_AT86RF2XX_AES_SPI) && \
           IS_USED(MODULE_IEEE802154_SECURITY) */
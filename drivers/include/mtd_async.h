@@ -0,0 +1,200 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_async  Asynchronous MTD operations
+ * @ingroup     drivers_storage
+ * @brief       Non-blocking MTD interface with completion events
+ *
+ * All functions of the @ref drivers_mtd API block the calling thread until
+ * the operation has finished, which for an erase of a flash sector can take
+ * many milliseconds. This module allows to queue MTD operations instead. The
+ * operations are executed one after another in the thread handling the event
+ * queue @ref MTD_ASYNC_EVENT_QUEUE, the completion of an operation is signaled
+ * by posting a user supplied event to a user supplied event queue.
+ *
+ * By default, operations are executed by the lowest priority event thread.
+ * Use `USEMODULE += event_thread_medium` to run the lowest priority events in
+ * a thread of their own, otherwise long operations delay all events of the
+ * medium priority queue.
+ *
+ * The operation descriptor and all buffers passed to the operation must stay
+ * valid until the operation has completed.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += mtd_async
+ * ```
+ *
+ * ```
+ * static void _erase_done(event_t *event)
+ * {
+ *     int res = mtd_async_result(&op);
+ *     ...
+ * }
+ *
+ * static event_t done = { .handler = _erase_done };
+ * static mtd_async_t op = MTD_ASYNC_INIT(&my_queue, &done);
+ *
+ * mtd_async_erase_sector(&op, MTD_0, sector, 1);
+ * // sample sensors while the sector is erased, _erase_done is called from
+ * // the thread handling my_queue when the erase has finished
+ * ```
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for asynchronous MTD operations
+ */
+
+#ifndef MTD_ASYNC_H
+#define MTD_ASYNC_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "event.h"
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Event queue the MTD operations are executed on
+ */
+#ifndef MTD_ASYNC_EVENT_QUEUE
+#define MTD_ASYNC_EVENT_QUEUE   EVENT_PRIO_LOWEST
+#endif
+
+/**
+ * @brief   MTD operation types
+ */
+typedef enum {
+    MTD_ASYNC_OP_READ_PAGE,         /**< @ref mtd_read_page */
+    MTD_ASYNC_OP_WRITE_PAGE,        /**< @ref mtd_write_page */
+    MTD_ASYNC_OP_WRITE_PAGE_RAW,    /**< @ref mtd_write_page_raw */
+    MTD_ASYNC_OP_ERASE_SECTOR,      /**< @ref mtd_erase_sector */
+} mtd_async_op_t;
+
+/**
+ * @brief   Descriptor of an asynchronous MTD operation
+ */
+typedef struct {
+    event_t event;              /**< event executing the operation */
+    event_queue_t *done_queue;  /**< queue to post @p done to */
+    event_t *done;              /**< event signaling completion, may be NULL */
+    mtd_dev_t *mtd;             /**< device of the operation */
+    union {
+        void *dest;             /**< buffer to read into */
+        const void *src;        /**< buffer to write from */
+    } buf;                      /**< data buffer */
+    uint32_t addr;              /**< page or sector number */
+    uint32_t offset;            /**< byte offset within the page */
+    uint32_t size;              /**< size in bytes or number of sectors */
+    mtd_async_op_t op;          /**< type of the operation */
+    volatile int res;           /**< result, -EINPROGRESS while pending */
+} mtd_async_t;
+
+/**
+ * @brief   Static initializer for @ref mtd_async_t
+ *
+ * @param   _queue      event queue to post @p _done to on completion
+ * @param   _done       event to post on completion, may be NULL
+ */
+#define MTD_ASYNC_INIT(_queue, _done) \
+{ \
+    .done_queue = _queue, \
+    .done = _done, \
+}
+
+/**
+ * @brief   Initialize an asynchronous MTD operation descriptor
+ *
+ * @param[out]  async   operation descriptor
+ * @param[in]   queue   event queue to post @p done to on completion
+ * @param[in]   done    event to post on completion, may be NULL
+ */
+void mtd_async_init(mtd_async_t *async, event_queue_t *queue, event_t *done);
+
+/**
+ * @brief   Queue reading data from an MTD device with pagewise addressing
+ *
+ * See @ref mtd_read_page for the parameters.
+ *
+ * @return  0 if the operation was queued
+ * @return  -EBUSY if @p async is still pending
+ */
+int mtd_async_read_page(mtd_async_t *async, mtd_dev_t *mtd, void *dest,
+                        uint32_t page, uint32_t offset, uint32_t size);
+
+/**
+ * @brief   Queue writing data to an MTD device with pagewise addressing
+ *
+ * See @ref mtd_write_page for the parameters. Requires the
+ * `mtd_write_page` module, the operation fails with -ENOTSUP otherwise.
+ *
+ * @return  0 if the operation was queued
+ * @return  -EBUSY if @p async is still pending
+ */
+int mtd_async_write_page(mtd_async_t *async, mtd_dev_t *mtd, const void *src,
+                         uint32_t page, uint32_t offset, uint32_t size);
+
+/**
+ * @brief   Queue writing data to an erased MTD device with pagewise addressing
+ *
+ * See @ref mtd_write_page_raw for the parameters.
+ *
+ * @return  0 if the operation was queued
+ * @return  -EBUSY if @p async is still pending
+ */
+int mtd_async_write_page_raw(mtd_async_t *async, mtd_dev_t *mtd, const void *src,
+                             uint32_t page, uint32_t offset, uint32_t size);
+
+/**
+ * @brief   Queue erasing sectors of an MTD device
+ *
+ * See @ref mtd_erase_sector for the parameters.
+ *
+ * @return  0 if the operation was queued
+ * @return  -EBUSY if @p async is still pending
+ */
+int mtd_async_erase_sector(mtd_async_t *async, mtd_dev_t *mtd,
+                           uint32_t sector, uint32_t count);
+
+/**
+ * @brief   Check whether an operation is still pending
+ *
+ * @param[in]   async   operation descriptor
+ *
+ * @return  true if the operation has not completed yet
+ */
+static inline bool mtd_async_pending(const mtd_async_t *async)
+{
+    return async->res == -EINPROGRESS;
+}
+
+/**
+ * @brief   Get the result of a completed operation
+ *
+ * @param[in]   async   operation descriptor
+ *
+ * @return  return value of the corresponding blocking MTD function
+ * @return  -EINPROGRESS if the operation has not completed yet
+ */
+static inline int mtd_async_result(const mtd_async_t *async)
+{
+    return async->res;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_ASYNC_H */
+/** @} */
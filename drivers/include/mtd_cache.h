@@ -0,0 +1,150 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache  MTD write-back sector cache
+ * @ingroup     drivers_storage
+ * @brief       Write-back cache of whole sectors for MTD devices
+ *
+ * This MTD module is stacked on top of an existing MTD device and keeps a
+ * configurable number of sectors of it in RAM. Writes only modify the cached
+ * copy of a sector; the sector is written back to the backing device when
+ * it is evicted from the cache, when @ref mtd_cache_flush is called or when
+ * the device is powered down using @ref mtd_power.
+ *
+ * The cache device allows overwriting data without erasing it first
+ * (@ref MTD_DRIVER_FLAG_DIRECT_WRITE). Unlike @ref mtd_write_page on a device
+ * that does not support this, a sequence of small writes to the same sector
+ * results in a single erase and write of that sector instead of one
+ * read-erase-write cycle per write. If the sector is known to be erased on the
+ * backing device (because it was erased through the cache) and the data
+ * written since then does not overlap with data already written back, only
+ * the modified part of the sector is written without erasing the sector.
+ *
+ * ## Usage
+ *
+ * To use this module include it in your makefile:
+ *
+ * ```
+ * USEMODULE += mtd_cache
+ * ```
+ *
+ * A cache with two sectors on top of `MTD_0` is defined as follows:
+ *
+ * ```
+ * static uint8_t cache_buf[2 * SECTOR_SIZE];
+ * static mtd_cache_line_t cache_lines[2];
+ *
+ * static mtd_cache_t cache = MTD_CACHE_INIT(MTD_0, cache_lines, cache_buf);
+ *
+ * mtd_dev_t *dev = &cache.base;
+ * ```
+ *
+ * Here `SECTOR_SIZE` is the sector size of `MTD_0` in bytes
+ * (mtd_dev_t::pages_per_sector * mtd_dev_t::page_size). The cache device
+ * inherits all properties of its backing device.
+ *
+ * @warning Data in the cache is lost on a reset or power failure, call
+ *          @ref mtd_cache_flush when data needs to be persisted.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for the MTD write-back sector cache
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "macros/utils.h"
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sector number of an unused cache line
+ */
+#define MTD_CACHE_SECTOR_NONE   (UINT32_MAX)
+
+/**
+ * @brief   Shortcut macro for initializing a @ref mtd_cache_t
+ *
+ * @param   _parent     backing MTD device (`mtd_dev_t *`)
+ * @param   _lines      array of @ref mtd_cache_line_t, one per cached sector
+ * @param   _buf        buffer of `ARRAY_SIZE(_lines)` times the sector size
+ *                      of @p _parent bytes
+ */
+#define MTD_CACHE_INIT(_parent, _lines, _buf) \
+{ \
+    .base = { \
+        .driver = &mtd_cache_driver, \
+    }, \
+    .parent = _parent, \
+    .lines = _lines, \
+    .lines_numof = ARRAY_SIZE(_lines), \
+    .buf = _buf, \
+    .lock = MUTEX_INIT, \
+}
+
+/**
+ * @brief   State of a cached sector
+ *
+ * Byte ranges are relative to the start of the sector, an empty range has
+ * `start == end`.
+ */
+typedef struct {
+    uint32_t sector;        /**< cached sector, @ref MTD_CACHE_SECTOR_NONE if unused */
+    uint32_t last_use;      /**< use counter at the last access, for LRU eviction */
+    uint32_t dirty_start;   /**< start of the range modified since the last write back */
+    uint32_t dirty_end;     /**< end of the range modified since the last write back */
+    uint32_t prog_start;    /**< start of the range written back since the last erase */
+    uint32_t prog_end;      /**< end of the range written back since the last erase */
+    bool erased;            /**< sector on the backing device is erased outside of the
+                                 written back range */
+} mtd_cache_line_t;
+
+/**
+ * @brief   Device descriptor of an MTD write-back sector cache
+ */
+typedef struct {
+    mtd_dev_t base;             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *parent;          /**< backing MTD device */
+    mtd_cache_line_t *lines;    /**< state of the cached sectors */
+    uint8_t lines_numof;        /**< number of sectors in the cache */
+    uint8_t *buf;               /**< data of the cached sectors */
+    uint32_t use_cnt;           /**< use counter, for LRU eviction */
+    mutex_t lock;               /**< mutex guarding the cache */
+} mtd_cache_t;
+
+/**
+ * @brief   MTD write-back sector cache operations table
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Write all modified sectors back to the backing device
+ *
+ * The sectors are kept in the cache.
+ *
+ * @param[in]   cache   cache device
+ *
+ * @return  0 on success
+ * @return  < 0 value on error of the backing device
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
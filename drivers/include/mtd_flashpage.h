@@ -62,6 +62,18 @@ typedef struct {
                              flash */
 } mtd_flashpage_t;
 
+/**
+ * @brief   Get the address of the first byte of a flashpage MTD device
+ *
+ * @param[in]   dev     flashpage MTD device
+ *
+ * @return  start address of @p dev in the memory map
+ */
+static inline const void *mtd_flashpage_addr(const mtd_flashpage_t *dev)
+{
+    return flashpage_addr(dev->offset / dev->base.pages_per_sector);
+}
+
 #ifdef __cplusplus
 }
 #endif
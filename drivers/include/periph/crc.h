@@ -0,0 +1,75 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_crc CRC
+ * @ingroup     drivers_periph
+ * @brief       Low-level interface to CRC calculation units
+ *
+ * This interface abstracts MCU peripherals or instructions that compute
+ * 32 bit CRCs. It is not meant to be used by applications directly: with
+ * `FEATURES_OPTIONAL += periph_crc`, @ref crc32() and @ref crc32c() hand
+ * work to the peripheral and fall back to their software implementation if
+ * the peripheral does not support a polynomial, rejects the input or is
+ * busy.
+ *
+ * The CRC state passed to @ref crc_update() is the checksum of the
+ * preceding data as returned by @ref crc32_update(), so computation can be
+ * split between the peripheral and the software implementation.
+ *
+ * On native, CRC-32C is computed with the SSE4.2 `crc32` instruction if the
+ * host supports it.
+ *
+ * @{
+ * @file
+ * @brief       CRC peripheral interface
+ */
+
+#ifndef PERIPH_CRC_H
+#define PERIPH_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   CRC algorithms
+ *
+ * All are reflected 32 bit CRCs with an initial value and final XOR of
+ * `0xffffffff`.
+ */
+typedef enum {
+    CRC_TYPE_CRC32,         /**< IEEE 802.3, polynomial `0x04c11db7` */
+    CRC_TYPE_CRC32C,        /**< Castagnoli, polynomial `0x1edc6f41` */
+} crc_type_t;
+
+/**
+ * @brief   Update a CRC with the CRC peripheral
+ *
+ * Never blocks waiting for the peripheral.
+ *
+ * @param[in]     type  CRC algorithm
+ * @param[in,out] crc   Checksum of the preceding data, 0 for none,
+ *                      updated to include @p buf on success
+ * @param[in]     buf   Input data, no alignment required
+ * @param[in]     len   Length of @p buf in bytes
+ *
+ * @retval  0           @p crc updated
+ * @retval  -ENOTSUP    Algorithm not supported, or @p len too short to be
+ *                      worth the setup cost
+ * @retval  -EBUSY      Peripheral in use
+ */
+int crc_update(crc_type_t type, uint32_t *crc, const void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_CRC_H */
+/** @} */
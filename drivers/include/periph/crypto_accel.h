@@ -0,0 +1,204 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_crypto_accel Crypto accelerator
+ * @ingroup     drivers_periph
+ * @brief       Low-level interface to hash and cipher accelerators
+ *
+ * This interface abstracts MCU peripherals that compute hashes or block
+ * ciphers, e.g. a HASH or CRYP peripheral. It is not meant to be used by
+ * applications directly: with `FEATURES_OPTIONAL += periph_crypto_accel`,
+ * @ref sys_hashes_sha1, @ref sys_hashes_sha256 and @ref sys_crypto (AES
+ * and CCM) hand work to the accelerator and fall back to their software
+ * implementation if the accelerator does not support an operation or is
+ * busy.
+ *
+ * A job is started with @ref crypto_accel_start() and runs asynchronously,
+ * e.g. driven by DMA. The driver signals completion by calling the callback,
+ * usually from interrupt context. @ref crypto_accel_run() wraps this for
+ * synchronous users.
+ *
+ * Drivers only have to implement the operations of @ref crypto_accel_op_t
+ * their hardware supports and can reject jobs they consider too short to be
+ * worth the setup cost. Jobs are never started from interrupt context and
+ * never concurrently.
+ *
+ * On native, a mock implementation computes the jobs in software and signals
+ * completion from an interrupt, to test the asynchronous path without
+ * hardware.
+ *
+ * @{
+ * @file
+ * @brief       Crypto accelerator peripheral interface
+ */
+
+#ifndef PERIPH_CRYPTO_ACCEL_H
+#define PERIPH_CRYPTO_ACCEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Operations of a crypto accelerator
+ */
+typedef enum {
+    CRYPTO_ACCEL_SHA1,              /**< SHA-1 block transform */
+    CRYPTO_ACCEL_SHA256,            /**< SHA-224/256 block transform */
+    CRYPTO_ACCEL_AES_ECB_ENCRYPT,   /**< AES encryption of whole blocks */
+    CRYPTO_ACCEL_AES_ECB_DECRYPT,   /**< AES decryption of whole blocks */
+    CRYPTO_ACCEL_AES_CCM_ENCRYPT,   /**< AES-CCM encryption and MAC creation */
+    CRYPTO_ACCEL_AES_CCM_DECRYPT,   /**< AES-CCM decryption and MAC check */
+} crypto_accel_op_t;
+
+/**
+ * @brief   Description of a crypto accelerator job
+ *
+ * Only the fields used by the operation have to be set.
+ */
+typedef struct {
+    crypto_accel_op_t op;       /**< Operation to perform */
+    /**
+     * @brief   Input data
+     *
+     * A multiple of the block size for the block transforms and ECB. For
+     * CCM decryption, the MAC follows the ciphertext.
+     */
+    const uint8_t *input;
+    size_t input_len;           /**< Length of @ref input in bytes */
+    /**
+     * @brief   Output data, not used by the hash operations
+     *
+     * As long as @ref input_len for ECB, the MAC follows the ciphertext for
+     * CCM encryption.
+     */
+    uint8_t *output;
+    /**
+     * @brief   Hash state in host byte order, updated in place
+     *
+     * Five words for SHA-1, eight words for SHA-256.
+     */
+    uint32_t *state;
+    const uint8_t *key;         /**< AES key */
+    uint8_t key_len;            /**< AES key length in bytes */
+    uint8_t mac_len;            /**< CCM MAC length in bytes */
+    uint8_t length_encoding;    /**< CCM length field size in bytes */
+    uint8_t nonce_len;          /**< CCM nonce length in bytes */
+    const uint8_t *nonce;       /**< CCM nonce */
+    const uint8_t *adata;       /**< CCM additional authenticated data */
+    size_t adata_len;           /**< Length of @ref adata in bytes */
+} crypto_accel_job_t;
+
+/**
+ * @brief   Signature of the job completion callback
+ *
+ * @param[in] arg   Argument passed to @ref crypto_accel_start()
+ * @param[in] res   0 on success, -EBADMSG if the CCM MAC did not match,
+ *                  other negative errno values on failure
+ */
+typedef void (*crypto_accel_cb_t)(void *arg, int res);
+
+/**
+ * @brief   Initialize the crypto accelerator
+ */
+void crypto_accel_init(void);
+
+/**
+ * @brief   Start a job
+ *
+ * The job and all buffers it references must stay valid until @p cb is
+ * called. @p cb may be called before the function returns.
+ *
+ * @param[in] job   Job to start
+ * @param[in] cb    Called when the job is done, in interrupt context
+ * @param[in] arg   Argument passed to @p cb
+ *
+ * @retval  0           Job started, @p cb will be called
+ * @retval  -ENOTSUP    Operation or parameters not supported,
+ *                      @p cb will not be called
+ */
+int crypto_accel_start(const crypto_accel_job_t *job, crypto_accel_cb_t cb,
+                       void *arg);
+
+/**
+ * @brief   Run a job and wait for its completion
+ *
+ * Used by the software implementations to hand work to the accelerator.
+ *
+ * @param[in] job   Job to run
+ *
+ * @retval  0           Job done
+ * @retval  -EBUSY      Accelerator in use, or called from interrupt context
+ * @retval  -ENOTSUP    Operation or parameters not supported
+ * @retval  -EBADMSG    CCM MAC did not match
+ * @return  other negative errno values on failure
+ */
+int crypto_accel_run(const crypto_accel_job_t *job);
+
+/**
+ * @brief   Run a hash block transform
+ *
+ * @param[in]     op        @ref CRYPTO_ACCEL_SHA1 or @ref CRYPTO_ACCEL_SHA256
+ * @param[in,out] state     Hash state in host byte order
+ * @param[in]     blocks    Input blocks
+ * @param[in]     len       Length of @p blocks, a multiple of 64
+ *
+ * @return  see @ref crypto_accel_run()
+ */
+static inline int crypto_accel_hash_blocks(crypto_accel_op_t op,
+                                           uint32_t *state,
+                                           const void *blocks, size_t len)
+{
+    const crypto_accel_job_t job = {
+        .op = op,
+        .input = blocks,
+        .input_len = len,
+        .state = state,
+    };
+
+    return crypto_accel_run(&job);
+}
+
+/**
+ * @brief   Run an AES ECB operation
+ *
+ * @param[in]  op       @ref CRYPTO_ACCEL_AES_ECB_ENCRYPT or
+ *                      @ref CRYPTO_ACCEL_AES_ECB_DECRYPT
+ * @param[in]  key      AES key
+ * @param[in]  key_len  Length of @p key in bytes
+ * @param[in]  input    Input blocks
+ * @param[out] output   Output blocks, may be equal to @p input
+ * @param[in]  len      Length of @p input, a multiple of 16
+ *
+ * @return  see @ref crypto_accel_run()
+ */
+static inline int crypto_accel_aes_ecb(crypto_accel_op_t op,
+                                       const uint8_t *key, uint8_t key_len,
+                                       const uint8_t *input, uint8_t *output,
+                                       size_t len)
+{
+    const crypto_accel_job_t job = {
+        .op = op,
+        .input = input,
+        .input_len = len,
+        .output = output,
+        .key = key,
+        .key_len = key_len,
+    };
+
+    return crypto_accel_run(&job);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_CRYPTO_ACCEL_H */
+/** @} */
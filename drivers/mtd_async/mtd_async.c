@@ -0,0 +1,127 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous MTD operations
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "container.h"
+#include "event.h"
+#include "event/thread.h"
+#include "mtd.h"
+#include "mtd_async.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static void _handler(event_t *event)
+{
+    mtd_async_t *async = container_of(event, mtd_async_t, event);
+    int res;
+
+    switch (async->op) {
+    case MTD_ASYNC_OP_READ_PAGE:
+        res = mtd_read_page(async->mtd, async->buf.dest, async->addr,
+                            async->offset, async->size);
+        break;
+    case MTD_ASYNC_OP_WRITE_PAGE:
+#ifdef MODULE_MTD_WRITE_PAGE
+        res = mtd_write_page(async->mtd, async->buf.src, async->addr,
+                             async->offset, async->size);
+#else
+        res = -ENOTSUP;
+#endif
+        break;
+    case MTD_ASYNC_OP_WRITE_PAGE_RAW:
+        res = mtd_write_page_raw(async->mtd, async->buf.src, async->addr,
+                                 async->offset, async->size);
+        break;
+    case MTD_ASYNC_OP_ERASE_SECTOR:
+        res = mtd_erase_sector(async->mtd, async->addr, async->size);
+        break;
+    default:
+        res = -EINVAL;
+        break;
+    }
+
+    DEBUG("mtd_async: op %u done: %d\n", (unsigned)async->op, res);
+
+    async->res = res;
+    if (async->done) {
+        event_post(async->done_queue, async->done);
+    }
+}
+
+static int _submit(mtd_async_t *async, mtd_async_op_t op, mtd_dev_t *mtd,
+                   uint32_t addr, uint32_t offset, uint32_t size)
+{
+    if (mtd_async_pending(async)) {
+        return -EBUSY;
+    }
+
+    async->event.handler = _handler;
+    async->mtd = mtd;
+    async->op = op;
+    async->addr = addr;
+    async->offset = offset;
+    async->size = size;
+    async->res = -EINPROGRESS;
+
+    event_post(MTD_ASYNC_EVENT_QUEUE, &async->event);
+    return 0;
+}
+
+void mtd_async_init(mtd_async_t *async, event_queue_t *queue, event_t *done)
+{
+    *async = (mtd_async_t)MTD_ASYNC_INIT(queue, done);
+}
+
+int mtd_async_read_page(mtd_async_t *async, mtd_dev_t *mtd, void *dest,
+                        uint32_t page, uint32_t offset, uint32_t size)
+{
+    if (mtd_async_pending(async)) {
+        return -EBUSY;
+    }
+
+    async->buf.dest = dest;
+    return _submit(async, MTD_ASYNC_OP_READ_PAGE, mtd, page, offset, size);
+}
+
+int mtd_async_write_page(mtd_async_t *async, mtd_dev_t *mtd, const void *src,
+                         uint32_t page, uint32_t offset, uint32_t size)
+{
+    if (mtd_async_pending(async)) {
+        return -EBUSY;
+    }
+
+    async->buf.src = src;
+    return _submit(async, MTD_ASYNC_OP_WRITE_PAGE, mtd, page, offset, size);
+}
+
+int mtd_async_write_page_raw(mtd_async_t *async, mtd_dev_t *mtd, const void *src,
+                             uint32_t page, uint32_t offset, uint32_t size)
+{
+    if (mtd_async_pending(async)) {
+        return -EBUSY;
+    }
+
+    async->buf.src = src;
+    return _submit(async, MTD_ASYNC_OP_WRITE_PAGE_RAW, mtd, page, offset, size);
+}
+
+int mtd_async_erase_sector(mtd_async_t *async, mtd_dev_t *mtd,
+                           uint32_t sector, uint32_t count)
+{
+    return _submit(async, MTD_ASYNC_OP_ERASE_SECTOR, mtd, sector, 0, count);
+}
@@ -0,0 +1,353 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       Write-back sector cache for MTD devices
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "container.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "mutex.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static uint32_t _sector_size(const mtd_cache_t *cache)
+{
+    return cache->base.pages_per_sector * cache->base.page_size;
+}
+
+static uint8_t *_line_data(mtd_cache_t *cache, const mtd_cache_line_t *line)
+{
+    return cache->buf + (line - cache->lines) * _sector_size(cache);
+}
+
+static void _line_reset(mtd_cache_line_t *line, uint32_t sector)
+{
+    line->sector = sector;
+    line->dirty_start = 0;
+    line->dirty_end = 0;
+    line->prog_start = 0;
+    line->prog_end = 0;
+    line->erased = false;
+}
+
+static mtd_cache_line_t *_find(mtd_cache_t *cache, uint32_t sector)
+{
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        if (cache->lines[i].sector == sector) {
+            return &cache->lines[i];
+        }
+    }
+    return NULL;
+}
+
+static int _load(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    mtd_dev_t *parent = cache->parent;
+
+    return mtd_read_page(parent, _line_data(cache, line),
+                         line->sector * parent->pages_per_sector, 0,
+                         _sector_size(cache));
+}
+
+static int _write_back(mtd_cache_t *cache, mtd_cache_line_t *line)
+{
+    mtd_dev_t *parent = cache->parent;
+    const uint32_t sector_size = _sector_size(cache);
+    const uint32_t page = line->sector * parent->pages_per_sector;
+    uint8_t *data = _line_data(cache, line);
+    int res;
+
+    if (line->dirty_start == line->dirty_end) {
+        return 0;
+    }
+
+    /* writes to the backing device need to be aligned to its write size */
+    uint32_t start = line->dirty_start - (line->dirty_start % parent->write_size);
+    uint32_t end = line->dirty_end + parent->write_size - 1;
+    end -= end % parent->write_size;
+    if (end > sector_size) {
+        end = sector_size;
+    }
+
+    if ((parent->driver->flags & MTD_DRIVER_FLAG_DIRECT_WRITE) ||
+        (line->erased && (end <= line->prog_start || start >= line->prog_end))) {
+        /* modified data can be written without erasing the sector first */
+        DEBUG("mtd_cache: write back sector %" PRIu32 " [%" PRIu32 ", %" PRIu32 ")\n",
+              line->sector, start, end);
+        res = mtd_write_page_raw(parent, data + start, page, start, end - start);
+        if (res < 0) {
+            return res;
+        }
+        if (line->prog_start == line->prog_end) {
+            line->prog_start = start;
+            line->prog_end = end;
+        }
+        else {
+            line->prog_start = (start < line->prog_start) ? start : line->prog_start;
+            line->prog_end = (end > line->prog_end) ? end : line->prog_end;
+        }
+    }
+    else {
+        DEBUG("mtd_cache: erase and write back sector %" PRIu32 "\n", line->sector);
+        line->erased = false;
+        res = mtd_erase_sector(parent, line->sector, 1);
+        if (res < 0) {
+            return res;
+        }
+        res = mtd_write_page_raw(parent, data, page, 0, sector_size);
+        if (res < 0) {
+            return res;
+        }
+        line->erased = true;
+        line->prog_start = 0;
+        line->prog_end = sector_size;
+    }
+
+    line->dirty_start = 0;
+    line->dirty_end = 0;
+    return 0;
+}
+
+static int _get_line(mtd_cache_t *cache, uint32_t sector, bool load,
+                     mtd_cache_line_t **out)
+{
+    mtd_cache_line_t *line = _find(cache, sector);
+    int res;
+
+    if (line == NULL) {
+        /* use a free line or evict the least recently used one */
+        for (unsigned i = 0; i < cache->lines_numof; i++) {
+            mtd_cache_line_t *l = &cache->lines[i];
+
+            if (l->sector == MTD_CACHE_SECTOR_NONE) {
+                line = l;
+                break;
+            }
+            if (line == NULL || (int32_t)(l->last_use - line->last_use) < 0) {
+                line = l;
+            }
+        }
+
+        if (line->sector != MTD_CACHE_SECTOR_NONE) {
+            res = _write_back(cache, line);
+            if (res < 0) {
+                return res;
+            }
+        }
+
+        _line_reset(line, sector);
+        if (load) {
+            res = _load(cache, line);
+            if (res < 0) {
+                line->sector = MTD_CACHE_SECTOR_NONE;
+                return res;
+            }
+        }
+    }
+
+    line->last_use = ++cache->use_cnt;
+    *out = line;
+    return 0;
+}
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    mtd_dev_t *parent = cache->parent;
+
+    assert(cache->lines_numof > 0);
+
+    int res = mtd_init(parent);
+    if (res < 0) {
+        return res;
+    }
+
+    /* inherit physical properties */
+    mtd->sector_count = parent->sector_count;
+    mtd->pages_per_sector = parent->pages_per_sector;
+    mtd->page_size = parent->page_size;
+    mtd->write_size = parent->write_size;
+
+    mutex_lock(&cache->lock);
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        _line_reset(&cache->lines[i], MTD_CACHE_SECTOR_NONE);
+    }
+    mutex_unlock(&cache->lock);
+
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *mtd, void *dest, uint32_t page,
+                      uint32_t offset, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    const uint32_t sector = page / mtd->pages_per_sector;
+    const uint32_t sector_offset = (page % mtd->pages_per_sector) * mtd->page_size + offset;
+    const uint32_t sector_size = _sector_size(cache);
+    int res;
+
+    /* do not cross sector boundaries, the MTD layer takes care of the rest */
+    if (size > sector_size - sector_offset) {
+        size = sector_size - sector_offset;
+    }
+
+    mutex_lock(&cache->lock);
+    mtd_cache_line_t *line = _find(cache, sector);
+    if (line != NULL) {
+        memcpy(dest, _line_data(cache, line) + sector_offset, size);
+        line->last_use = ++cache->use_cnt;
+        res = size;
+    }
+    else {
+        res = mtd_read_page(cache->parent, dest, page, offset, size);
+    }
+    mutex_unlock(&cache->lock);
+
+    if (res < 0) {
+        return res;
+    }
+
+    /* mtd_read_page() returns 0 on success
+     * but we are expected to return the read byte count */
+    return size;
+}
+
+static int _write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                       uint32_t offset, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+    const uint32_t sector = page / mtd->pages_per_sector;
+    const uint32_t sector_offset = (page % mtd->pages_per_sector) * mtd->page_size + offset;
+    const uint32_t sector_size = _sector_size(cache);
+    mtd_cache_line_t *line;
+
+    /* do not cross sector boundaries, the MTD layer takes care of the rest */
+    if (size > sector_size - sector_offset) {
+        size = sector_size - sector_offset;
+    }
+
+    mutex_lock(&cache->lock);
+    /* no need to read the sector if it is overwritten completely */
+    int res = _get_line(cache, sector, size < sector_size, &line);
+    if (res == 0) {
+        memcpy(_line_data(cache, line) + sector_offset, src, size);
+
+        if (line->dirty_start == line->dirty_end) {
+            line->dirty_start = sector_offset;
+            line->dirty_end = sector_offset + size;
+        }
+        else {
+            if (sector_offset < line->dirty_start) {
+                line->dirty_start = sector_offset;
+            }
+            if (sector_offset + size > line->dirty_end) {
+                line->dirty_end = sector_offset + size;
+            }
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    if (res < 0) {
+        return res;
+    }
+    return size;
+}
+
+static int _erase_sector(mtd_dev_t *mtd, uint32_t sector, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+
+    mutex_lock(&cache->lock);
+    int res = mtd_erase_sector(cache->parent, sector, count);
+    if (res == 0) {
+        /* discard modifications of erased sectors, keep their erased content */
+        for (unsigned i = 0; i < cache->lines_numof; i++) {
+            mtd_cache_line_t *line = &cache->lines[i];
+
+            if (line->sector == MTD_CACHE_SECTOR_NONE ||
+                line->sector < sector || line->sector >= sector + count) {
+                continue;
+            }
+            _line_reset(line, line->sector);
+            if (_load(cache, line) < 0) {
+                line->sector = MTD_CACHE_SECTOR_NONE;
+                continue;
+            }
+            line->erased = true;
+        }
+
+        /* a sector is typically erased to be written next, keep track of it
+         * so that it can be written back without erasing it again */
+        mtd_cache_line_t *line;
+        if (count == 1 && _find(cache, sector) == NULL) {
+            /* the evicted line may fail to be written back */
+            res = _get_line(cache, sector, true, &line);
+            if (res == 0) {
+                line->erased = true;
+            }
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+static int _power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, base);
+
+    if (power == MTD_POWER_DOWN) {
+        int res = mtd_cache_flush(cache);
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    return mtd_power(cache->parent, power);
+}
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    int res = 0;
+
+    mutex_lock(&cache->lock);
+    for (unsigned i = 0; i < cache->lines_numof; i++) {
+        mtd_cache_line_t *line = &cache->lines[i];
+
+        if (line->sector != MTD_CACHE_SECTOR_NONE) {
+            int tmp = _write_back(cache, line);
+            if (tmp < 0 && res == 0) {
+                res = tmp;
+            }
+        }
+    }
+    mutex_unlock(&cache->lock);
+
+    return res;
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read_page = _read_page,
+    .write_page = _write_page,
+    .erase_sector = _erase_sector,
+    .power = _power,
+    .flags = MTD_DRIVER_FLAG_DIRECT_WRITE,
+};
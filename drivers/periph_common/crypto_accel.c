@@ -0,0 +1,56 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_periph_crypto_accel
+ * @{
+ *
+ * @file
+ * @brief       Common crypto accelerator functions
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "periph/crypto_accel.h"
+
+/* held while a job is running */
+static mutex_t _lock = MUTEX_INIT;
+
+typedef struct {
+    mutex_t done;
+    int res;
+} _completion_t;
+
+static void _done(void *arg, int res)
+{
+    _completion_t *completion = arg;
+
+    completion->res = res;
+    mutex_unlock(&completion->done);
+}
+
+int crypto_accel_run(const crypto_accel_job_t *job)
+{
+    /* don't wait for the accelerator, the software fallback is faster than
+     * waiting for a job of another thread to finish */
+    if (irq_is_in() || !mutex_trylock(&_lock)) {
+        return -EBUSY;
+    }
+
+    _completion_t completion = { .done = MUTEX_INIT_LOCKED };
+    int res = crypto_accel_start(job, _done, &completion);
+    if (res == 0) {
+        mutex_lock(&completion.done);
+        res = completion.res;
+    }
+
+    mutex_unlock(&_lock);
+    return res;
+}
@@ -42,6 +42,9 @@
 #ifdef MODULE_PERIPH_INIT_HWRNG
 #include "periph/hwrng.h"
 #endif
+#ifdef MODULE_PERIPH_INIT_CRYPTO_ACCEL
+#include "periph/crypto_accel.h"
+#endif
 #ifdef MODULE_PERIPH_INIT_USBDEV
 #include "periph/usbdev.h"
 #endif
@@ -100,6 +103,10 @@ void periph_init(void)
     hwrng_init();
 #endif
 
+#ifdef MODULE_PERIPH_INIT_CRYPTO_ACCEL
+    crypto_accel_init();
+#endif
+
 #ifdef MODULE_PERIPH_INIT_USBDEV
     usbdev_init_lowlevel();
 #endif
@@ -157,6 +157,23 @@ extern "C" {
 #endif
 /** @} */
 
+/**
+ * @name Busy polling
+ *
+ * While the card signals busy, it is polled @ref SD_WAIT_FOR_NOT_BUSY_SPIN
+ * times in a row. Afterwards, the calling thread sleeps for
+ * @ref SD_WAIT_FOR_NOT_BUSY_SLEEP_US between polls to let other threads run.
+ *
+ * @{
+ */
+#ifndef SD_WAIT_FOR_NOT_BUSY_SPIN
+#define SD_WAIT_FOR_NOT_BUSY_SPIN     (16U)   /**< polls before sleeping */
+#endif
+#ifndef SD_WAIT_FOR_NOT_BUSY_SLEEP_US
+#define SD_WAIT_FOR_NOT_BUSY_SLEEP_US (100UL) /**< sleep between polls */
+#endif
+/** @} */
+
 /**
  * @brief memory capacity in bytes = (C_SIZE+1) * SD_CSD_V2_C_SIZE_BLOCK_MULT * BLOCK_LEN
  */
@@ -392,6 +392,7 @@ static inline void _send_dummy_byte(sdcard_spi_t *card)
 static inline bool _wait_for_not_busy(sdcard_spi_t *card, uint32_t retry_us)
 {
     uint32_t retry_timeout = _deadline_from_interval(retry_us);
+    unsigned polls = 0;
 
     do {
         uint8_t read_byte = 0x00;
@@ -403,6 +404,11 @@ static inline bool _wait_for_not_busy(sdcard_spi_t *card, uint32_t retry_us)
         else {
             DEBUG("_wait_for_not_busy: [BUSY]\n");
         }
+
+        /* programming takes up to several milliseconds, don't hog the CPU */
+        if (++polls >= SD_WAIT_FOR_NOT_BUSY_SPIN) {
+            ztimer_sleep(ZTIMER_USEC, SD_WAIT_FOR_NOT_BUSY_SLEEP_US);
+        }
     } while (retry_us && _deadline_left(retry_timeout));
 
     DEBUG("_wait_for_not_busy: [FAILED]\n");
@@ -256,6 +256,30 @@ PSEUDOMODULES += gnrc_sixlowpan_frag_sfr_congure_sfr
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
 PSEUDOMODULES += gnrc_sixlowpan_nd_border_router
 PSEUDOMODULES += gnrc_sixlowpan_router_default
+##
+## @addtogroup net_gnrc_tcp_congure
+## @{
+##
+PSEUDOMODULES += gnrc_tcp_congure
+## @defgroup net_gnrc_tcp_congure_abe gnrc_tcp_congure_abe: TCP Reno with ABE
+## @brief  Congestion control for GNRC TCP using the [TCP Reno congestion control algorithm with ABE](@ref sys_congure_abe)
+##
+## Provides an Alternative Backoff with Explicit Content Notification (ABE) to TCP-Reno-based congestion
+## control
+## @{
+PSEUDOMODULES += gnrc_tcp_congure_abe
+## @}
+## @defgroup net_gnrc_tcp_congure_reno gnrc_tcp_congure_reno: TCP Reno
+## @brief  Congestion control for GNRC TCP using the [TCP Reno congestion control algorithm](@ref sys_congure_reno)
+## @{
+PSEUDOMODULES += gnrc_tcp_congure_reno
+## @}
+## @defgroup net_gnrc_tcp_congure_quic gnrc_tcp_congure_quic: QUIC CC
+## @brief  Congestion control for GNRC TCP using the [congestion control algorithm of QUIC](@ref sys_congure_quic)
+## @{
+PSEUDOMODULES += gnrc_tcp_congure_quic
+## @}
+## @}
 ## @defgroup net_gnrc_udp_cmd  gnrc_udp_cmd
 ## @ingroup net_gnrc_udp
 ## @{
@@ -281,12 +305,22 @@ PSEUDOMODULES += heap_cmd
 PSEUDOMODULES += i2c_scan
 ## @}
 PSEUDOMODULES += ieee802154_security
+PSEUDOMODULES += ieee802154_security_soft_cipher
 PSEUDOMODULES += ieee802154_submac
 PSEUDOMODULES += ipv4
 PSEUDOMODULES += ipv6
 PSEUDOMODULES += l2filter_blacklist
 PSEUDOMODULES += l2filter_whitelist
 PSEUDOMODULES += libstdcpp
+
+## @defgroup pseudomodule_littlefs2_persist_lookahead littlefs2_persist_lookahead
+## @brief Save the littlefs2 allocator state on unmount
+##
+## Skips the traversal of the file system that littlefs2 performs before the
+## first block allocation after a mount, if the file system was unmounted
+## cleanly. See littlefs2_desc_t::state_dev.
+PSEUDOMODULES += littlefs2_persist_lookahead
+
 PSEUDOMODULES += log
 PSEUDOMODULES += lora
 PSEUDOMODULES += lwext4_no_gpl
@@ -523,6 +557,11 @@ PSEUDOMODULES += stm32_eth_auto
 PSEUDOMODULES += stm32_eth_link_up
 PSEUDOMODULES += stm32_eth_tracing
 PSEUDOMODULES += stm32mp1_eng_mode
+## @defgroup    pseudomodule_suit_delta suit_delta
+## @brief       Support VCDIFF delta payloads in SUIT updates
+##
+## See @ref sys_suit_delta.
+PSEUDOMODULES += suit_delta
 PSEUDOMODULES += suit_transport_%
 PSEUDOMODULES += suit_storage_%
 PSEUDOMODULES += sys_bus_%
@@ -563,6 +602,14 @@ PSEUDOMODULES += vfs_auto_mount
 ## backends.
 PSEUDOMODULES += vfs_default
 
+## @defgroup pseudomodule_vfs_readahead vfs_readahead
+## @brief Buffer sequential reads in the VFS layer
+##
+## When this module is active, small sequential reads from a file are served
+## from a read-ahead buffer that is filled by a single larger read of the file
+## system driver. See @ref CONFIG_VFS_READAHEAD_SIZE.
+PSEUDOMODULES += vfs_readahead
+
 PSEUDOMODULES += wakaama_objects_%
 PSEUDOMODULES += wifi_enterprise
 PSEUDOMODULES += xtimer_on_ztimer
@@ -616,10 +663,14 @@ PSEUDOMODULES += skald_eddystone
 PSEUDOMODULES += crypto_aes_128
 PSEUDOMODULES += crypto_aes_192
 PSEUDOMODULES += crypto_aes_256
+# Use the constant-time bitsliced AES implementation instead of the T tables
+PSEUDOMODULES += crypto_aes_bitsliced
 # By using this pseudomodule, T tables will be precalculated.
 PSEUDOMODULES += crypto_aes_precalculated
 # This pseudomodule causes a loop in AES to be unrolled (more flash, less CPU)
 PSEUDOMODULES += crypto_aes_unroll
+# This pseudomodule unrolls the SHA-224/256 rounds (more flash, less CPU)
+PSEUDOMODULES += hashes_sha2xx_unroll
 
 # declare shell version of test_utils_interactive_sync
 PSEUDOMODULES += test_utils_interactive_sync_shell
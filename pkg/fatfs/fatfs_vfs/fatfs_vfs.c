@@ -340,6 +340,50 @@ static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
     return (ssize_t)br;
 }
 
+static ssize_t _writev(vfs_file_t *filp, const iolist_t *iolist)
+{
+    fatfs_file_desc_t *fd = _get_fatfs_file_desc(filp);
+    ssize_t sum = 0;
+
+    for (; iolist; iolist = iolist->iol_next) {
+        UINT bw;
+        FRESULT res = f_write(&fd->file, iolist->iol_base, iolist->iol_len, &bw);
+
+        if (res != FR_OK) {
+            return sum ? sum : fatfs_err_to_errno(res);
+        }
+        sum += bw;
+        if (bw < iolist->iol_len) {
+            /* volume is full */
+            break;
+        }
+    }
+
+    return sum;
+}
+
+static ssize_t _readv(vfs_file_t *filp, const iolist_t *iolist)
+{
+    fatfs_file_desc_t *fd = _get_fatfs_file_desc(filp);
+    ssize_t sum = 0;
+
+    for (; iolist; iolist = iolist->iol_next) {
+        UINT br;
+        FRESULT res = f_read(&fd->file, iolist->iol_base, iolist->iol_len, &br);
+
+        if (res != FR_OK) {
+            return sum ? sum : fatfs_err_to_errno(res);
+        }
+        sum += br;
+        if (br < iolist->iol_len) {
+            /* end of file */
+            break;
+        }
+    }
+
+    return sum;
+}
+
 static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
 {
     fatfs_file_desc_t *fd = _get_fatfs_file_desc(filp);
@@ -574,6 +618,8 @@ static const vfs_file_ops_t fatfs_file_ops = {
     .close = _close,
     .read = _read,
     .write = _write,
+    .readv = _readv,
+    .writev = _writev,
     .lseek = _lseek,
     .fstat = _fstat,
     .fsync = _fsync,
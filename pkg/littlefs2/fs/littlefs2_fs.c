@@ -26,6 +26,11 @@
 
 #include "fs/littlefs2_fs.h"
 
+#if IS_USED(MODULE_LITTLEFS2_PERSIST_LOOKAHEAD)
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#endif
+
 #define ENABLE_DEBUG 0
 #include <debug.h>
 
@@ -168,6 +173,210 @@ static int prepare(littlefs2_desc_t *fs)
     return 0;
 }
 
+#if IS_USED(MODULE_LITTLEFS2_PERSIST_LOOKAHEAD)
+/* attribute of the root directory holding the generation counter */
+#define ATTR_GENERATION     (0x47)
+#define ALLOC_STATE_MAGIC   (0x4c415346UL)
+
+/* saved allocator state, followed by the lookahead bitmap */
+typedef struct {
+    uint32_t magic;
+    uint32_t generation;
+    uint32_t block_count;
+    uint32_t lookahead_size;
+    uint32_t off;
+    uint32_t size;
+    uint32_t i;
+    uint32_t ack;
+    uint32_t meta;
+    uint32_t crc;
+} _alloc_state_t;
+
+static uint16_t _alloc_state_crc(const _alloc_state_t *state, const void *lookahead)
+{
+    uint16_t crc = crc16_ccitt_false_calc((const void *)state,
+                                          offsetof(_alloc_state_t, crc));
+    return crc16_ccitt_false_update(crc, lookahead, state->lookahead_size);
+}
+
+static uint32_t _alloc_state_sectors(const littlefs2_desc_t *fs)
+{
+    const mtd_dev_t *dev = fs->state_dev;
+    uint32_t sector_size = dev->pages_per_sector * dev->page_size;
+
+    return (sizeof(_alloc_state_t) + fs->config.lookahead_size + sector_size - 1)
+           / sector_size;
+}
+
+/* maximum length of the directory paths visited by _meta_walk() */
+#define META_PATH_MAX       (64)
+
+static uint32_t _meta_add(uint32_t crc, const lfs_mdir_t *m)
+{
+    const uint32_t meta[] = { m->pair[0], m->pair[1], m->rev, m->off, m->etag };
+
+    return crc32_update(crc, meta, sizeof(meta));
+}
+
+static int _meta_walk(lfs_t *lfs, char *path, size_t len,
+                      struct lfs_info *info, uint32_t *crc)
+{
+    lfs_dir_t dir;
+    lfs_block_t pair = (lfs_block_t)-1;
+    int res = lfs_dir_open(lfs, &dir, path);
+
+    if (res < 0) {
+        return res;
+    }
+
+    while (1) {
+        /* a directory spans several metadata pairs if it is split */
+        if (dir.m.pair[0] != pair) {
+            pair = dir.m.pair[0];
+            *crc = _meta_add(*crc, &dir.m);
+        }
+        res = lfs_dir_read(lfs, &dir, info);
+        if (res <= 0) {
+            break;
+        }
+        if (info->type != LFS_TYPE_DIR ||
+            !strcmp(info->name, ".") || !strcmp(info->name, "..")) {
+            continue;
+        }
+
+        /* no separator after the root directory */
+        size_t sep = (len > 1);
+        size_t name_len = strlen(info->name);
+        if (len + sep + name_len >= META_PATH_MAX) {
+            res = LFS_ERR_NAMETOOLONG;
+            break;
+        }
+        path[len] = '/';
+        memcpy(&path[len + sep], info->name, name_len + 1);
+        res = _meta_walk(lfs, path, len + sep + name_len, info, crc);
+        path[len] = '\0';
+        if (res < 0) {
+            break;
+        }
+    }
+
+    lfs_dir_close(lfs, &dir);
+    return res;
+}
+
+/* Fingerprint of the metadata of all directories. Every change of the file
+ * system is committed to the metadata pair of a directory, which changes its
+ * revision or the offset of its last commit, also if the change is made by
+ * firmware that does not save the allocator state. Unlike a traversal of the
+ * file system, this does not read the blocks of files. */
+static int _meta_fingerprint(lfs_t *lfs, uint32_t *crc)
+{
+    char path[META_PATH_MAX] = "/";
+    struct lfs_info info;
+
+    *crc = 0;
+    return _meta_walk(lfs, path, 1, &info, crc);
+}
+
+static void _alloc_state_restore(littlefs2_desc_t *fs)
+{
+    mtd_dev_t *dev = fs->state_dev;
+    _alloc_state_t state;
+    uint32_t generation = 0;
+    uint32_t meta = 0;
+
+    if (!dev || mtd_init(dev) ||
+        mtd_read_page(dev, &state, 0, 0, sizeof(state)) ||
+        state.magic != ALLOC_STATE_MAGIC) {
+        return;
+    }
+
+    /* a saved state is only valid for the file system it was taken from, and
+     * only if the file system has not been modified since */
+    bool valid = state.block_count == fs->config.block_count &&
+                 state.lookahead_size == fs->config.lookahead_size &&
+                 state.off < state.block_count && state.ack <= state.block_count &&
+                 state.size <= 8 * state.lookahead_size && state.i <= state.size &&
+                 lfs_getattr(&fs->fs, "/", ATTR_GENERATION, &generation,
+                             sizeof(generation)) == sizeof(generation) &&
+                 state.generation == generation &&
+                 _meta_fingerprint(&fs->fs, &meta) == 0 &&
+                 state.meta == meta &&
+                 !mtd_read_page(dev, fs->lookahead_buf, 0, sizeof(state),
+                                state.lookahead_size) &&
+                 state.crc == _alloc_state_crc(&state, fs->lookahead_buf);
+
+    /* the state is outdated as soon as the file system is modified, it must
+     * not be restored if it cannot be erased */
+    if (mtd_erase_sector(dev, 0, _alloc_state_sectors(fs))) {
+        DEBUG("littlefs: erasing allocator state failed\n");
+        return;
+    }
+
+    if (valid) {
+        DEBUG("littlefs: restore allocator state, generation %" PRIu32 "\n",
+              generation);
+        fs->fs.free.off = state.off;
+        fs->fs.free.size = state.size;
+        fs->fs.free.i = state.i;
+        fs->fs.free.ack = state.ack;
+    }
+}
+
+static void _alloc_state_save(littlefs2_desc_t *fs)
+{
+    mtd_dev_t *dev = fs->state_dev;
+    uint32_t generation = 0;
+
+    if (!dev || mtd_init(dev) ||
+        (sizeof(_alloc_state_t) % dev->write_size) ||
+        (fs->config.lookahead_size % dev->write_size)) {
+        return;
+    }
+
+    /* tie the saved state to the current content of the file system, this
+     * is the last write before unmounting */
+    if (lfs_getattr(&fs->fs, "/", ATTR_GENERATION, &generation,
+                    sizeof(generation)) != sizeof(generation)) {
+        generation = 0;
+    }
+    generation++;
+    if (lfs_setattr(&fs->fs, "/", ATTR_GENERATION, &generation,
+                    sizeof(generation)) < 0) {
+        return;
+    }
+
+    uint32_t meta;
+    if (_meta_fingerprint(&fs->fs, &meta) < 0) {
+        return;
+    }
+
+    _alloc_state_t state = {
+        .magic = ALLOC_STATE_MAGIC,
+        .generation = generation,
+        .block_count = fs->config.block_count,
+        .lookahead_size = fs->config.lookahead_size,
+        .off = fs->fs.free.off,
+        .size = fs->fs.free.size,
+        .i = fs->fs.free.i,
+        .ack = fs->fs.free.ack,
+        .meta = meta,
+    };
+    state.crc = _alloc_state_crc(&state, fs->lookahead_buf);
+
+    DEBUG("littlefs: save allocator state, generation %" PRIu32 "\n", generation);
+    if (mtd_erase_sector(dev, 0, _alloc_state_sectors(fs)) ||
+        mtd_write_page_raw(dev, fs->lookahead_buf, 0, sizeof(state),
+                           state.lookahead_size) ||
+        mtd_write_page_raw(dev, &state, 0, 0, sizeof(state))) {
+        DEBUG("littlefs: saving allocator state failed\n");
+    }
+}
+#else
+static inline void _alloc_state_restore(littlefs2_desc_t *fs) { (void)fs; }
+static inline void _alloc_state_save(littlefs2_desc_t *fs) { (void)fs; }
+#endif
+
 static int _format(vfs_mount_t *mountp)
 {
     littlefs2_desc_t *fs = mountp->private_data;
@@ -202,6 +411,9 @@ static int _mount(vfs_mount_t *mountp)
     }
 
     ret = lfs_mount(&fs->fs, &fs->config);
+    if (ret == LFS_ERR_OK) {
+        _alloc_state_restore(fs);
+    }
     mutex_unlock(&fs->lock);
 
     return littlefs_err_to_errno(ret);
@@ -215,6 +427,7 @@ static int _umount(vfs_mount_t *mountp)
 
     DEBUG("littlefs: umount: mountp=%p\n", (void *)mountp);
 
+    _alloc_state_save(fs);
     int ret = lfs_unmount(&fs->fs);
     mutex_unlock(&fs->lock);
 
@@ -379,6 +592,65 @@ static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
     return littlefs_err_to_errno(ret);
 }
 
+static ssize_t _writev(vfs_file_t *filp, const iolist_t *iolist)
+{
+    littlefs2_desc_t *fs = filp->mp->private_data;
+    lfs_file_t *fp = _get_lfs_file(filp);
+    ssize_t sum = 0;
+
+    mutex_lock(&fs->lock);
+
+    DEBUG("littlefs: writev: filp=%p, fp=%p, iolist=%p\n",
+          (void *)filp, (void *)fp, (void *)iolist);
+
+    /* all snips end up in the file cache before it is flushed */
+    for (; iolist; iolist = iolist->iol_next) {
+        lfs_ssize_t ret = lfs_file_write(&fs->fs, fp, iolist->iol_base,
+                                         iolist->iol_len);
+        if (ret < 0) {
+            sum = sum ? sum : littlefs_err_to_errno(ret);
+            break;
+        }
+        sum += ret;
+        if ((lfs_size_t)ret < iolist->iol_len) {
+            /* volume is full */
+            break;
+        }
+    }
+    mutex_unlock(&fs->lock);
+
+    return sum;
+}
+
+static ssize_t _readv(vfs_file_t *filp, const iolist_t *iolist)
+{
+    littlefs2_desc_t *fs = filp->mp->private_data;
+    lfs_file_t *fp = _get_lfs_file(filp);
+    ssize_t sum = 0;
+
+    mutex_lock(&fs->lock);
+
+    DEBUG("littlefs: readv: filp=%p, fp=%p, iolist=%p\n",
+          (void *)filp, (void *)fp, (void *)iolist);
+
+    for (; iolist; iolist = iolist->iol_next) {
+        lfs_ssize_t ret = lfs_file_read(&fs->fs, fp, iolist->iol_base,
+                                        iolist->iol_len);
+        if (ret < 0) {
+            sum = sum ? sum : littlefs_err_to_errno(ret);
+            break;
+        }
+        sum += ret;
+        if ((size_t)ret < iolist->iol_len) {
+            /* end of file */
+            break;
+        }
+    }
+    mutex_unlock(&fs->lock);
+
+    return sum;
+}
+
 static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
 {
     littlefs2_desc_t *fs = filp->mp->private_data;
@@ -551,6 +823,8 @@ static const vfs_file_ops_t littlefs_file_ops = {
     .close = _close,
     .read = _read,
     .write = _write,
+    .readv = _readv,
+    .writev = _writev,
     .lseek = _lseek,
     .fsync = _fsync,
 };
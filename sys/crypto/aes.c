@@ -32,6 +32,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -39,6 +40,10 @@
 #include "crypto/ciphers.h"
 #include "kernel_defines.h"
 
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+#include "periph/crypto_accel.h"
+#endif
+
 #if !IS_USED(MODULE_CRYPTO_AES_128) && !IS_USED(MODULE_CRYPTO_AES_192) && \
     !IS_USED(MODULE_CRYPTO_AES_256)
     #error "sys/crypto/aes: No aes module used."
@@ -64,12 +69,8 @@
  * @brief AES key
  * @see cipher_context_t
  */
-typedef struct {
-    /** @cond INTERNAL */
-    uint32_t rd_key[4 * (AES_MAXNR + 1)];
-    int rounds;
-    /** @endcond */
-} aes_key_t;
+typedef aes_key_schedule_t aes_key_t;
+
 /**
  * Interface to the aes cipher
  */
@@ -77,7 +78,9 @@ static const cipher_interface_t aes_interface = {
     AES_BLOCK_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks
 };
 
 const cipher_id_t CIPHER_AES = &aes_interface;
@@ -825,18 +828,18 @@ static const u32 rcon[] = {
     0x1B000000, 0x36000000,
 };
 
+static bool _key_size_supported(uint8_t keySize)
+{
+    return (keySize == AES_KEY_SIZE_128 && IS_USED(MODULE_CRYPTO_AES_128)) ||
+           (keySize == AES_KEY_SIZE_192 && IS_USED(MODULE_CRYPTO_AES_192)) ||
+           (keySize == AES_KEY_SIZE_256 && IS_USED(MODULE_CRYPTO_AES_256));
+}
+
 int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
 {
     uint8_t i;
 
-    if (keySize != AES_KEY_SIZE_128 && keySize != AES_KEY_SIZE_192 &&
-        keySize != AES_KEY_SIZE_256) {
-        return CIPHER_ERR_INVALID_KEY_SIZE;
-    }
-
-    if ((keySize == AES_KEY_SIZE_128 && !IS_USED(MODULE_CRYPTO_AES_128)) ||
-        (keySize == AES_KEY_SIZE_192 && !IS_USED(MODULE_CRYPTO_AES_192)) ||
-        (keySize == AES_KEY_SIZE_256 && !IS_USED(MODULE_CRYPTO_AES_256))) {
+    if (!_key_size_supported(keySize)) {
         return CIPHER_ERR_INVALID_KEY_SIZE;
     }
 
@@ -1062,23 +1065,12 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 
 #ifndef AES_ASM
 /*
- * Encrypt a single block
+ * Encrypt a single block with an expanded key
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static void _encrypt_block(const aes_key_t *key, const uint8_t *plainBlock,
+                           uint8_t *cipherBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    aes_key_t aeskey;
-    const aes_key_t *key = &aeskey;
-
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE(context) * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 
@@ -1327,28 +1319,71 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4((t2) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
 }
 
-/*
- * Decrypt a single block
- * in and out can overlap
- */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
 {
-    /* setup AES_KEY */
-    int res;
-    aes_key_t aeskey;
-    const aes_key_t *key = &aeskey;
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
 
-    res = aes_set_decrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE(context) * 8, &aeskey);
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks)
+{
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+    if (crypto_accel_aes_ecb(CRYPTO_ACCEL_AES_ECB_ENCRYPT, context->context,
+                             AES_KEY_SIZE(context), input, output,
+                             blocks * AES_BLOCK_SIZE) == 0) {
+        return 1;
+    }
+#endif
+
+    /* setup AES_KEY once for all blocks */
+    aes_key_t aeskey;
+    int res = aes_set_encrypt_key((unsigned char *)context->context,
+                                  AES_KEY_SIZE(context) * 8, &aeskey);
 
     if (res < 0) {
         return res;
     }
 
+    while (blocks--) {
+        _encrypt_block(&aeskey, input, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+    return 1;
+}
+
+int aes_expand_key(aes_key_schedule_t *schedule, const uint8_t *key,
+                   uint8_t key_size)
+{
+    if (!_key_size_supported(key_size)) {
+        return CIPHER_ERR_INVALID_KEY_SIZE;
+    }
+
+    aes_set_encrypt_key(key, key_size * 8, schedule);
+    return CIPHER_INIT_SUCCESS;
+}
+
+void aes_encrypt_expanded(const aes_key_schedule_t *schedule,
+                          const uint8_t *input, uint8_t *output,
+                          size_t blocks)
+{
+    while (blocks--) {
+        _encrypt_block(schedule, input, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
+}
+
+/*
+ * Decrypt a single block with an expanded key
+ * in and out can overlap
+ */
+static void _decrypt_block(const aes_key_t *key, const uint8_t *cipherBlock,
+                           uint8_t *plainBlock)
+{
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 
@@ -1589,6 +1624,39 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4((t0) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1);
+}
+
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks)
+{
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+    if (crypto_accel_aes_ecb(CRYPTO_ACCEL_AES_ECB_DECRYPT, context->context,
+                             AES_KEY_SIZE(context), input, output,
+                             blocks * AES_BLOCK_SIZE) == 0) {
+        return 1;
+    }
+#endif
+
+    /* setup AES_KEY once for all blocks */
+    aes_key_t aeskey;
+    int res = aes_set_decrypt_key((unsigned char *)context->context,
+                                  AES_KEY_SIZE(context) * 8, &aeskey);
+
+    if (res < 0) {
+        return res;
+    }
+
+    while (blocks--) {
+        _decrypt_block(&aeskey, input, output);
+        input += AES_BLOCK_SIZE;
+        output += AES_BLOCK_SIZE;
+    }
     return 1;
 }
 
@@ -88,14 +88,97 @@ static void _keystream(chacha20poly1305_ctx_t *ctx, const uint8_t *key,
     _add_initial(ctx, key, nonce, blk);
 }
 
+#define BLOCKS      CONFIG_CRYPTO_CHACHA20POLY1305_BLOCKS
+
+static inline uint32_t _rotl(uint32_t v, unsigned c)
+{
+    return (v << c) | (v >> (32 - c));
+}
+
+/* Quarter round on all blocks. Every row holds the same state word of all
+ * blocks, so the loop maps onto SIMD lanes if the target has them. This is a
+ * macro so the row indices are constants, otherwise the compiler can't tell
+ * the rows apart and doesn't vectorize. */
+#define QR_BLOCKS(x, a, b, c, d) \
+    for (unsigned i = 0; i < BLOCKS; i++) { \
+        x[a][i] += x[b][i]; \
+        x[d][i] = _rotl(x[d][i] ^ x[a][i], 16); \
+        x[c][i] += x[d][i]; \
+        x[b][i] = _rotl(x[b][i] ^ x[c][i], 12); \
+        x[a][i] += x[b][i]; \
+        x[d][i] = _rotl(x[d][i] ^ x[a][i], 8); \
+        x[c][i] += x[d][i]; \
+        x[b][i] = _rotl(x[b][i] ^ x[c][i], 7); \
+    }
+
+/* xcrypt BLOCKS consecutive blocks, starting at block counter blk */
+static void _xcrypt_blocks(uint32_t x[16][BLOCKS], const uint8_t *key,
+                           const uint8_t *nonce, uint32_t blk,
+                           const uint8_t *in, uint8_t *out)
+{
+    uint32_t initial[16];
+
+    for (unsigned i = 0; i < 4; i++) {
+        initial[i] = constant[i];
+    }
+    for (unsigned i = 0; i < 8; i++) {
+        initial[i + 4] = unaligned_get_u32(key + 4 * i);
+    }
+    initial[12] = blk;
+    for (unsigned i = 0; i < 3; i++) {
+        initial[i + 13] = unaligned_get_u32(nonce + 4 * i);
+    }
+
+    for (unsigned w = 0; w < 16; w++) {
+        for (unsigned i = 0; i < BLOCKS; i++) {
+            x[w][i] = initial[w];
+        }
+    }
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        x[12][i] += i;
+    }
+
+    for (unsigned r = 0; r < 10; r++) {
+        QR_BLOCKS(x, 0, 4,  8, 12);
+        QR_BLOCKS(x, 1, 5,  9, 13);
+        QR_BLOCKS(x, 2, 6, 10, 14);
+        QR_BLOCKS(x, 3, 7, 11, 15);
+        QR_BLOCKS(x, 0, 5, 10, 15);
+        QR_BLOCKS(x, 1, 6, 11, 12);
+        QR_BLOCKS(x, 2, 7,  8, 13);
+        QR_BLOCKS(x, 3, 4,  9, 14);
+    }
+
+    for (unsigned i = 0; i < BLOCKS; i++) {
+        for (unsigned w = 0; w < 16; w++) {
+            uint32_t k = x[w][i] + initial[w] + ((w == 12) ? i : 0);
+            k ^= unaligned_get_u32(in + 4 * w);
+            memcpy(out + 4 * w, &k, sizeof(k));
+        }
+        in += 64;
+        out += 64;
+    }
+}
+
 static void _xcrypt(chacha20poly1305_ctx_t *ctx, const uint8_t *key,
                     const uint8_t *nonce, const uint8_t *in, uint8_t *out, size_t len)
 {
     /* Number of full 64 byte blocks */
     const size_t num_blocks = len >> 6;
     size_t pos = 0;
-    /* xcrypt full blocks */
-    for (size_t i = 0; i < num_blocks; i++, pos += 64) {
+    size_t i = 0;
+
+    /* xcrypt groups of full blocks in parallel */
+    if (BLOCKS > 1) {
+        uint32_t x[16][BLOCKS];
+
+        for (; i + BLOCKS <= num_blocks; i += BLOCKS, pos += 64 * BLOCKS) {
+            _xcrypt_blocks(x, key, nonce, i + 1, &in[pos], &out[pos]);
+        }
+        crypto_secure_wipe(x, sizeof(x));
+    }
+    /* xcrypt remaining full blocks */
+    for (; i < num_blocks; i++, pos += 64) {
         _keystream(ctx, key, nonce, i+1);
         for (size_t j = 0; j < 64; j++) {
             out[pos+j] = in[pos+j] ^ ((uint8_t*)ctx->state)[j];
@@ -55,8 +55,6 @@ int cipher_encrypt_cbc(const cipher_t *cipher, uint8_t iv[16],
 int cipher_decrypt_cbc(const cipher_t *cipher, uint8_t iv[16],
                        const uint8_t *input, size_t length, uint8_t *output)
 {
-    size_t offset = 0;
-    const uint8_t *input_block, *input_block_last;
     uint8_t block_size;
 
     block_size = cipher_get_block_size(cipher);
@@ -64,23 +62,19 @@ int cipher_decrypt_cbc(const cipher_t *cipher, uint8_t iv[16],
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
-    input_block_last = iv;
-    do {
-        input_block = input + offset;
-        uint8_t *output_block = output + offset;
-
-        if (cipher_decrypt(cipher, input_block, output_block) != 1) {
-            return CIPHER_ERR_DEC_FAILED;
-        }
-
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (uint8_t i = 0; i < block_size; ++i) {
-            output_block[i] ^= input_block_last[i];
-        }
+    /* Unlike encryption, all blocks can be decrypted independently */
+    if (cipher_decrypt_blocks(cipher, input, output,
+                              length / block_size) != 1) {
+        return CIPHER_ERR_DEC_FAILED;
+    }
 
-        input_block_last = input_block;
-        offset += block_size;
-    } while (offset < length);
+    /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
+    for (uint8_t i = 0; i < block_size; ++i) {
+        output[i] ^= iv[i];
+    }
+    for (size_t i = block_size; i < length; ++i) {
+        output[i] ^= input[i - block_size];
+    }
 
-    return offset;
+    return length;
 }
@@ -19,11 +19,18 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 #include "crypto/modes/ccm.h"
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+#include <errno.h>
+#include "periph/crypto_accel.h"
+#endif
 
 static inline int min(int a, int b)
 {
@@ -161,6 +168,65 @@ static int ccm_compute_adata_mac(const cipher_t *cipher, const uint8_t *auth_dat
     return 0;
 }
 
+/*
+ * CTR encryption and CBC-MAC of the payload. The two block cipher operations
+ * of every block are independent of each other, so they are passed to the
+ * cipher in a single call. When decrypting, the plaintext is only known after
+ * the CTR step, so the CBC-MAC lags one block behind.
+ */
+static int ccm_crypt_payload(const cipher_t *cipher, uint8_t mac[16],
+                             uint8_t nonce_counter[16], int ctr_len,
+                             const uint8_t *input, size_t length,
+                             uint8_t *output, bool decrypt)
+{
+    uint8_t blocks[2 * CCM_BLOCK_SIZE];
+    const uint8_t *plain = decrypt ? output : input;
+    size_t mac_pending = 0;
+    size_t offset;
+
+    for (offset = 0; offset < length; offset += CCM_BLOCK_SIZE) {
+        size_t block_len = (length - offset > CCM_BLOCK_SIZE) ?
+                           CCM_BLOCK_SIZE : length - offset;
+        size_t mac_offset = decrypt ? offset - mac_pending : offset;
+        size_t mac_len = decrypt ? mac_pending : block_len;
+        size_t numof = 1;
+
+        memcpy(blocks, nonce_counter, CCM_BLOCK_SIZE);
+        crypto_block_inc_ctr(nonce_counter, ctr_len);
+
+        if (mac_len) {
+            memcpy(&blocks[CCM_BLOCK_SIZE], mac, CCM_BLOCK_SIZE);
+            for (size_t i = 0; i < mac_len; ++i) {
+                blocks[CCM_BLOCK_SIZE + i] ^= plain[mac_offset + i];
+            }
+            numof = 2;
+        }
+
+        if (cipher_encrypt_blocks(cipher, blocks, blocks, numof) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        if (numof == 2) {
+            memcpy(mac, &blocks[CCM_BLOCK_SIZE], CCM_BLOCK_SIZE);
+        }
+
+        for (size_t i = 0; i < block_len; ++i) {
+            output[offset + i] = input[offset + i] ^ blocks[i];
+        }
+        mac_pending = block_len;
+    }
+
+    if (decrypt && mac_pending) {
+        for (size_t i = 0; i < mac_pending; ++i) {
+            mac[i] ^= plain[length - mac_pending + i];
+        }
+        if (cipher_encrypt(cipher, mac, mac) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+    }
+
+    return length;
+}
+
 /* Check if 'value' can be stored in 'num_bytes' */
 static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
 {
@@ -172,6 +238,43 @@ static inline int _fits_in_nbytes(size_t value, uint8_t num_bytes)
     return (value >> shift) <= 1;
 }
 
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+/* Hand the complete operation to the accelerator. Returns -ENOTSUP or -EBUSY
+ * if it has to be done in software. */
+static int ccm_accel(const cipher_t *cipher, crypto_accel_op_t op,
+                     const uint8_t *auth_data, uint32_t auth_data_len,
+                     uint8_t mac_length, uint8_t length_encoding,
+                     const uint8_t *nonce, size_t nonce_len,
+                     const uint8_t *input, size_t input_len,
+                     uint8_t *output)
+{
+    /* the software implementation pads or truncates other nonce lengths and
+     * reports its own errors for unsupported additional data lengths */
+    if ((cipher->interface != CIPHER_AES) ||
+        (nonce_len != (size_t)15 - length_encoding) ||
+        (auth_data_len > 0xFEFF)) {
+        return -ENOTSUP;
+    }
+
+    const crypto_accel_job_t job = {
+        .op = op,
+        .input = input,
+        .input_len = input_len,
+        .output = output,
+        .key = cipher->context.context,
+        .key_len = cipher->context.key_size,
+        .mac_len = mac_length,
+        .length_encoding = length_encoding,
+        .nonce_len = nonce_len,
+        .nonce = nonce,
+        .adata = auth_data,
+        .adata_len = auth_data_len,
+    };
+
+    return crypto_accel_run(&job);
+}
+#endif
+
 int cipher_encrypt_ccm(const cipher_t *cipher,
                        const uint8_t *auth_data, uint32_t auth_data_len,
                        uint8_t mac_length, uint8_t length_encoding,
@@ -192,6 +295,18 @@ int cipher_encrypt_ccm(const cipher_t *cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+    len = ccm_accel(cipher, CRYPTO_ACCEL_AES_CCM_ENCRYPT, auth_data,
+                    auth_data_len, mac_length, length_encoding, nonce,
+                    nonce_len, input, input_len, output);
+    if (len == 0) {
+        return input_len + mac_length;
+    }
+    if ((len != -ENOTSUP) && (len != -EBUSY)) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
+#endif
+
     /* Create B0, encrypt it (X1) and use it as mac_iv */
     block_size = cipher_get_block_size(cipher);
     assert(block_size == CCM_BLOCK_SIZE);
@@ -206,10 +321,7 @@ int cipher_encrypt_ccm(const cipher_t *cipher,
         return len;
     }
 
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
-    if (len < 0) {
-        return len;
-    }
+    memcpy(mac, mac_iv, block_size);
 
     /* Compute first stream block */
     nonce_counter[0] = length_encoding - 1;
@@ -221,10 +333,10 @@ int cipher_encrypt_ccm(const cipher_t *cipher,
         return len;
     }
 
-    /* Encrypt message in counter mode  */
+    /* Encrypt message in counter mode and compute the MAC (T) over it */
     crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
+    len = ccm_crypt_payload(cipher, mac, nonce_counter, block_size - nonce_len,
+                            input, input_len, output, false);
     if (len < 0) {
         return len;
     }
@@ -260,6 +372,23 @@ int cipher_decrypt_ccm(const cipher_t *cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+    if (input_len >= mac_length) {
+        len = ccm_accel(cipher, CRYPTO_ACCEL_AES_CCM_DECRYPT, auth_data,
+                        auth_data_len, mac_length, length_encoding, nonce,
+                        nonce_len, input, input_len, plain);
+        if (len == 0) {
+            return input_len - mac_length;
+        }
+        if (len == -EBADMSG) {
+            return CCM_ERR_INVALID_CBC_MAC;
+        }
+        if ((len != -ENOTSUP) && (len != -EBUSY)) {
+            return CIPHER_ERR_DEC_FAILED;
+        }
+    }
+#endif
+
     /* Compute first stream block */
     nonce_counter[0] = length_encoding - 1;
     block_size = cipher_get_block_size(cipher);
@@ -272,27 +401,24 @@ int cipher_decrypt_ccm(const cipher_t *cipher,
         return len;
     }
 
-    /* Decrypt message in counter mode */
-    plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
-    }
-
     /* Create B0, encrypt it (X1) and use it as mac_iv */
+    plain_len = input_len - mac_length;
     if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
                           nonce, nonce_len, plain_len, mac_iv) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calculation (T) with additional data and plaintext */
+    /* MAC calculation (T) with additional data */
     len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
     if (len < 0) {
         return len;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
+    memcpy(mac, mac_iv, block_size);
+
+    /* Decrypt message in counter mode and compute the MAC over the plaintext */
+    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+    len = ccm_crypt_payload(cipher, mac, nonce_counter, block_size - nonce_len,
+                            input, plain_len, plain, true);
     if (len < 0) {
         return len;
     }
@@ -18,6 +18,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 
@@ -26,24 +28,36 @@ int cipher_encrypt_ctr(const cipher_t *cipher, uint8_t nonce_counter[16],
                        uint8_t *output)
 {
     size_t offset = 0;
-    uint8_t stream_block[16] = { 0 }, block_size;
+    uint8_t stream_blocks[CONFIG_CRYPTO_MODES_CTR_BLOCKS *
+                          CIPHER_MAX_BLOCK_SIZE], block_size;
 
     block_size = cipher_get_block_size(cipher);
     do {
-        uint8_t block_size_input;
+        size_t remaining = length - offset, chunk;
+        size_t numof = 0;
+
+        /* Encrypt the counter blocks for as much of the remaining input as
+         * fits into the buffer with a single call */
+        do {
+            memcpy(&stream_blocks[numof * block_size], nonce_counter,
+                   block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+            numof++;
+        } while ((numof < CONFIG_CRYPTO_MODES_CTR_BLOCKS) &&
+                 (numof * block_size < remaining));
 
-        if (cipher_encrypt(cipher, nonce_counter, stream_block) != 1) {
+        if (cipher_encrypt_blocks(cipher, stream_blocks, stream_blocks,
+                                  numof) != 1) {
             return CIPHER_ERR_ENC_FAILED;
         }
 
-        block_size_input = (length - offset > block_size) ?
-                           block_size : length - offset;
-        for (uint8_t i = 0; i < block_size_input; ++i) {
-            output[offset + i] = stream_block[i] ^ input[offset + i];
+        chunk = (remaining > numof * block_size) ?
+                numof * block_size : remaining;
+        for (size_t i = 0; i < chunk; ++i) {
+            output[offset + i] = stream_blocks[i] ^ input[offset + i];
         }
 
-        offset += block_size_input;
-        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        offset += chunk;
     } while (offset < length);
 
     return offset;
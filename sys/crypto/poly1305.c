@@ -11,8 +11,8 @@
  * @ingroup sys_crypto_poly1305
  * @{
  * @file
- * @brief   Implementation of Poly1305. Based on Floodberry's and Loup
- *          Valliant's implementation. Optimized for small flash size.
+ * @brief   Implementation of Poly1305 in radix 2^26. Based on Floodberry's
+ *          poly1305-donna-32.
  *
  * @author  Koen Zandberg <koen@bergzand.net>
  * @}
@@ -21,7 +21,9 @@
 #include <string.h>
 #include "crypto/poly1305.h"
 
-static void poly1305_block(poly1305_ctx_t *ctx, uint8_t c4);
+/* high bit of a full block in radix 2^26 */
+#define HIBIT       (1UL << 24)
+#define MASK26      (0x3ffffff)
 
 static uint32_t u8to32(const uint8_t *p)
 {
@@ -40,127 +42,200 @@ static void u32to8(uint8_t *p, uint32_t v)
     p[3] = (uint8_t)(v >> 24);
 }
 
-static void _clear_c(poly1305_ctx_t *ctx)
-{
-    ctx->c[0] = 0;
-    ctx->c[1] = 0;
-    ctx->c[2] = 0;
-    ctx->c[3] = 0;
-    ctx->c_idx = 0;
-}
-
-static void poly1305_block(poly1305_ctx_t *ctx, uint8_t c4)
+/*
+ * Process all full blocks of data. The hash and r are kept in five limbs of
+ * 26 bits, so all products fit into 32x32->64 bit multiply-accumulate
+ * instructions and the carries of a block only need to be propagated once.
+ */
+static void poly1305_blocks(poly1305_ctx_t *ctx, const uint8_t *data,
+                            size_t len, uint32_t hibit)
 {
     /* Local copies */
     const uint32_t r0 = ctx->r[0];
     const uint32_t r1 = ctx->r[1];
     const uint32_t r2 = ctx->r[2];
     const uint32_t r3 = ctx->r[3];
-
-    const uint32_t rr0 = (r0 >> 2) * 5;
-    const uint32_t rr1 = (r1 >> 2) + r1;
-    const uint32_t rr2 = (r2 >> 2) + r2;
-    const uint32_t rr3 = (r3 >> 2) + r3;
-
-    /* s = h + c, without carry propagation */
-    const uint64_t s0 = ctx->h[0] + (uint64_t)ctx->c[0];
-    const uint64_t s1 = ctx->h[1] + (uint64_t)ctx->c[1];
-    const uint64_t s2 = ctx->h[2] + (uint64_t)ctx->c[2];
-    const uint64_t s3 = ctx->h[3] + (uint64_t)ctx->c[3];
-    const uint32_t s4 = ctx->h[4] + c4;
-
-    /* (h + c) * r, without carry propagation */
-    const uint64_t x0 = s0 * r0 + s1 * rr3 + s2 * rr2 + s3 * rr1 + s4 * rr0;
-    const uint64_t x1 = s0 * r1 + s1 * r0  + s2 * rr3 + s3 * rr2 + s4 * rr1;
-    const uint64_t x2 = s0 * r2 + s1 * r1  + s2 * r0  + s3 * rr3 + s4 * rr2;
-    const uint64_t x3 = s0 * r3 + s1 * r2  + s2 * r1  + s3 * r0  + s4 * rr3;
-    const uint32_t x4 = s4 * (r0 & 3);
-
-    /* partial reduction modulo 2^130 - 5 */
-    const uint32_t u5 = x4 + (x3 >> 32); // u5 <= 7ffffff5
-    const uint64_t u0 = (u5 >>  2) * 5 + (x0 & 0xffffffff);
-    const uint64_t u1 = (u0 >> 32)     + (x1 & 0xffffffff) + (x0 >> 32);
-    const uint64_t u2 = (u1 >> 32)     + (x2 & 0xffffffff) + (x1 >> 32);
-    const uint64_t u3 = (u2 >> 32)     + (x3 & 0xffffffff) + (x2 >> 32);
-    const uint64_t u4 = (u3 >> 32)     + (u5 & 3);
+    const uint32_t r4 = ctx->r[4];
+
+    /* 2^130 = 5 mod 2^130 - 5 */
+    const uint32_t s1 = r1 * 5;
+    const uint32_t s2 = r2 * 5;
+    const uint32_t s3 = r3 * 5;
+    const uint32_t s4 = r4 * 5;
+
+    uint32_t h0 = ctx->h[0];
+    uint32_t h1 = ctx->h[1];
+    uint32_t h2 = ctx->h[2];
+    uint32_t h3 = ctx->h[3];
+    uint32_t h4 = ctx->h[4];
+
+    while (len >= POLY1305_BLOCK_SIZE) {
+        /* h += m */
+        h0 += (u8to32(&data[0])) & MASK26;
+        h1 += (u8to32(&data[3]) >> 2) & MASK26;
+        h2 += (u8to32(&data[6]) >> 4) & MASK26;
+        h3 += (u8to32(&data[9]) >> 6) & MASK26;
+        h4 += (u8to32(&data[12]) >> 8) | hibit;
+
+        /* h *= r */
+        const uint64_t d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 +
+                            (uint64_t)h2 * s3 + (uint64_t)h3 * s2 +
+                            (uint64_t)h4 * s1;
+        uint64_t d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 +
+                      (uint64_t)h2 * s4 + (uint64_t)h3 * s3 +
+                      (uint64_t)h4 * s2;
+        uint64_t d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 +
+                      (uint64_t)h2 * r0 + (uint64_t)h3 * s4 +
+                      (uint64_t)h4 * s3;
+        uint64_t d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 +
+                      (uint64_t)h2 * r1 + (uint64_t)h3 * r0 +
+                      (uint64_t)h4 * s4;
+        uint64_t d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 +
+                      (uint64_t)h2 * r2 + (uint64_t)h3 * r1 +
+                      (uint64_t)h4 * r0;
+
+        /* partial reduction modulo 2^130 - 5 */
+        uint32_t c;
+        c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & MASK26;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & MASK26;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & MASK26;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & MASK26;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & MASK26;
+        h0 += c * 5; c = h0 >> 26; h0 &= MASK26;
+        h1 += c;
+
+        data += POLY1305_BLOCK_SIZE;
+        len -= POLY1305_BLOCK_SIZE;
+    }
 
     /* Update the hash */
-    ctx->h[0] = (uint32_t)u0;
-    ctx->h[1] = (uint32_t)u1;
-    ctx->h[2] = (uint32_t)u2;
-    ctx->h[3] = (uint32_t)u3;
-    ctx->h[4] = (uint32_t)u4;
-}
-
-static void _take_input(poly1305_ctx_t *ctx, uint8_t input)
-{
-    size_t word = ctx->c_idx >> 2;
-    size_t byte = ctx->c_idx & 3;
-
-    ctx->c[word] |= (uint32_t)input << (byte * 8);
-    ctx->c_idx++;
+    ctx->h[0] = h0;
+    ctx->h[1] = h1;
+    ctx->h[2] = h2;
+    ctx->h[3] = h3;
+    ctx->h[4] = h4;
 }
 
 void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
 {
-    for (size_t i = 0; i < len; i++) {
-        _take_input(ctx, data[i]);
-        if (ctx->c_idx == 16) {
-            poly1305_block(ctx, 1);
-            _clear_c(ctx);
+    /* complete a buffered block */
+    if (ctx->c_idx) {
+        size_t want = POLY1305_BLOCK_SIZE - ctx->c_idx;
+        if (want > len) {
+            want = len;
         }
+        memcpy(&ctx->c[ctx->c_idx], data, want);
+        ctx->c_idx += want;
+        data += want;
+        len -= want;
+        if (ctx->c_idx < POLY1305_BLOCK_SIZE) {
+            return;
+        }
+        poly1305_blocks(ctx, ctx->c, POLY1305_BLOCK_SIZE, HIBIT);
+        ctx->c_idx = 0;
+    }
+
+    /* full blocks directly from the input */
+    size_t full = len & ~(size_t)(POLY1305_BLOCK_SIZE - 1);
+    if (full) {
+        poly1305_blocks(ctx, data, full, HIBIT);
+        data += full;
+        len -= full;
     }
+
+    memcpy(ctx->c, data, len);
+    ctx->c_idx = len;
 }
 
 void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
 {
-    /* load and clamp key */
-    ctx->r[0] = u8to32(key) & 0x0fffffff;
-    for (size_t i = 1; i < 4; i++) {
-        ctx->r[i] = u8to32(&key[4 * i]) & 0x0ffffffc;
-    }
+    /* load the complete key first, it may overlap with the context */
+    const uint32_t t0 = u8to32(&key[0]);
+    const uint32_t t1 = u8to32(&key[3]);
+    const uint32_t t2 = u8to32(&key[6]);
+    const uint32_t t3 = u8to32(&key[9]);
+    const uint32_t t4 = u8to32(&key[12]);
+    uint32_t pad[4];
+
     for (size_t i = 0; i < 4; i++) {
-        ctx->pad[i] = u8to32(&key[16 + i * 4]);
+        pad[i] = u8to32(&key[16 + i * 4]);
     }
 
+    /* clamp r and split it into limbs */
+    ctx->r[0] = t0 & 0x3ffffff;
+    ctx->r[1] = (t1 >> 2) & 0x3ffff03;
+    ctx->r[2] = (t2 >> 4) & 0x3ffc0ff;
+    ctx->r[3] = (t3 >> 6) & 0x3f03fff;
+    ctx->r[4] = (t4 >> 8) & 0x00fffff;
+    memcpy(ctx->pad, pad, sizeof(ctx->pad));
+
     /* Zero the hash */
     memset(ctx->h, 0, sizeof(ctx->h));
-    _clear_c(ctx);
+    ctx->c_idx = 0;
 }
 
 void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *mac)
 {
     /* Process the last block if there is data remaining */
     if (ctx->c_idx) {
-        /* move the final 1 according to remaining input length */
-        /* (We may add less than 2^130 to the last input block) */
-        _take_input(ctx, 1);
-        /* And update hash */
-        poly1305_block(ctx, 0);
+        /* append the final 1 and pad with zeros instead of adding 2^128 */
+        ctx->c[ctx->c_idx] = 1;
+        memset(&ctx->c[ctx->c_idx + 1], 0,
+               POLY1305_BLOCK_SIZE - ctx->c_idx - 1);
+        poly1305_blocks(ctx, ctx->c, POLY1305_BLOCK_SIZE, 0);
     }
 
-    /* check if we should subtract 2^130-5 by performing the
-     * corresponding carry propagation. */
-    const uint64_t u0 = (uint64_t)5 + ctx->h[0];    // <= 1_00000004
-    const uint64_t u1 = (u0 >> 32)  + ctx->h[1];    // <= 1_00000000
-    const uint64_t u2 = (u1 >> 32)  + ctx->h[2];    // <= 1_00000000
-    const uint64_t u3 = (u2 >> 32)  + ctx->h[3];    // <= 1_00000000
-    const uint64_t u4 = (u3 >> 32)  + ctx->h[4];    // <=          5
-    /* u4 indicates how many times we should subtract 2^130-5 (0 or 1) */
-
-    /* h + pad, minus 2^130-5 if u4 exceeds 3 */
-    const uint64_t uu0 = (u4 >> 2) * 5 + ctx->h[0] + ctx->pad[0];
-    u32to8(mac, uu0);
-
-    const uint64_t uu1 = (uu0 >> 32)   + ctx->h[1] + ctx->pad[1];
-    u32to8(mac + 4, uu1);
-
-    const uint64_t uu2 = (uu1 >> 32)   + ctx->h[2] + ctx->pad[2];
-    u32to8(mac + 8, uu2);
-
-    const uint64_t uu3 = (uu2 >> 32)   + ctx->h[3] + ctx->pad[3];
-    u32to8(mac + 12, uu3);
-
+    uint32_t h0 = ctx->h[0];
+    uint32_t h1 = ctx->h[1];
+    uint32_t h2 = ctx->h[2];
+    uint32_t h3 = ctx->h[3];
+    uint32_t h4 = ctx->h[4];
+    uint32_t c;
+
+    /* fully carry h */
+    c = h1 >> 26; h1 &= MASK26;
+    h2 += c; c = h2 >> 26; h2 &= MASK26;
+    h3 += c; c = h3 >> 26; h3 &= MASK26;
+    h4 += c; c = h4 >> 26; h4 &= MASK26;
+    h0 += c * 5; c = h0 >> 26; h0 &= MASK26;
+    h1 += c;
+
+    /* g = h + 5 - 2^130 */
+    uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= MASK26;
+    uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= MASK26;
+    uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= MASK26;
+    uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= MASK26;
+    uint32_t g4 = h4 + c - (1UL << 26);
+
+    /* select h if h < 2^130 - 5, g otherwise, without branching */
+    uint32_t mask = (g4 >> 31) - 1;
+    g0 &= mask;
+    g1 &= mask;
+    g2 &= mask;
+    g3 &= mask;
+    g4 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+    h3 = (h3 & mask) | g3;
+    h4 = (h4 & mask) | g4;
+
+    /* h = h % 2^128, converted to radix 2^32 */
+    h0 = (h0      ) | (h1 << 26);
+    h1 = (h1 >>  6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 <<  8);
+
+    /* mac = (h + pad) % 2^128 */
+    uint64_t f = (uint64_t)h0 + ctx->pad[0];
+    u32to8(mac, (uint32_t)f);
+    f = (uint64_t)h1 + ctx->pad[1] + (f >> 32);
+    u32to8(mac + 4, (uint32_t)f);
+    f = (uint64_t)h2 + ctx->pad[2] + (f >> 32);
+    u32to8(mac + 8, (uint32_t)f);
+    f = (uint64_t)h3 + ctx->pad[3] + (f >> 32);
+    u32to8(mac + 12, (uint32_t)f);
 }
 
 void poly1305_auth(uint8_t *mac, const uint8_t *data, size_t len,
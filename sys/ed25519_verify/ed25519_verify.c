@@ -0,0 +1,514 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ed25519_verify
+ * @{
+ *
+ * @file
+ * @brief       Ed25519 signature verification with comb tables
+ *
+ * A scalar below `2^253` is split into `n` teeth of `d = ceil(253 / n)` bits.
+ * Entry `j` of the table of a point `P` holds the sum of `2^(k * d) * P` for
+ * all bits `k` set in `j`, so `s * P` takes `d` rounds of doubling the
+ * accumulator and adding the entry selected by bits `i`, `i + d`, ... of `s`.
+ * The rounds of `sB` and `-hA` are merged.
+ *
+ * The base point table has four teeth. Its entries are in extended
+ * coordinates with `Z = 1`, as returned by `ed25519_project()`.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ed25519.h"
+#include "ed25519_verify.h"
+#include "f25519.h"
+#include "fprime.h"
+#include "sha512.h"
+
+#if (CONFIG_ED25519_VERIFY_TEETH < 1) || (CONFIG_ED25519_VERIFY_TEETH > 4)
+#error "CONFIG_ED25519_VERIFY_TEETH must be between 1 and 4"
+#endif
+
+/* bits of the reduced scalars */
+#define SCALAR_BITS     (253U)
+
+#define BASE_TEETH      (4U)
+#define BASE_SPACING    ((SCALAR_BITS + BASE_TEETH - 1) / BASE_TEETH)
+#define KEY_SPACING     ((SCALAR_BITS + CONFIG_ED25519_VERIFY_TEETH - 1) / \
+                         CONFIG_ED25519_VERIFY_TEETH)
+#define ROUNDS          ((KEY_SPACING > BASE_SPACING) ? KEY_SPACING : BASE_SPACING)
+
+/* group order l, little endian */
+static const uint8_t _order[FPRIME_SIZE] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+    0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+/* entry j - 1 is the sum of 2^(64 * k) * B for all bits k set in j */
+static const struct ed25519_pt _base_table[(1U << BASE_TEETH) - 1] = {
+    {
+        .x = {
+            0x1a, 0xd5, 0x25, 0x8f, 0x60, 0x2d, 0x56, 0xc9,
+            0xb2, 0xa7, 0x25, 0x95, 0x60, 0xc7, 0x2c, 0x69,
+            0x5c, 0xdc, 0xd6, 0xfd, 0x31, 0xe2, 0xa4, 0xc0,
+            0xfe, 0x53, 0x6e, 0xcd, 0xd3, 0x36, 0x69, 0x21,
+        },
+        .y = {
+            0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+            0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+        },
+        .t = {
+            0xa3, 0xdd, 0xb7, 0xa5, 0xb3, 0x8a, 0xde, 0x6d,
+            0xf5, 0x52, 0x51, 0x77, 0x80, 0x9f, 0xf0, 0x20,
+            0x7d, 0xe3, 0xab, 0x64, 0x8e, 0x4e, 0xea, 0x66,
+            0x65, 0x76, 0x8b, 0xd7, 0x0f, 0x5f, 0x87, 0x67,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x02, 0xa2, 0xed, 0xf4, 0x8f, 0x6b, 0x0b, 0x3e,
+            0xeb, 0x35, 0x1a, 0xd5, 0x7e, 0xdb, 0x78, 0x00,
+            0x96, 0x8a, 0xa0, 0xb4, 0xcf, 0x60, 0x4b, 0xd4,
+            0xd5, 0xf9, 0x2d, 0xbf, 0x88, 0xbd, 0x22, 0x62,
+        },
+        .y = {
+            0x13, 0x53, 0xe4, 0x82, 0x57, 0xfa, 0x1e, 0x8f,
+            0x06, 0x2b, 0x90, 0xba, 0x08, 0xb6, 0x10, 0x54,
+            0x4f, 0x7c, 0x1b, 0x26, 0xed, 0xda, 0x6b, 0xdd,
+            0x25, 0xd0, 0x4e, 0xea, 0x42, 0xbb, 0x25, 0x03,
+        },
+        .t = {
+            0x59, 0x08, 0x74, 0xb6, 0xe9, 0x92, 0xfd, 0x2d,
+            0x86, 0xbf, 0xc4, 0x9c, 0x0e, 0xbe, 0x0a, 0x3b,
+            0x60, 0x45, 0x09, 0x40, 0xe6, 0x80, 0x99, 0xc7,
+            0x0a, 0xae, 0xd3, 0xc7, 0xe2, 0x09, 0x8b, 0x62,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0xa2, 0xfb, 0xcc, 0x61, 0x67, 0x06, 0x70, 0x1a,
+            0xc4, 0x78, 0x3a, 0xff, 0x32, 0x62, 0xdd, 0x2c,
+            0xab, 0x50, 0x19, 0x3b, 0xf2, 0x9b, 0x7d, 0xb8,
+            0xfd, 0x4f, 0x29, 0x9c, 0xa7, 0x91, 0xba, 0x0e,
+        },
+        .y = {
+            0x46, 0x5e, 0x51, 0xfe, 0x1d, 0xbf, 0xe5, 0xe5,
+            0x9b, 0x95, 0x0d, 0x67, 0xf8, 0xd1, 0xb5, 0x5a,
+            0xa1, 0x93, 0x2c, 0xc3, 0xde, 0x0e, 0x97, 0x85,
+            0x2d, 0x7f, 0xea, 0xab, 0x3e, 0x47, 0x30, 0x18,
+        },
+        .t = {
+            0x70, 0xfb, 0xdf, 0x82, 0xf6, 0x46, 0xd3, 0xfd,
+            0xb5, 0x32, 0xfd, 0x3f, 0x96, 0x09, 0xa1, 0x69,
+            0x25, 0x25, 0x11, 0xa2, 0xd9, 0xb8, 0x52, 0x07,
+            0xf3, 0x0a, 0x40, 0xce, 0x13, 0x11, 0xcd, 0x38,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x24, 0xe8, 0xb7, 0x60, 0xae, 0x47, 0x80, 0xfc,
+            0xe5, 0x23, 0xe7, 0xc2, 0xc9, 0x85, 0xe6, 0x98,
+            0xa0, 0x29, 0x4e, 0xe1, 0x84, 0x39, 0x2d, 0x95,
+            0x2c, 0xf3, 0x45, 0x3c, 0xff, 0xaf, 0x27, 0x4c,
+        },
+        .y = {
+            0x6b, 0xa6, 0xf5, 0x4b, 0x11, 0xbd, 0xba, 0x5b,
+            0x9e, 0xc4, 0xa4, 0x51, 0x1e, 0xbe, 0xd0, 0x90,
+            0x3a, 0x9c, 0xc2, 0x26, 0xb6, 0x1e, 0xf1, 0x95,
+            0x7d, 0xc8, 0x6d, 0x52, 0xe6, 0x99, 0x2c, 0x5f,
+        },
+        .t = {
+            0x8a, 0x33, 0xf1, 0x46, 0xc9, 0x31, 0xe7, 0xe9,
+            0xa9, 0xad, 0x63, 0x66, 0x82, 0x64, 0x78, 0x14,
+            0x6a, 0x4b, 0x92, 0x07, 0x00, 0x56, 0xe1, 0xd4,
+            0x2f, 0x60, 0xf4, 0x0b, 0xfd, 0x64, 0xa1, 0x05,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x9a, 0x96, 0x0c, 0x68, 0x29, 0xfd, 0xe2, 0xfb,
+            0xe6, 0xbc, 0xec, 0x31, 0x08, 0xec, 0xe6, 0xb0,
+            0x53, 0x60, 0xc3, 0x8c, 0xbe, 0xc1, 0xb3, 0x8a,
+            0x8f, 0xe4, 0x88, 0x2b, 0x55, 0xe5, 0x64, 0x6e,
+        },
+        .y = {
+            0x9b, 0xd0, 0xaf, 0x7b, 0x64, 0x2a, 0x35, 0x25,
+            0x10, 0x52, 0xc5, 0x9e, 0x58, 0x11, 0x39, 0x36,
+            0x45, 0x51, 0xb8, 0x39, 0x93, 0xfc, 0x9d, 0x6a,
+            0xbe, 0x58, 0xcb, 0xa4, 0x0f, 0x51, 0x3c, 0x38,
+        },
+        .t = {
+            0xa9, 0x83, 0x46, 0x81, 0xbc, 0xb0, 0x38, 0xa1,
+            0x60, 0x8d, 0x3b, 0x78, 0x78, 0x52, 0xfe, 0x43,
+            0x91, 0x35, 0xb9, 0xa9, 0xb8, 0x2e, 0xbf, 0x57,
+            0xf9, 0xd8, 0x04, 0x51, 0xf8, 0x61, 0x5c, 0x47,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x05, 0xca, 0xab, 0x43, 0x63, 0x0e, 0xf3, 0x8b,
+            0x41, 0xa6, 0xf8, 0x9b, 0x53, 0x70, 0x80, 0x53,
+            0x86, 0x5e, 0x8f, 0xe3, 0xc3, 0x0d, 0x18, 0xc8,
+            0x4b, 0x34, 0x1f, 0xd8, 0x1d, 0xbc, 0xf2, 0x6d,
+        },
+        .y = {
+            0x34, 0x3a, 0xbe, 0xdf, 0xd9, 0xf6, 0xf3, 0x89,
+            0xa1, 0xe1, 0x94, 0x9f, 0x5d, 0x4c, 0x5d, 0xe9,
+            0xa1, 0x49, 0x92, 0xef, 0x0e, 0x53, 0x81, 0x89,
+            0x58, 0x87, 0xa6, 0x37, 0xf1, 0xdd, 0x62, 0x60,
+        },
+        .t = {
+            0xb2, 0xf8, 0x25, 0x5a, 0x7b, 0xd8, 0xce, 0x93,
+            0x92, 0xfc, 0x48, 0xd8, 0xd0, 0x88, 0xe5, 0xf7,
+            0xec, 0x19, 0xf7, 0xbe, 0xe8, 0x70, 0xd7, 0xe6,
+            0x8a, 0xcb, 0xb2, 0x25, 0x26, 0x02, 0x7c, 0x50,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x63, 0x5a, 0x9d, 0x1b, 0x8c, 0xc6, 0x7d, 0x52,
+            0xea, 0x70, 0x09, 0x6a, 0xe1, 0x32, 0xf3, 0x73,
+            0x21, 0x1f, 0x07, 0x7b, 0x7c, 0x9b, 0x49, 0xd8,
+            0xc0, 0xf3, 0x25, 0x72, 0x6f, 0x9d, 0xed, 0x31,
+        },
+        .y = {
+            0x67, 0x36, 0x36, 0x54, 0x40, 0x92, 0x71, 0xe6,
+            0x11, 0x28, 0x11, 0xad, 0x93, 0x32, 0x85, 0x7b,
+            0x3e, 0xb7, 0x3b, 0x49, 0x13, 0x1c, 0x07, 0xb0,
+            0x2e, 0x93, 0xaa, 0xfd, 0xfd, 0x28, 0x47, 0x3d,
+        },
+        .t = {
+            0x39, 0xfb, 0x65, 0x28, 0xde, 0xcd, 0x3b, 0x70,
+            0x32, 0x42, 0xf4, 0xe8, 0x37, 0x47, 0x57, 0x0f,
+            0xb7, 0x8f, 0xaf, 0x0b, 0xc5, 0x85, 0xb4, 0xc1,
+            0xc4, 0xa5, 0x2e, 0x8e, 0xaf, 0x2b, 0x60, 0x4e,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x8d, 0xd2, 0xda, 0xc7, 0x44, 0xd6, 0x7a, 0xdb,
+            0x26, 0x7d, 0x1d, 0xb8, 0xe1, 0xde, 0x9d, 0x7a,
+            0x7d, 0x17, 0x7e, 0x1c, 0x37, 0x04, 0x8d, 0x2d,
+            0x7c, 0x5e, 0x18, 0x38, 0x1e, 0xaf, 0xc7, 0x1b,
+        },
+        .y = {
+            0x33, 0x48, 0x31, 0x00, 0x59, 0xf6, 0xf2, 0xca,
+            0x0f, 0x27, 0x1b, 0x63, 0x12, 0x7e, 0x02, 0x1d,
+            0x49, 0xc0, 0x5d, 0x79, 0x87, 0xef, 0x5e, 0x7a,
+            0x2f, 0x1f, 0x66, 0x55, 0xd8, 0x09, 0xd9, 0x61,
+        },
+        .t = {
+            0xc7, 0xc2, 0x36, 0x66, 0x21, 0x45, 0xb8, 0x51,
+            0xf8, 0x7e, 0xde, 0x56, 0x36, 0xf2, 0xb8, 0x9b,
+            0xbd, 0x0f, 0x1f, 0x4b, 0xde, 0x64, 0xb6, 0xcc,
+            0x44, 0xfa, 0xb8, 0x54, 0x80, 0x0b, 0x34, 0x1a,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x38, 0x68, 0xb0, 0x07, 0xa3, 0xfc, 0xcc, 0x85,
+            0x10, 0x7f, 0x4c, 0x65, 0x65, 0xb3, 0xfa, 0xfa,
+            0xa5, 0x53, 0x6f, 0xdb, 0x74, 0x4c, 0x56, 0x46,
+            0x03, 0xe2, 0xd5, 0x7a, 0x29, 0x1c, 0xc6, 0x02,
+        },
+        .y = {
+            0xbc, 0x59, 0xf2, 0x04, 0x75, 0x63, 0xc0, 0x84,
+            0x2f, 0x60, 0x1c, 0x67, 0x76, 0xfd, 0x63, 0x86,
+            0xf3, 0xfa, 0xbf, 0xdc, 0xd2, 0x2d, 0x90, 0x91,
+            0xbd, 0x33, 0xa9, 0xe5, 0x66, 0x0c, 0xda, 0x42,
+        },
+        .t = {
+            0x25, 0xd5, 0x62, 0x0c, 0x3a, 0x9d, 0xa3, 0x10,
+            0xa4, 0x1c, 0x0a, 0xd2, 0x20, 0x86, 0xda, 0x18,
+            0x1c, 0x4f, 0xe1, 0x61, 0xbd, 0xe5, 0x75, 0x37,
+            0x47, 0x7a, 0x2a, 0xfe, 0x39, 0xb1, 0x00, 0x10,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x27, 0xca, 0xf4, 0x66, 0xc2, 0xec, 0x92, 0x14,
+            0x57, 0x06, 0x63, 0xd0, 0x4d, 0x15, 0x06, 0xeb,
+            0x69, 0x58, 0x4f, 0x77, 0xc5, 0x8b, 0xc7, 0xf0,
+            0x8e, 0xed, 0x64, 0xa0, 0xb3, 0x3c, 0x66, 0x71,
+        },
+        .y = {
+            0xc6, 0x2d, 0xda, 0x0a, 0x0d, 0xfe, 0x70, 0x27,
+            0x64, 0xf8, 0x27, 0xfa, 0xf6, 0x5f, 0x30, 0xa5,
+            0x0d, 0x6c, 0xda, 0xf2, 0x62, 0x5e, 0x78, 0x47,
+            0xd3, 0x66, 0x00, 0x1c, 0xfd, 0x56, 0x1f, 0x5d,
+        },
+        .t = {
+            0xf5, 0x46, 0x72, 0x85, 0x49, 0x6b, 0xaa, 0x5d,
+            0xb7, 0x5f, 0xdc, 0x35, 0x73, 0xf3, 0xed, 0xbb,
+            0xf9, 0x41, 0x09, 0xbc, 0xe6, 0x84, 0xe3, 0x6f,
+            0xec, 0xa2, 0x39, 0xda, 0x4d, 0x66, 0x6c, 0x49,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x3f, 0x6f, 0xf4, 0x4c, 0xd8, 0xfd, 0x0e, 0x27,
+            0xc9, 0x5c, 0x2b, 0xbc, 0xc0, 0xa4, 0xe7, 0x23,
+            0x29, 0x02, 0x9f, 0x31, 0xd6, 0xe9, 0xd7, 0x96,
+            0xf4, 0xe0, 0x5e, 0x0b, 0x0e, 0x13, 0xee, 0x3c,
+        },
+        .y = {
+            0x09, 0xed, 0xf2, 0x3d, 0x76, 0x91, 0xc3, 0xa4,
+            0x97, 0xae, 0xd4, 0x87, 0xd0, 0x5d, 0xf6, 0x18,
+            0x47, 0x1f, 0x1d, 0x67, 0xf2, 0xcf, 0x63, 0xa0,
+            0x91, 0x27, 0xf8, 0x93, 0x45, 0x75, 0x23, 0x3f,
+        },
+        .t = {
+            0x98, 0x28, 0x93, 0x7c, 0x93, 0x43, 0x14, 0x8a,
+            0x2b, 0x5b, 0x14, 0x80, 0xc5, 0xf6, 0x68, 0xe3,
+            0xe9, 0xe6, 0xe7, 0x2c, 0xc6, 0x5b, 0x7f, 0x43,
+            0x9a, 0x3f, 0x1c, 0x39, 0x6c, 0xf6, 0x08, 0x75,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0xd1, 0xf1, 0xad, 0x23, 0xdd, 0x64, 0x93, 0x96,
+            0x41, 0x70, 0x7f, 0xf7, 0xf5, 0xa9, 0x89, 0xa2,
+            0x34, 0xb0, 0x8d, 0x1b, 0xae, 0x19, 0x15, 0x49,
+            0x58, 0x23, 0x6d, 0x87, 0x15, 0x4f, 0x81, 0x76,
+        },
+        .y = {
+            0xfb, 0x23, 0xb5, 0xea, 0xcf, 0xac, 0x54, 0x8d,
+            0x4e, 0x42, 0x2f, 0xeb, 0x0f, 0x63, 0xdb, 0x68,
+            0x37, 0xa8, 0xcf, 0x8b, 0xab, 0xf5, 0xa4, 0x6e,
+            0x96, 0x2a, 0xb2, 0xd6, 0xbe, 0x9e, 0xbd, 0x0d,
+        },
+        .t = {
+            0x75, 0x3b, 0xc5, 0xfd, 0x39, 0x49, 0xaf, 0x7c,
+            0xf1, 0x9c, 0x93, 0xd4, 0xd4, 0x2a, 0x95, 0x74,
+            0x32, 0x34, 0x61, 0x8e, 0x37, 0x89, 0x1c, 0x23,
+            0x8e, 0x01, 0x47, 0x4d, 0xa8, 0xe5, 0x24, 0x3e,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0xb4, 0x42, 0xa9, 0xcf, 0x01, 0x83, 0x8a, 0x17,
+            0x47, 0x76, 0xc4, 0xc6, 0x83, 0x04, 0x95, 0x0b,
+            0xfc, 0x11, 0xc9, 0x62, 0xb8, 0x0c, 0x76, 0x84,
+            0xd9, 0xb9, 0x37, 0xfa, 0xfc, 0x7c, 0xc2, 0x6d,
+        },
+        .y = {
+            0x58, 0x3e, 0xb3, 0x04, 0xbb, 0x8c, 0x8f, 0x48,
+            0xbc, 0x91, 0x27, 0xcc, 0xf9, 0xb7, 0x22, 0x19,
+            0x83, 0x2e, 0x09, 0xb5, 0x72, 0xd9, 0x54, 0x1c,
+            0x4d, 0xa1, 0xea, 0x0b, 0xf1, 0xc6, 0x08, 0x72,
+        },
+        .t = {
+            0x6b, 0x0b, 0xa2, 0x40, 0xda, 0x8e, 0x94, 0xf6,
+            0x00, 0x55, 0x42, 0x14, 0x2f, 0x86, 0x77, 0xb8,
+            0x1b, 0x1f, 0xda, 0x68, 0xd8, 0x21, 0xad, 0x88,
+            0xfa, 0x33, 0xeb, 0x31, 0xc1, 0x37, 0xbc, 0x56,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0x46, 0x87, 0x7a, 0x6e, 0x80, 0x56, 0x0a, 0x8a,
+            0xc0, 0xdd, 0x11, 0x6b, 0xd6, 0xdd, 0x47, 0xdf,
+            0x10, 0xd9, 0xd8, 0xea, 0x7c, 0xb0, 0x8f, 0x03,
+            0x00, 0x2e, 0xc1, 0x8f, 0x44, 0xa8, 0xd3, 0x30,
+        },
+        .y = {
+            0x06, 0x89, 0xa2, 0xf9, 0x34, 0xad, 0xdc, 0x03,
+            0x85, 0xed, 0x51, 0xa7, 0x82, 0x9c, 0xe7, 0x5d,
+            0x52, 0x93, 0x0c, 0x32, 0x9a, 0x5b, 0xe1, 0xaa,
+            0xca, 0xb8, 0x02, 0x6d, 0x3a, 0xd4, 0xb1, 0x3a,
+        },
+        .t = {
+            0x06, 0x01, 0x08, 0x6d, 0x4b, 0x1c, 0xd9, 0x53,
+            0x91, 0xc2, 0x05, 0x55, 0xad, 0xe8, 0xeb, 0x2d,
+            0x64, 0x11, 0x80, 0x11, 0x93, 0xd7, 0x40, 0x38,
+            0x11, 0xf1, 0x06, 0x82, 0xcb, 0xd2, 0xe2, 0x4e,
+        },
+        .z = { 1 },
+    },
+    {
+        .x = {
+            0xf0, 0x5f, 0xbe, 0xb5, 0x0d, 0x10, 0x6b, 0x38,
+            0x32, 0xac, 0x76, 0x80, 0xbd, 0xca, 0x94, 0x71,
+            0x7a, 0xf2, 0xc9, 0x35, 0x2a, 0xde, 0x9f, 0x42,
+            0x49, 0x18, 0x01, 0xab, 0xbc, 0xef, 0x7c, 0x64,
+        },
+        .y = {
+            0x3f, 0x58, 0x3d, 0x92, 0x59, 0xdb, 0x13, 0xdb,
+            0x58, 0x6e, 0x0a, 0xe0, 0xb7, 0x91, 0x4a, 0x08,
+            0x20, 0xd6, 0x2e, 0x3c, 0x45, 0xc9, 0x8b, 0x17,
+            0x79, 0xe7, 0xc7, 0x90, 0x99, 0x3a, 0x18, 0x25,
+        },
+        .t = {
+            0xef, 0x9f, 0xec, 0xd8, 0xd9, 0x43, 0x89, 0x78,
+            0xa2, 0x27, 0x4b, 0x05, 0x3b, 0x7d, 0xc2, 0x30,
+            0x1a, 0x62, 0x18, 0x53, 0xb9, 0x47, 0x91, 0xf8,
+            0x0a, 0x09, 0x4c, 0x5f, 0x7a, 0xe2, 0x10, 0x04,
+        },
+        .z = { 1 },
+    },
+};
+
+static unsigned _comb_index(const uint8_t *scalar, unsigned teeth,
+                            unsigned spacing, unsigned i)
+{
+    unsigned idx = 0;
+
+    for (unsigned k = 0; k < teeth; k++, i += spacing) {
+        if (i < SCALAR_BITS) {
+            idx |= ((scalar[i >> 3] >> (i & 7)) & 1U) << k;
+        }
+    }
+    return idx;
+}
+
+/* whether the little endian scalar is below the group order */
+static bool _is_reduced(const uint8_t *scalar)
+{
+    for (unsigned i = FPRIME_SIZE; i-- > 0;) {
+        if (scalar[i] != _order[i]) {
+            return scalar[i] < _order[i];
+        }
+    }
+    return false;
+}
+
+/* h = SHA-512(R || A || M) mod l, as in edsign_verify() */
+static void _hash_ram(uint8_t *h, const uint8_t *r, const uint8_t *pub,
+                      const uint8_t *msg, size_t len)
+{
+    struct sha512_state state;
+    uint8_t block[SHA512_BLOCK_SIZE];
+    const size_t prefix = 2 * F25519_SIZE;
+
+    memcpy(block, r, F25519_SIZE);
+    memcpy(&block[F25519_SIZE], pub, F25519_SIZE);
+
+    sha512_init(&state);
+    if (len < SHA512_BLOCK_SIZE - prefix) {
+        /* msg may be NULL if empty */
+        if (len) {
+            memcpy(&block[prefix], msg, len);
+        }
+        sha512_final(&state, block, len + prefix);
+    }
+    else {
+        size_t i = SHA512_BLOCK_SIZE - prefix;
+
+        memcpy(&block[prefix], msg, i);
+        sha512_block(&state, block);
+        for (; i + SHA512_BLOCK_SIZE <= len; i += SHA512_BLOCK_SIZE) {
+            sha512_block(&state, &msg[i]);
+        }
+        sha512_final(&state, &msg[i], len + prefix);
+    }
+    sha512_get(&state, block, 0, SHA512_HASH_SIZE);
+    fprime_from_bytes(h, block, SHA512_HASH_SIZE, _order);
+}
+
+int ed25519_verify_init(ed25519_verify_ctx_t *ctx, const uint8_t *pub)
+{
+    uint8_t x[F25519_SIZE];
+    uint8_t y[F25519_SIZE];
+    uint8_t neg_x[F25519_SIZE];
+    struct ed25519_pt tooth;
+
+    assert(ctx && pub);
+
+    if (!ed25519_try_unpack(x, y, pub)) {
+        return -EINVAL;
+    }
+    /* -A, so the verification only needs additions */
+    f25519_neg(neg_x, x);
+    ed25519_project(&tooth, neg_x, y);
+
+    for (unsigned k = 0; k < CONFIG_ED25519_VERIFY_TEETH; k++) {
+        const unsigned first = 1U << k;
+
+        if (k > 0) {
+            for (unsigned i = 0; i < KEY_SPACING; i++) {
+                ed25519_double(&tooth, &tooth);
+            }
+        }
+        ed25519_copy(&ctx->table[first - 1], &tooth);
+        for (unsigned j = 1; j < first; j++) {
+            ed25519_add(&ctx->table[first + j - 1], &tooth, &ctx->table[j - 1]);
+        }
+    }
+    memcpy(ctx->pub, pub, sizeof(ctx->pub));
+
+    return 0;
+}
+
+int ed25519_verify(const ed25519_verify_ctx_t *ctx, const uint8_t *sig,
+                   const void *msg, size_t len)
+{
+    const uint8_t *r = sig;
+    const uint8_t *s = &sig[F25519_SIZE];
+    uint8_t h[FPRIME_SIZE];
+    uint8_t x[F25519_SIZE];
+    uint8_t y[F25519_SIZE];
+    uint8_t packed[F25519_SIZE];
+    struct ed25519_pt acc;
+
+    assert(ctx && sig && (msg || !len));
+
+    /* edsign_verify() reduces s implicitly, RFC 8032 requires s < l */
+    if (!_is_reduced(s)) {
+        return -EBADMSG;
+    }
+    _hash_ram(h, r, ctx->pub, msg, len);
+
+    /* sB - hA, which equals R for a valid signature */
+    ed25519_copy(&acc, &ed25519_neutral);
+    for (unsigned i = ROUNDS; i-- > 0;) {
+        unsigned idx;
+
+        ed25519_double(&acc, &acc);
+        if (i < BASE_SPACING) {
+            idx = _comb_index(s, BASE_TEETH, BASE_SPACING, i);
+            if (idx) {
+                ed25519_add(&acc, &acc, &_base_table[idx - 1]);
+            }
+        }
+        if (i < KEY_SPACING) {
+            idx = _comb_index(h, CONFIG_ED25519_VERIFY_TEETH, KEY_SPACING, i);
+            if (idx) {
+                ed25519_add(&acc, &acc, &ctx->table[idx - 1]);
+            }
+        }
+    }
+
+    /* the encoding is canonical, a byte compare is enough */
+    ed25519_unproject(x, y, &acc);
+    ed25519_pack(packed, x, y);
+    if (memcmp(packed, r, F25519_SIZE) != 0) {
+        return -EBADMSG;
+    }
+    return 0;
+}
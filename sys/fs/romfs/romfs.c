@@ -0,0 +1,336 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_fs_romfs
+ * @{
+ *
+ * @file
+ * @brief       RomFS implementation
+ *
+ * @}
+ */
+
+/* Required for strnlen in string.h, when building with -std=c99 */
+#define _DEFAULT_SOURCE 1
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "fs/romfs.h"
+#include "modules.h"
+#include "vfs.h"
+
+#if IS_USED(MODULE_MTD_FLASHPAGE)
+#include "container.h"
+#include "mtd_flashpage.h"
+#endif
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* File system operations */
+static int romfs_mount(vfs_mount_t *mountp);
+static int romfs_stat(vfs_mount_t *mountp, const char *restrict name, struct stat *restrict buf);
+static int romfs_statvfs(vfs_mount_t *mountp, const char *restrict path, struct statvfs *restrict buf);
+
+/* File operations */
+static int romfs_fstat(vfs_file_t *filp, struct stat *buf);
+static off_t romfs_lseek(vfs_file_t *filp, off_t off, int whence);
+static int romfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mode);
+static ssize_t romfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
+static int romfs_mmap(vfs_file_t *filp, const void **addr, size_t *len);
+
+/* Directory operations */
+static int romfs_opendir(vfs_DIR *dirp, const char *dirname);
+static int romfs_readdir(vfs_DIR *dirp, vfs_dirent_t *entry);
+
+static const vfs_file_system_ops_t romfs_fs_ops = {
+    .mount = romfs_mount,
+    .statvfs = romfs_statvfs,
+    .stat = romfs_stat,
+};
+
+static const vfs_file_ops_t romfs_file_ops = {
+    .fstat = romfs_fstat,
+    .lseek = romfs_lseek,
+    .open  = romfs_open,
+    .read  = romfs_read,
+    .mmap  = romfs_mmap,
+};
+
+static const vfs_dir_ops_t romfs_dir_ops = {
+    .opendir = romfs_opendir,
+    .readdir = romfs_readdir,
+};
+
+const vfs_file_system_t romfs_file_system = {
+    .f_op = &romfs_file_ops,
+    .fs_op = &romfs_fs_ops,
+    .d_op = &romfs_dir_ops,
+};
+
+static uint32_t _nfiles(const romfs_desc_t *fs)
+{
+    const romfs_header_t *hdr = fs->image;
+    return byteorder_ltohl(hdr->nfiles);
+}
+
+static const romfs_entry_t *_entry(const romfs_desc_t *fs, uint32_t idx)
+{
+    const romfs_entry_t *entries = (const void *)((const uint8_t *)fs->image +
+                                                  sizeof(romfs_header_t));
+    return &entries[idx];
+}
+
+static const char *_name(const romfs_desc_t *fs, const romfs_entry_t *e)
+{
+    return (const char *)fs->image + byteorder_ltohl(e->name);
+}
+
+static const uint8_t *_data(const romfs_desc_t *fs, const romfs_entry_t *e)
+{
+    return (const uint8_t *)fs->image + byteorder_ltohl(e->data);
+}
+
+static const romfs_entry_t *_lookup(const romfs_desc_t *fs, const char *name,
+                                    uint32_t *idx)
+{
+    if (name[0] == '/') {
+        ++name;
+    }
+    /* linear search through the entries */
+    for (uint32_t i = 0; i < _nfiles(fs); ++i) {
+        const romfs_entry_t *e = _entry(fs, i);
+        DEBUG("romfs_lookup ? \"%s\"\n", _name(fs, e));
+        if (strcmp(_name(fs, e), name) == 0) {
+            *idx = i;
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void _romfs_write_stat(const romfs_entry_t *e, struct stat *restrict buf)
+{
+    uint32_t size = byteorder_ltohl(e->size);
+
+    /* buffer is cleared by vfs already */
+    buf->st_nlink = 1;
+    buf->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH;
+    buf->st_size = size;
+    buf->st_blocks = size;
+    buf->st_blksize = sizeof(uint8_t);
+}
+
+static int romfs_mount(vfs_mount_t *mountp)
+{
+    romfs_desc_t *fs = mountp->private_data;
+
+    if (fs->dev) {
+#if IS_USED(MODULE_MTD_FLASHPAGE)
+        mtd_dev_t *dev = fs->dev;
+        if (dev->driver != &mtd_flashpage_driver) {
+            /* the image has to be accessible in place */
+            return -ENOTSUP;
+        }
+        fs->image = mtd_flashpage_addr(container_of(dev, mtd_flashpage_t, base));
+        fs->size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+#else
+        return -ENOTSUP;
+#endif
+    }
+
+    DEBUG("romfs_mount: image %p, %lu bytes\n", fs->image, (unsigned long)fs->size);
+
+    if ((fs->image == NULL) || ((uintptr_t)fs->image % sizeof(uint32_t)) ||
+        (fs->size < sizeof(romfs_header_t))) {
+        return -EINVAL;
+    }
+
+    const romfs_header_t *hdr = fs->image;
+    if (byteorder_ltohl(hdr->magic) != ROMFS_MAGIC) {
+        DEBUG("romfs_mount: bad magic\n");
+        return -ENODEV;
+    }
+
+    /* validate all entries once, so that no further checks are needed */
+    uint32_t nfiles = _nfiles(fs);
+    if (nfiles > (fs->size - sizeof(romfs_header_t)) / sizeof(romfs_entry_t)) {
+        return -EIO;
+    }
+    for (uint32_t i = 0; i < nfiles; ++i) {
+        const romfs_entry_t *e = _entry(fs, i);
+        uint32_t name = byteorder_ltohl(e->name);
+        uint32_t data = byteorder_ltohl(e->data);
+        uint32_t size = byteorder_ltohl(e->size);
+
+        if ((name >= fs->size) || (data > fs->size) || (size > fs->size - data) ||
+            !memchr(_name(fs, e), '\0', fs->size - name)) {
+            DEBUG("romfs_mount: entry %lu out of bounds\n", (unsigned long)i);
+            return -EIO;
+        }
+    }
+
+    return 0;
+}
+
+static int romfs_stat(vfs_mount_t *mountp, const char *restrict name, struct stat *restrict buf)
+{
+    romfs_desc_t *fs = mountp->private_data;
+    uint32_t idx;
+
+    if (buf == NULL) {
+        return -EFAULT;
+    }
+    const romfs_entry_t *e = _lookup(fs, name, &idx);
+    if (e == NULL) {
+        return -ENOENT;
+    }
+    _romfs_write_stat(e, buf);
+    buf->st_ino = idx;
+    return 0;
+}
+
+static int romfs_statvfs(vfs_mount_t *mountp, const char *restrict path, struct statvfs *restrict buf)
+{
+    (void) path;
+    if (buf == NULL) {
+        return -EFAULT;
+    }
+    romfs_desc_t *fs = mountp->private_data;
+    buf->f_bsize = sizeof(uint8_t); /* block size */
+    buf->f_frsize = sizeof(uint8_t); /* fundamental block size */
+    buf->f_blocks = fs->size;  /* Blocks total */
+    buf->f_bfree = 0;          /* Blocks free */
+    buf->f_bavail = 0;         /* Blocks available to non-privileged processes */
+    buf->f_files = _nfiles(fs); /* Total number of file serial numbers */
+    buf->f_ffree = 0;          /* Total number of free file serial numbers */
+    buf->f_favail = 0;         /* Number of file serial numbers available to non-privileged process */
+    buf->f_fsid = 0;           /* File system id */
+    buf->f_flag = (ST_RDONLY | ST_NOSUID); /* File system flags */
+    buf->f_namemax = VFS_NAME_MAX; /* Maximum file name length */
+    return 0;
+}
+
+static int romfs_fstat(vfs_file_t *filp, struct stat *buf)
+{
+    const romfs_entry_t *e = filp->private_data.ptr;
+    if (buf == NULL) {
+        return -EFAULT;
+    }
+    _romfs_write_stat(e, buf);
+    return 0;
+}
+
+static off_t romfs_lseek(vfs_file_t *filp, off_t off, int whence)
+{
+    const romfs_entry_t *e = filp->private_data.ptr;
+    switch (whence) {
+        case SEEK_SET:
+            break;
+        case SEEK_CUR:
+            off += filp->pos;
+            break;
+        case SEEK_END:
+            off += byteorder_ltohl(e->size);
+            break;
+        default:
+            return -EINVAL;
+    }
+    if (off < 0) {
+        /* the resulting file offset would be negative */
+        return -EINVAL;
+    }
+    /* POSIX allows seeking past the end of the file, even with O_RDONLY */
+    filp->pos = off;
+    return off;
+}
+
+static int romfs_open(vfs_file_t *filp, const char *name, int flags, mode_t mode)
+{
+    (void) mode;
+    romfs_desc_t *fs = filp->mp->private_data;
+    uint32_t idx;
+
+    DEBUG("romfs_open: %p, \"%s\", 0x%x\n", (void *)filp, name, flags);
+    /* We only support read access */
+    if ((flags & O_ACCMODE) != O_RDONLY) {
+        return -EROFS;
+    }
+    const romfs_entry_t *e = _lookup(fs, name, &idx);
+    if (e == NULL) {
+        return -ENOENT;
+    }
+    filp->private_data.ptr = (void *)e;
+    return 0;
+}
+
+static ssize_t romfs_read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    romfs_desc_t *fs = filp->mp->private_data;
+    const romfs_entry_t *e = filp->private_data.ptr;
+    uint32_t size = byteorder_ltohl(e->size);
+
+    DEBUG("romfs_read: %p, %p, %lu\n", (void *)filp, dest, (unsigned long)nbytes);
+    if ((uint32_t)filp->pos >= size) {
+        /* Current offset is at or beyond end of file */
+        return 0;
+    }
+    if (nbytes > (size_t)(size - filp->pos)) {
+        nbytes = size - filp->pos;
+    }
+    memcpy(dest, _data(fs, e) + filp->pos, nbytes);
+    filp->pos += nbytes;
+    return nbytes;
+}
+
+static int romfs_mmap(vfs_file_t *filp, const void **addr, size_t *len)
+{
+    romfs_desc_t *fs = filp->mp->private_data;
+    const romfs_entry_t *e = filp->private_data.ptr;
+
+    *addr = _data(fs, e);
+    *len = byteorder_ltohl(e->size);
+    return 0;
+}
+
+static int romfs_opendir(vfs_DIR *dirp, const char *dirname)
+{
+    DEBUG("romfs_opendir: %p, \"%s\"\n", (void *)dirp, dirname);
+    if (strncmp(dirname, "/", 2) != 0) {
+        /* flat file system, only a root directory */
+        return -ENOENT;
+    }
+    dirp->private_data.value = 0;
+    return 0;
+}
+
+static int romfs_readdir(vfs_DIR *dirp, vfs_dirent_t *entry)
+{
+    romfs_desc_t *fs = dirp->mp->private_data;
+    uint32_t filenum = dirp->private_data.value;
+
+    DEBUG("romfs_readdir: %p, %p\n", (void *)dirp, (void *)entry);
+    if (filenum >= _nfiles(fs)) {
+        /* End of stream */
+        return 0;
+    }
+    const char *filename = _name(fs, _entry(fs, filenum));
+    size_t len = strnlen(filename, VFS_NAME_MAX + 1);
+    dirp->private_data.value = filenum + 1;
+    if (len > VFS_NAME_MAX) {
+        /* name does not fit in vfs_dirent_t buffer, skip the entry */
+        return -EAGAIN;
+    }
+    /* copy the string, including terminating null */
+    memcpy(&entry->d_name[0], filename, len + 1);
+    entry->d_ino = filenum;
+    return 1;
+}
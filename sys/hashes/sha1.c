@@ -26,6 +26,11 @@
 #include <string.h>
 
 #include "hashes/sha1.h"
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+#include "periph/crypto_accel.h"
+#endif
 
 #define SHA1_K0  0x5a827999
 #define SHA1_K20 0x6ed9eba1
@@ -115,6 +120,23 @@ static void sha1_update_byte(sha1_context *ctx, uint8_t data)
 void sha1_update(sha1_context *ctx, const void *data, size_t len)
 {
     const uint8_t *d = data;
+
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+    /* complete a buffered block, then hand full blocks to the accelerator */
+    while (len && ctx->buffer_offset) {
+        sha1_update_byte(ctx, *(d++));
+        len--;
+    }
+
+    size_t blocks_len = len - (len % SHA1_BLOCK_LENGTH);
+    if (blocks_len && crypto_accel_hash_blocks(CRYPTO_ACCEL_SHA1, ctx->state,
+                                               d, blocks_len) == 0) {
+        ctx->byte_count += blocks_len;
+        d += blocks_len;
+        len -= blocks_len;
+    }
+#endif
+
     while (len--) {
         sha1_update_byte(ctx, *(d++));
     }
@@ -50,6 +50,11 @@
 #include <assert.h>
 
 #include "hashes/sha2xx_common.h"
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+#include "periph/crypto_accel.h"
+#endif
 
 #ifdef __BIG_ENDIAN__
 /* Copy a vector of big-endian uint32_t into a vector of bytes */
@@ -96,41 +101,106 @@ static void be32enc_vect(void *dst_, const void *src_, size_t len)
 
 #endif /* __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__ */
 
+/* One round, the caller rotates the roles of the working variables */
+#define ROUND(a, b, c, d, e, f, g, h, w, k) do { \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + (w) + (k); \
+        d += t0; \
+        h = t0 + S0(a) + Maj(a, b, c); \
+} while (0)
+
+/* Message word i < 16, taken from the input block */
+#define W_LOAD(i)       W[(i)]
+
+/* Message word i >= 16, computed in place in a ring of 16 words */
+#define W_EXPAND(i)     (W[(i) & 15] += s1(W[((i) - 2) & 15]) + \
+                                        W[((i) - 7) & 15] + \
+                                        s0(W[((i) - 15) & 15]))
+
+/* Eight rounds, after which the working variables are back in place */
+#define ROUNDS_8(i, w) do { \
+        ROUND(a, b, c, d, e, f, g, h, w((i) + 0), K[(i) + 0]); \
+        ROUND(h, a, b, c, d, e, f, g, w((i) + 1), K[(i) + 1]); \
+        ROUND(g, h, a, b, c, d, e, f, w((i) + 2), K[(i) + 2]); \
+        ROUND(f, g, h, a, b, c, d, e, w((i) + 3), K[(i) + 3]); \
+        ROUND(e, f, g, h, a, b, c, d, w((i) + 4), K[(i) + 4]); \
+        ROUND(d, e, f, g, h, a, b, c, w((i) + 5), K[(i) + 5]); \
+        ROUND(c, d, e, f, g, h, a, b, w((i) + 6), K[(i) + 6]); \
+        ROUND(b, c, d, e, f, g, h, a, w((i) + 7), K[(i) + 7]); \
+} while (0)
+
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
  */
 static void sha2xx_transform(uint32_t *state, const unsigned char block[64])
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    uint32_t W[16];
 
-    /* 1. Prepare message schedule W. */
+    /* 1. Load the first 16 words of the message schedule. */
     be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
-    }
 
     /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
 
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
+    /* 3. Mix, expanding the message schedule on the fly. */
+#if IS_USED(MODULE_HASHES_SHA2XX_UNROLL)
+    for (unsigned i = 0; i < 16; i += 8) {
+        ROUNDS_8(i, W_LOAD);
+    }
+    for (unsigned i = 16; i < 64; i += 8) {
+        ROUNDS_8(i, W_EXPAND);
+    }
+#else
+    for (unsigned i = 0; i < 64; i++) {
+        uint32_t w = (i < 16) ? W_LOAD(i) : W_EXPAND(i);
+
+        ROUND(a, b, c, d, e, f, g, h, w, K[i]);
+        /* rotate the working variables instead of the roles */
+        uint32_t tmp = h;
+        h = g;
+        g = f;
+        f = e;
+        e = d;
+        d = c;
+        c = b;
+        b = a;
+        a = tmp;
+    }
+#endif
 
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
+    /* 4. Mix local working variables into global state */
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
 
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
+/* Process full blocks, using an accelerator or the architecture specific
+ * transform if any */
+static void sha2xx_transform_blocks(uint32_t *state, const unsigned char *blocks,
+                                    size_t numof)
+{
+#if IS_USED(MODULE_PERIPH_CRYPTO_ACCEL)
+    if (numof && crypto_accel_hash_blocks(CRYPTO_ACCEL_SHA256, state, blocks,
+                                          numof * 64) == 0) {
+        return;
     }
+#endif
+#if IS_USED(MODULE_SHA2XX_ARCH)
+    size_t done = sha2xx_transform_arch(state, blocks, numof);
 
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
+    blocks += done * 64;
+    numof -= done;
+#endif
+
+    while (numof--) {
+        sha2xx_transform(state, blocks);
+        blocks += 64;
     }
 }
 
@@ -186,21 +256,21 @@ void sha2xx_update(sha2xx_context_t *ctx, const void *data, size_t len)
         return;
     }
 
-    /* Finish the current block */
     const unsigned char *src = data;
 
-    memcpy(&ctx->buf[r], src, 64 - r);
-    sha2xx_transform(ctx->state, ctx->buf);
-    src += 64 - r;
-    len -= 64 - r;
-
-    /* Perform complete blocks */
-    while (len >= 64) {
-        sha2xx_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
+    /* Finish the current block */
+    if (r) {
+        memcpy(&ctx->buf[r], src, 64 - r);
+        sha2xx_transform_blocks(ctx->state, ctx->buf, 1);
+        src += 64 - r;
+        len -= 64 - r;
     }
 
+    /* Perform complete blocks directly from the input */
+    sha2xx_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~(size_t)63;
+    len &= 63;
+
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
 }
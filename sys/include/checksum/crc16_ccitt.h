@@ -21,7 +21,9 @@
  *              enabling the look-up table.
  *
  *              @note enable the `crc16_fast` module for a look-up table based
- *              implementation that trades code size for speed.
+ *              implementation that trades code size for speed. With
+ *              @ref CONFIG_CRC16_FAST_SLICES set to 4 or 8, as many bytes are
+ *              processed per iteration using as many tables.
  *
  * @{
  * @file
@@ -39,6 +41,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of look-up tables used by the `crc16_fast` module
+ *
+ * 1, 4 or 8. Each table takes 512 bytes of flash per variant used.
+ */
+#ifndef CONFIG_CRC16_FAST_SLICES
+#define CONFIG_CRC16_FAST_SLICES    1
+#endif
+
 /**
  * @brief           Update CRC16-CCITT-KERMIT
  *
@@ -11,6 +11,17 @@
  * @ingroup     sys_checksum
  *
  * @brief       CRC32 checksum algorithm implementation according to IEEE standards
+ *
+ * Besides the IEEE 802.3 CRC-32, the CRC-32C (Castagnoli) used by iSCSI,
+ * SCTP and ext4 is provided.
+ *
+ * The `crc32_fast` module selects a look-up table based implementation that
+ * trades code size for speed. With @ref CONFIG_CRC32_FAST_SLICES set to 4 or
+ * 8, 4 or 8 bytes are processed per iteration ("slicing-by-N") using as many
+ * tables of 1 KiB each.
+ *
+ * If the `periph_crc` module is used, the CRC is computed by the CRC
+ * peripheral if it supports the polynomial, see @ref drivers_periph_crc.
  * @{
  *
  * @file
@@ -27,6 +38,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of look-up tables used by the `crc32_fast` module
+ *
+ * 1, 4 or 8. Each table takes 1 KiB of flash per polynomial used.
+ */
+#ifndef CONFIG_CRC32_FAST_SLICES
+#define CONFIG_CRC32_FAST_SLICES    1
+#endif
+
 /**
  * @brief   CRC-32 checksum
  *
@@ -42,6 +62,47 @@ extern "C" {
  */
 uint32_t crc32(const void *buf, size_t size);
 
+/**
+ * @brief   Update a CRC-32 checksum
+ *
+ * Continues a checksum returned by @ref crc32() or a previous call, so
+ * `crc32_update(crc32(a, n), b, m)` is the checksum of `a` followed by `b`.
+ * `crc32_update(0, buf, size)` is equal to `crc32(buf, size)`.
+ *
+ * @param[in] crc   Checksum of the preceding data
+ * @param[in] buf   The data to checksum
+ * @param[in] size  Length of the data in bytes
+ *
+ * @return  Checksum of the preceding data followed by @p buf
+ */
+uint32_t crc32_update(uint32_t crc, const void *buf, size_t size);
+
+/**
+ * @brief   CRC-32C (Castagnoli) checksum
+ *
+ * Uses the `0x82f63b78` polynomial, the check value of `"123456789"` is
+ * `0xe3069283`.
+ *
+ * @param[in] buf   The data to checksum
+ * @param[in] size  Length of the data in bytes
+ *
+ * @return  32 bit checksum
+ */
+uint32_t crc32c(const void *buf, size_t size);
+
+/**
+ * @brief   Update a CRC-32C checksum
+ *
+ * Like @ref crc32_update(), for @ref crc32c().
+ *
+ * @param[in] crc   Checksum of the preceding data
+ * @param[in] buf   The data to checksum
+ * @param[in] size  Length of the data in bytes
+ *
+ * @return  Checksum of the preceding data followed by @p buf
+ */
+uint32_t crc32c_update(uint32_t crc, const void *buf, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
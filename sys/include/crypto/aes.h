@@ -30,6 +30,7 @@
 #ifndef CRYPTO_AES_H
 #define CRYPTO_AES_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "crypto/ciphers.h"
 
@@ -68,6 +69,23 @@ typedef struct {
     uint32_t context[(4 * (AES_MAXNR + 1)) + 1];
 } aes_context_t;
 
+/**
+ * @brief   Expanded AES encryption key
+ *
+ * Computed once by aes_expand_key() for users that encrypt many short
+ * messages with the same key, e.g. one frame at a time.
+ */
+typedef struct {
+    /** @cond INTERNAL */
+#ifdef MODULE_CRYPTO_AES_BITSLICED
+    uint32_t rd_key[8 * (AES_MAXNR + 1)];
+#else
+    uint32_t rd_key[4 * (AES_MAXNR + 1)];
+#endif
+    int rounds;
+    /** @endcond */
+} aes_key_schedule_t;
+
 /**
  * @brief   initializes the AES Cipher-algorithm with the passed parameters
  *
@@ -125,6 +143,75 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts several consecutive blocks
+ *
+ * The key schedule is computed once for all blocks, which makes this
+ * considerably faster than calling aes_encrypt() for every block.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       input         the plaintext blocks
+ * @param       output        buffer for the ciphertext blocks, may be equal
+ *                            to @p input
+ * @param       blocks        number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks);
+
+/**
+ * @brief   decrypts several consecutive blocks
+ *
+ * The key schedule is computed once for all blocks, which makes this
+ * considerably faster than calling aes_decrypt() for every block.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       input         the ciphertext blocks
+ * @param       output        buffer for the plaintext blocks, may be equal
+ *                            to @p input
+ * @param       blocks        number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *input,
+                       uint8_t *output, size_t blocks);
+
+/**
+ * @brief   expands a key into an encryption key schedule
+ *
+ * @param       schedule      the expanded key
+ * @param       key           the key
+ * @param       key_size      the size of the key in bytes
+ *
+ * @return  CIPHER_INIT_SUCCESS if the key was expanded
+ * @return  CIPHER_ERR_INVALID_KEY_SIZE if the key size is not supported
+ */
+int aes_expand_key(aes_key_schedule_t *schedule, const uint8_t *key,
+                   uint8_t key_size);
+
+/**
+ * @brief   encrypts several consecutive blocks with an expanded key
+ *
+ * Unlike aes_encrypt_blocks() this does not compute the key schedule, and
+ * the blocks are always encrypted in software.
+ *
+ * @param       schedule      the key expanded by aes_expand_key()
+ * @param       input         the plaintext blocks
+ * @param       output        buffer for the ciphertext blocks, may be equal
+ *                            to @p input
+ * @param       blocks        number of blocks
+ */
+void aes_encrypt_expanded(const aes_key_schedule_t *schedule,
+                          const uint8_t *input, uint8_t *output,
+                          size_t blocks);
+
 #ifdef __cplusplus
 }
 #endif
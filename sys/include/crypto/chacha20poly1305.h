@@ -38,14 +38,25 @@ extern "C" {
 #define CHACHA20POLY1305_NONCE_BYTES    (12U)   /**< Nonce length in bytes */
 #define CHACHA20POLY1305_TAG_BYTES      (16U)   /**< Tag length in bytes */
 
+/**
+ * @brief Number of key stream blocks computed in parallel
+ *
+ * The blocks are interleaved word by word, which allows the compiler to use
+ * SIMD instructions and hides instruction latencies. Messages shorter than
+ * this many blocks use the single block code. Each block takes 64 bytes of
+ * stack.
+ */
+#ifndef CONFIG_CRYPTO_CHACHA20POLY1305_BLOCKS
+#define CONFIG_CRYPTO_CHACHA20POLY1305_BLOCKS   4
+#endif
+
 /**
  * @brief Chacha20poly1305 state struct
  */
 typedef union {
     /* We need both the state matrix and the poly1305 state, but nearly not at
-     * the same time. This works as long as the first 8 members of state
-     * overlap fully or completely not with the first and second key parts
-     * from the @ref poly1305_ctx_t struct */
+     * the same time. This works because @ref poly1305_init reads the complete
+     * key from the state before writing the poly1305 state. */
     uint32_t state[16];     /**< The current state of the key stream. */
     poly1305_ctx_t poly;    /**< Poly1305 state for the MAC */
 } chacha20poly1305_ctx_t;
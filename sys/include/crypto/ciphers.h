@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "modules.h"
 
@@ -102,6 +103,24 @@ typedef struct cipher_interface_st {
     /** @brief the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /**
+     * @brief encrypt several consecutive blocks
+     *
+     * Optional, NULL if the cipher has no faster way than encrypting one
+     * block after another.
+     */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+    /**
+     * @brief decrypt several consecutive blocks
+     *
+     * Optional, NULL if the cipher has no faster way than decrypting one
+     * block after another.
+     */
+    int (*decrypt_blocks)(const cipher_context_t *ctx, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
 } cipher_interface_t;
 
 /** Pointer type to BlockCipher-Interface for the Cipher-Algorithms */
@@ -173,6 +192,45 @@ int cipher_encrypt(const cipher_t *cipher, const uint8_t *input,
 int cipher_decrypt(const cipher_t *cipher, const uint8_t *input,
                    uint8_t *output);
 
+/**
+ * @brief Encrypt several consecutive blocks
+ *
+ * Equivalent to calling cipher_encrypt() for every block, but allows the
+ * cipher to share work between blocks, e.g. the key schedule. Modes of
+ * operation should use this whenever blocks are independent of each other.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data to encrypt
+ * @param output     pointer to allocated memory for encrypted data. It has to
+ *                   be of size @p blocks * BLOCK_SIZE and may be equal to
+ *                   @p input
+ * @param blocks     number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
+/**
+ * @brief Decrypt several consecutive blocks
+ *
+ * Equivalent to calling cipher_decrypt() for every block, but allows the
+ * cipher to share work between blocks, e.g. the key schedule.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p blocks blocks of input data to decrypt
+ * @param output     pointer to allocated memory for decrypted data. It has to
+ *                   be of size @p blocks * BLOCK_SIZE and may be equal to
+ *                   @p input
+ * @param blocks     number of blocks
+ *
+ * @return           1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_decrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t blocks);
+
 /**
  * @brief Get block size of cipher
  * *
@@ -26,6 +26,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Number of counter blocks encrypted with a single call to the cipher
+ *
+ * Larger values allow the cipher to share more work between blocks, at the
+ * cost of a larger buffer on the stack.
+ */
+#ifndef CONFIG_CRYPTO_MODES_CTR_BLOCKS
+#define CONFIG_CRYPTO_MODES_CTR_BLOCKS      4
+#endif
+
 /**
  * @brief Encrypt data of arbitrary length in counter mode.
  *
@@ -44,10 +44,10 @@ extern "C" {
  * @brief Poly1305 context
  */
 typedef struct {
-    uint32_t r[4];                          /**< first key part         */
+    uint32_t r[5];                          /**< first key part, radix 2^26 */
     uint32_t pad[4];                        /**< Second key part        */
-    uint32_t h[5];                          /**< Hash                   */
-    uint32_t c[4];                          /**< Message chunk          */
+    uint32_t h[5];                          /**< Hash, radix 2^26       */
+    uint8_t c[POLY1305_BLOCK_SIZE];         /**< Message chunk          */
     size_t c_idx;                           /**< Chunk length            */
 } poly1305_ctx_t;
 
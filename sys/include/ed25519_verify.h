@@ -0,0 +1,146 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ed25519_verify Ed25519 verification contexts
+ * @ingroup     sys
+ * @brief       Fast repeated Ed25519 signature verification against a
+ *              known public key
+ *
+ * Verifying an Ed25519 signature `(R, s)` over a message `M` with the
+ * public key `A` checks that `R = sB - hA`, with `h` the hash of `R`, `A`
+ * and `M`. @ref pkg_c25519 computes both scalar multiplications from
+ * scratch with 256 doublings and additions each and decompresses `A` for
+ * every signature.
+ *
+ * Trust anchors, such as the keys SUIT manifests or EDHOC peers are checked
+ * against, rarely change. This module precomputes the comb table of a public
+ * key once in @ref ed25519_verify_init(). Together with a table for the base
+ * point `B`, which is stored in flash, a verification then needs 64 point
+ * doublings and up to 128 point additions instead of 512 doublings and
+ * additions, and no decompression of `A`.
+ *
+ * The table has `2^CONFIG_ED25519_VERIFY_TEETH - 1` entries of 128 bytes:
+ *
+ * | Teeth | Context size | Doublings per verification |
+ * |:-----:|-------------:|---------------------------:|
+ * |   1   |        160 B |                        253 |
+ * |   2   |        416 B |                        127 |
+ * |   3   |        928 B |                         85 |
+ * |   4   |       1952 B |                         64 |
+ *
+ * The context only holds public data and is not modified by
+ * @ref ed25519_verify(), so it may be computed once and stored in flash.
+ *
+ * Usage:
+ *
+ * ```makefile
+ * USEMODULE += ed25519_verify
+ * ```
+ *
+ * @{
+ *
+ * @file
+ * @brief       Ed25519 verification context definitions
+ */
+
+#ifndef ED25519_VERIFY_H
+#define ED25519_VERIFY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ed25519.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_ed25519_verify_config Ed25519 verification compile time configuration
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Number of comb teeth of the public key table, 1 to 4
+ *
+ * Each additional tooth doubles the size of @ref ed25519_verify_ctx_t and
+ * saves doublings.
+ */
+#ifndef CONFIG_ED25519_VERIFY_TEETH
+#define CONFIG_ED25519_VERIFY_TEETH     4
+#endif
+/** @} */
+
+/**
+ * @brief   Size of an Ed25519 public key in bytes
+ */
+#define ED25519_VERIFY_PUBKEY_SIZE      (32U)
+
+/**
+ * @brief   Size of an Ed25519 signature in bytes
+ */
+#define ED25519_VERIFY_SIGNATURE_SIZE   (64U)
+
+/**
+ * @brief   Number of entries of the public key table
+ */
+#define ED25519_VERIFY_TABLE_SIZE       ((1U << CONFIG_ED25519_VERIFY_TEETH) - 1)
+
+/**
+ * @brief   Verification context of a public key
+ */
+typedef struct {
+    /**
+     * @brief   Comb table of the negated public key
+     */
+    struct ed25519_pt table[ED25519_VERIFY_TABLE_SIZE];
+    uint8_t pub[ED25519_VERIFY_PUBKEY_SIZE];        /**< Public key */
+} ed25519_verify_ctx_t;
+
+/**
+ * @brief   Initialize a verification context
+ *
+ * @param[out] ctx  Context to initialize
+ * @param[in]  pub  Public key, @ref ED25519_VERIFY_PUBKEY_SIZE bytes
+ *
+ * @retval  0       on success
+ * @retval  -EINVAL @p pub is not a valid point
+ */
+int ed25519_verify_init(ed25519_verify_ctx_t *ctx, const uint8_t *pub);
+
+/**
+ * @brief   Verify a signature with the public key of a context
+ *
+ * The checks are stricter than those of `edsign_verify()` of
+ * @ref pkg_c25519, which reduces `s` and compares `R` after a round trip
+ * through its point encoding. This function follows RFC 8032 instead and
+ * rejects signatures that `edsign_verify()` may accept:
+ *
+ * - `s` is not reduced, i.e. `s >= l`
+ * - `R` is not the canonical encoding of its point, e.g. an `y` coordinate
+ *   not reduced modulo `p` or a negative zero `x` coordinate
+ *
+ * Signatures created by a conforming signer, including `edsign_sign()`,
+ * pass both checks.
+ *
+ * @param[in] ctx   Context of the public key
+ * @param[in] sig   Signature, @ref ED25519_VERIFY_SIGNATURE_SIZE bytes
+ * @param[in] msg   Signed message
+ * @param[in] len   Length of @p msg in bytes
+ *
+ * @retval  0           the signature is valid
+ * @retval  -EBADMSG    the signature is invalid
+ */
+int ed25519_verify(const ed25519_verify_ctx_t *ctx, const uint8_t *sig,
+                   const void *msg, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ED25519_VERIFY_H */
+/** @} */
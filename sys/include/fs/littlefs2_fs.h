@@ -12,6 +12,30 @@
  * @ingroup     pkg_littlefs2
  * @brief       RIOT integration of littlefs version 2.x.y
  *
+ * ## Persistent allocator state
+ *
+ * After mounting, littlefs has to traverse the whole file system to find
+ * free blocks before it can allocate the first block. On large devices this
+ * can take seconds. With the `littlefs2_persist_lookahead` module, the state
+ * of the block allocator (including the lookahead bitmap) is saved to a
+ * separate MTD device, e.g. a small @ref drivers_mtd_mapper region next to
+ * the file system, when the file system is unmounted. It is restored on the
+ * next mount, so the traversal is skipped after a clean shutdown.
+ *
+ * The saved state is tied to the file system by a generation counter that
+ * is stored as an attribute of the root directory and incremented on every
+ * unmount, and by a fingerprint of the metadata of all directories. The
+ * saved state is erased when it is restored, so it is never used after an
+ * unclean shutdown. Firmware that does not use this feature leaves the saved
+ * state in place, but any change it makes to the file system changes the
+ * fingerprint, so the state is discarded on the next mount. Computing the
+ * fingerprint reads the metadata of all directories, but not the blocks of
+ * files. No state is saved if a directory path exceeds 63 characters.
+ *
+ * Set @ref CONFIG_LITTLEFS2_LOOKAHEAD_SIZE to `block_count / 8` to cover
+ * the whole device with the lookahead bitmap, otherwise the traversal is
+ * only postponed until the blocks of the saved lookahead window are used.
+ *
  * @{
  *
  * @file
@@ -28,6 +52,7 @@
 
 #include "vfs.h"
 #include "lfs.h"
+#include "modules.h"
 #include "mtd.h"
 #include "mutex.h"
 
@@ -115,6 +140,11 @@ typedef struct {
     /** lookahead buffer to use internally */
     alignas(uint32_t) uint8_t lookahead_buf[CONFIG_LITTLEFS2_LOOKAHEAD_SIZE];
     uint16_t sectors_per_block; /**< number of sectors per block */
+#if IS_USED(MODULE_LITTLEFS2_PERSIST_LOOKAHEAD) || DOXYGEN
+    /** MTD device to save the allocator state to on unmount, may be NULL.
+     * Requires the `littlefs2_persist_lookahead` module. */
+    mtd_dev_t *state_dev;
+#endif
 } littlefs2_desc_t;
 
 /** The littlefs vfs driver */
@@ -0,0 +1,103 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup  sys_fs_romfs RomFS read-only image file system
+ * @ingroup   sys_fs
+ * @brief     Read-only file system stored as an image in memory mapped flash
+ *
+ * Unlike @ref sys_fs_constfs, the file system content is not compiled into
+ * the application but stored as a separate image, e.g. in a partition of the
+ * internal flash that is written independently of the firmware. Since the
+ * image is memory mapped, file content can be accessed in place with
+ * @ref vfs_mmap, without copying it to RAM first.
+ *
+ * The image can be created with `dist/tools/romfs/mkromfs.py`. All fields are
+ * little endian:
+ *
+ * | Offset          | Content                                         |
+ * |-----------------|-------------------------------------------------|
+ * | 0               | magic "RMFS"                                    |
+ * | 4               | number of files `n`                             |
+ * | 8 + 12 * i      | entry `i`: name offset, data offset, data size  |
+ * | 8 + 12 * n      | null terminated file names and file data        |
+ *
+ * All offsets are relative to the start of the image, which must be 4 byte
+ * aligned. The directory structure is flat.
+ *
+ * @{
+ * @file
+ * @brief   RomFS public API
+ */
+
+#ifndef FS_ROMFS_H
+#define FS_ROMFS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "byteorder.h"
+#include "mtd.h"
+#include "vfs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number at the start of a RomFS image ("RMFS")
+ */
+#define ROMFS_MAGIC         (0x53464d52UL)
+
+/**
+ * @brief   RomFS image header
+ */
+typedef struct {
+    le_uint32_t magic;      /**< @ref ROMFS_MAGIC */
+    le_uint32_t nfiles;     /**< number of file entries following the header */
+} romfs_header_t;
+
+/**
+ * @brief   RomFS file entry
+ */
+typedef struct {
+    le_uint32_t name;       /**< offset of the null terminated file name */
+    le_uint32_t data;       /**< offset of the file data */
+    le_uint32_t size;       /**< size of the file data */
+} romfs_entry_t;
+
+/**
+ * @brief   RomFS file system descriptor
+ *
+ * Either @p dev or @p image and @p size have to be set.
+ */
+typedef struct {
+    /**
+     * @brief   MTD device holding the image
+     *
+     * The device has to be a @ref drivers_mtd_flashpage device, as the image
+     * is accessed in place. If set, @p image and @p size are filled in by
+     * the mount operation.
+     */
+    mtd_dev_t *dev;
+    const void *image;      /**< image in memory mapped storage */
+    size_t size;            /**< size of @p image in bytes */
+} romfs_desc_t;
+
+/**
+ * @brief   RomFS file system driver
+ *
+ * For use with vfs_mount
+ */
+extern const vfs_file_system_t romfs_file_system;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FS_ROMFS_H */
+
+/** @} */
@@ -33,6 +33,14 @@
  * @defgroup    sys_hashes_sha256 SHA-256
  * @ingroup     sys_hashes_unkeyed
  * @brief       Implementation of the SHA-256 hashing function
+ *
+ * Full input blocks are hashed directly from the buffer passed to
+ * @ref sha256_update(), so hashing large buffers at once is fastest.
+ *
+ * The `hashes_sha2xx_unroll` pseudomodule unrolls the rounds of the block
+ * transform, which is faster on most MCUs at the expense of flash. CPUs with
+ * the `cpu_sha2xx` feature provide a block transform using dedicated
+ * instructions, which is used automatically.
  * @{
  *
  * @file
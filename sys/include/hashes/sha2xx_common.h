@@ -102,6 +102,22 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+/**
+ * @brief Architecture specific SHA-256 block transform
+ *
+ * Provided by the CPU if it has the `cpu_sha2xx` feature and the
+ * `sha2xx_arch` module is used. Blocks the function does not process, e.g.
+ * because the instructions are not available at runtime, are processed by
+ * the generic implementation.
+ *
+ * @param[in,out] state     SHA-256 state to update
+ * @param[in]     blocks    Input blocks, not necessarily aligned
+ * @param[in]     numof     Number of 64 byte blocks in @p blocks
+ *
+ * @return  Number of blocks processed from the beginning of @p blocks
+ */
+size_t sha2xx_transform_arch(uint32_t *state, const void *blocks, size_t numof);
+
 /**
  * @brief SHA-2XX initialization.  Begins a SHA-2XX operation.
  *
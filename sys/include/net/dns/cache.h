@@ -17,13 +17,21 @@
  * @file
  * @brief   DNS cache definitions
  *
- * This implements a simple DNS cache for A and AAAA entries.
+ * This implements a DNS cache for A and AAAA entries.
+ *
+ * Names are stored in an open addressed hash table, every name can hold
+ * both an A and an AAAA record with separate lifetimes. Lookups only probe
+ * the slots following the hash of the name, so the cache can be sized for
+ * hundreds of names.
  *
  * The cache eviction strategy is based on the remaining time to live
  * of the cache entries, so the first entry to expire will be evicted.
+ * A new name is only added to a full cache if its record outlives the
+ * records evicted for it, otherwise it is not cached. As a name is only
+ * evicted with its last record, this may take the eviction of more than one
+ * record. Records are kept in a min-heap ordered by their expiry time, which
+ * makes both expiry and eviction cheap.
  *
- * This is fine if there are only few cache entries and cache eviction
- * is unlikely.
  * If there is communication to many different hosts, the addition of a
  * least-recently used counter could likely improve the behavior.
  *
@@ -42,7 +50,9 @@ extern "C" {
 #endif
 
 /**
- * @brief   Maximum number of DNS cache entries
+ * @brief   Maximum number of names in the DNS cache
+ *
+ * Each name can hold an A and an AAAA record.
  */
 #ifndef CONFIG_DNS_CACHE_SIZE
 #define CONFIG_DNS_CACHE_SIZE   4
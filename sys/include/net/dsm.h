@@ -92,6 +92,22 @@ dsm_state_t dsm_store(sock_dtls_t *sock, sock_dtls_session_t *session,
  */
 void dsm_remove(sock_dtls_t *sock, sock_dtls_session_t *session);
 
+/**
+ * @brief   Marks a stored session as used
+ *
+ * Moves the session to the end of the least recently used order without
+ * changing its state. Should be called whenever data is exchanged over the
+ * session, so that @ref dsm_get_least_recently_used_session() does not pick
+ * an active session for eviction.
+ *
+ * @param[in]  sock         @ref sock_dtls_t, which the session is created on
+ * @param[in]  session      Session that was used
+ *
+ * @return   0, on success
+ * @return   -ENOENT, when the session is not stored
+ */
+int dsm_touch(sock_dtls_t *sock, sock_dtls_session_t *session);
+
 /**
  * @brief   Returns the maximum number of sessions slots
  *
@@ -109,6 +125,9 @@ uint8_t dsm_get_num_available_slots(void);
 /**
  * @brief   Returns the least recently used session
  *
+ * Sessions are ordered by their last call to @ref dsm_store() or
+ * @ref dsm_touch(). Only established sessions are considered.
+ *
  * @param[in]   sock        @ref sock_dtls_t, which the session is created on
  * @param[out]  session     Oldest used session
  *
@@ -121,6 +121,31 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Supply a receive buffer for a Transmission Control Block (TCB)
+ *
+ * By default, each connection takes a receive buffer of GNRC_TCP_RCV_BUF_SIZE
+ * bytes from a static pool. This function assigns a user supplied buffer
+ * instead, e.g. to announce a larger receive window. Buffers larger than
+ * 65535 bytes require @ref CONFIG_GNRC_TCP_WND_SCALE_EN.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p buf must not be NULL.
+ *
+ * @note The buffer stays assigned to @p tcb until gnrc_tcp_tcb_init() is
+ *       called again. It must be valid as long as it is assigned.
+ *
+ * @param[in,out] tcb   TCB to assign the buffer to.
+ * @param[in]     buf   Receive buffer.
+ * @param[in]     len   Size of @p buf in bytes.
+ *
+ * @return   0 on success.
+ * @return   -EISCONN if @p tcb is already in use.
+ * @return   -EINVAL if @p len is smaller than CONFIG_GNRC_TCP_MSS.
+ */
+int gnrc_tcp_tcb_set_rcvbuf(gnrc_tcp_tcb_t *tcb, void *buf, size_t len);
+
 /**
  * @brief Initialize Transmission Control Block (TCB) queue
  * @pre @p queue must not be NULL.
@@ -214,6 +239,11 @@ int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       Transmitted data is held in the packet buffer until it is acknowledged.
+ *       The function returns as soon as the retransmit queue has space for
+ *       another segment (see @ref CONFIG_GNRC_TCP_SND_QUEUE_SIZE), with the
+ *       default queue size of one segment this is after the data was
+ *       acknowledged.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -242,6 +272,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
  * @pre @p data must not be NULL.
  *
  * @note Function blocks if user_timeout_duration_us is not zero.
+ * @note While a blocking call waits for data, incoming payload is copied
+ *       directly into @p data instead of the receive buffer.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[out]    data                       Pointer to the buffer where the received data
@@ -101,6 +101,19 @@ extern "C" {
 #define CONFIG_GNRC_TCP_RCV_BUFFERS (1U)
 #endif
 
+/**
+ * @brief Number of preallocated CongURE state objects.
+ *
+ * Each connection takes one of them when it is set up, see
+ * @ref net_gnrc_tcp_congure. Connections that find none left run without
+ * congestion control. Increase this value if connections use receive buffers
+ * supplied via gnrc_tcp_tcb_set_rcvbuf() in addition to the preallocated
+ * ones.
+ */
+#ifndef CONFIG_GNRC_TCP_CONGURE_NUMOF
+#define CONFIG_GNRC_TCP_CONGURE_NUMOF (CONFIG_GNRC_TCP_RCV_BUFFERS)
+#endif
+
 /**
  * @brief Default receive buffer size
  */
@@ -108,6 +121,50 @@ extern "C" {
 #define GNRC_TCP_RCV_BUF_SIZE (CONFIG_GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Maximum number of unacknowledged segments per connection.
+ *
+ * Sent segments are held in the packet buffer until they are acknowledged.
+ * With the default of one segment, the send throughput of a connection is
+ * bound to one segment per round trip time. Larger values allow to fill the
+ * peers receive window (and the congestion window, see
+ * @ref net_gnrc_tcp_congure) at the cost of packet buffer space.
+ */
+#ifndef CONFIG_GNRC_TCP_SND_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_SND_QUEUE_SIZE (1U)
+#endif
+
+/**
+ * @brief Enable the window scale option (RFC 7323). Disabled by default.
+ *
+ * @note Window scaling only takes effect if both peers announce the option
+ *       during connection setup. It is required to announce receive windows
+ *       larger than 65535 bytes, e.g. for TCBs with a receive buffer supplied
+ *       via gnrc_tcp_tcb_set_rcvbuf().
+ */
+#ifndef CONFIG_GNRC_TCP_WND_SCALE_EN
+#define CONFIG_GNRC_TCP_WND_SCALE_EN 0
+#endif
+
+/**
+ * @brief Enable selective acknowledgments (RFC 2018). Disabled by default.
+ *
+ * @note If enabled, the SACK permitted option is announced during connection
+ *       setup and SACK blocks sent by the peer are taken into account to
+ *       detect segment loss early.
+ */
+#ifndef CONFIG_GNRC_TCP_SACK_EN
+#define CONFIG_GNRC_TCP_SACK_EN 0
+#endif
+
+/**
+ * @brief Number of duplicate acknowledgments that trigger a fast
+ *        retransmit (see RFC 5681). Zero disables fast retransmit.
+ */
+#ifndef CONFIG_GNRC_TCP_DUPACK_THRESH
+#define CONFIG_GNRC_TCP_DUPACK_THRESH (3U)
+#endif
+
 /**
  * @brief Lower bound for RTO in milliseconds. Default is 1 sec (see RFC 6298)
  *
@@ -21,6 +21,8 @@
 #define NET_GNRC_TCP_TCB_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "modules.h"
 #include "ringbuffer.h"
 #include "mutex.h"
 #include "evtimer_msg.h"
@@ -28,8 +30,13 @@
 #include "msg.h"
 #include "mbox.h"
 #include "net/gnrc/pkt.h"
+#include "net/tcp.h"
 #include "config.h"
 
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+#include "congure.h"
+#endif
+
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
 #endif
@@ -38,6 +45,28 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Block of data selectively acknowledged by the peer.
+ */
+typedef struct {
+    uint32_t left;         /**< Sequence number of the first byte in the block */
+    uint32_t right;        /**< Sequence number following the last byte in the block */
+} gnrc_tcp_sack_block_t;
+
+/**
+ * @brief Segment in the "retransmit queue" of a TCB.
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;   /**< Sent segment, held until it is acknowledged */
+    uint32_t seq;          /**< Sequence number of the segment */
+    uint16_t len;          /**< Sequence number space consumed by the segment */
+    bool sacked;           /**< Segment was selectively acknowledged by the peer */
+    bool resent;           /**< Segment was retransmitted during the current recovery */
+#if IS_USED(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+    congure_snd_msg_t congure_msg; /**< CongURE message of the segment */
+#endif
+} gnrc_tcp_rtx_entry_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -54,26 +83,40 @@ typedef struct sock_tcp {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint8_t snd_wnd_scale; /**< Window scale shift count announced by the peer */
+    uint8_t rcv_wnd_scale; /**< Window scale shift count announced to the peer */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Sequence number acknowledging the timed segment */
+    uint32_t recover;      /**< Highest sequence number sent when loss recovery started */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    uint8_t dup_acks;      /**< Number of duplicate acknowledgments received */
+    uint8_t sack_num;      /**< Number of valid entries in sack */
+    gnrc_tcp_sack_block_t sack[TCP_OPTION_SACK_BLOCKS_MAX]; /**< SACK blocks of last segment */
+#if IS_USED(MODULE_GNRC_TCP_CONGURE) || defined(DOXYGEN)
+    congure_snd_t *congure;           /**< State object for [CongURE](@ref sys_congure) */
+#endif
     evtimer_msg_event_t event_retransmit; /**< Retransmission event */
     evtimer_msg_event_t event_timeout;    /**< Timeout event */
     evtimer_mbox_event_t event_misc;      /**< General purpose event */
-    gnrc_pktsnip_t *pkt_retransmit;       /**< Pointer to packet in "retransmit queue" */
+    gnrc_tcp_rtx_entry_t rtx[CONFIG_GNRC_TCP_SND_QUEUE_SIZE]; /**< "Retransmit queue", oldest first */
+    uint8_t rtx_num;         /**< Number of segments in "retransmit queue" */
     mbox_t *mbox;            /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    uint8_t *rcv_usr_buf;    /**< User buffer posted by a blocking receive call */
+    size_t rcv_usr_len;      /**< Size of the posted user buffer */
+    size_t rcv_usr_got;      /**< Number of bytes stored in the posted user buffer */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
     struct sock_tcp *next;   /**< Pointer next TCB */
@@ -0,0 +1,308 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup net_gnrc_tcp_congure Congestion control for GNRC TCP
+ * @ingroup net_gnrc_tcp
+ *
+ * @brief Congestion control for GNRC TCP using the @ref sys_congure
+ *
+ * When included, this module limits the amount of unacknowledged data of a
+ * connection to the congestion window of a CongURE state object. The flavor
+ * of congestion control can be selected using the following sub-modules:
+ *
+ * - @ref net_gnrc_tcp_congure_reno (the default)
+ * - @ref net_gnrc_tcp_congure_abe
+ * - @ref net_gnrc_tcp_congure_quic
+ *
+ * The window unit is one byte. Duplicate acknowledgments are detected and
+ * handled by GNRC TCP itself, segments that are fast retransmitted are
+ * reported to CongURE as lost, an expired retransmission timer reports all
+ * unacknowledged segments as timed out.
+ * @{
+ *
+ * @file
+ * @brief   Congure definitions for @ref net_gnrc_tcp
+ */
+#ifndef NET_GNRC_TCP_TCP_CONGURE_H
+#define NET_GNRC_TCP_TCP_CONGURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "clist.h"
+#include "congure.h"
+#include "evtimer.h"
+#include "modules.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if IS_USED(MODULE_GNRC_TCP_CONGURE) || DOXYGEN
+/**
+ * @brief   Retrieve CongURE state object from a pool of free objects
+ *
+ * Needs to be defined for each CongURE implementation `congure_x` e.g. as
+ * a sub-module `gnrc_tcp_congure_x` and call the respective
+ * `congure_x_snd_setup` function when a free object is available for that
+ * object. As such, congure_snd_t::driver == NULL can be used as an identifier
+ * if a state object is free.
+ *
+ * The pool of objects has to have an initial size of
+ * @ref CONFIG_GNRC_TCP_CONGURE_NUMOF.
+ *
+ * @return  A CongURE state object on success
+ * @return  NULL, if no free CongURE state object is available (including when
+ *          when module `gnrc_tcp_congure` is not included).
+ */
+congure_snd_t *gnrc_tcp_congure_snd_get(void);
+#else
+static inline congure_snd_t *gnrc_tcp_congure_snd_get(void)
+{
+    return NULL;
+}
+#endif
+
+/**
+ * @brief   Retrieve CongURE state object when not retrieved and initialize it
+ *          for a TCB
+ *
+ * @note    If no state object is available, the connection runs without
+ *          congestion control.
+ *
+ * @param[in,out] tcb   A TCB
+ */
+static inline void gnrc_tcp_congure_snd_setup(gnrc_tcp_tcb_t *tcb)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    if (tcb->congure == NULL) {
+        tcb->congure = gnrc_tcp_congure_snd_get();
+        if (tcb->congure != NULL) {
+            tcb->congure->driver->init(tcb->congure, tcb);
+        }
+    }
+#else
+    (void)tcb;
+#endif
+}
+
+/**
+ * @brief   Frees the CongURE state object of a TCB and sets it to `NULL`
+ *
+ * This makes the CongURE state object retrievable with
+ * @ref gnrc_tcp_congure_snd_get again.
+ *
+ * @param[in,out] tcb   A TCB
+ */
+static inline void gnrc_tcp_congure_snd_destroy(gnrc_tcp_tcb_t *tcb)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    if (tcb->congure != NULL) {
+        tcb->congure->driver = NULL;
+        tcb->congure = NULL;
+    }
+#else
+    (void)tcb;
+#endif
+}
+
+/**
+ * @brief   Returns the congestion window of a TCB in bytes
+ *
+ * @param[in] tcb   A TCB
+ *
+ * @return  The congestion window of @p tcb.
+ * @return  UINT32_MAX, if @p tcb has no CongURE state object.
+ */
+static inline uint32_t gnrc_tcp_congure_snd_cwnd(const gnrc_tcp_tcb_t *tcb)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    if (tcb->congure != NULL) {
+        return tcb->congure->cwnd;
+    }
+#else
+    (void)tcb;
+#endif
+    return UINT32_MAX;
+}
+
+/**
+ * @brief   Report to CongURE that a segment was sent.
+ *
+ * @param[in,out] tcb      A TCB
+ * @param[in,out] entry    Entry of the segment in the retransmit queue of @p tcb.
+ * @param[in]     size     Number of payload bytes in the segment.
+ * @param[in]     resend   True, if the segment is a retransmission.
+ */
+static inline void gnrc_tcp_congure_snd_report_sent(gnrc_tcp_tcb_t *tcb,
+                                                    gnrc_tcp_rtx_entry_t *entry,
+                                                    unsigned size, bool resend)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    congure_snd_t *c = tcb->congure;
+
+    if (c != NULL) {
+        c->driver->report_msg_sent(c, size);
+        if (resend) {
+            entry->congure_msg.resends++;
+        }
+        else {
+            entry->congure_msg.send_time = evtimer_now_msec();
+            entry->congure_msg.size = size;
+            entry->congure_msg.resends = 0;
+        }
+    }
+#else
+    (void)tcb;
+    (void)entry;
+    (void)size;
+    (void)resend;
+#endif
+}
+
+/**
+ * @brief   Report to CongURE that the retransmission timer expired.
+ *
+ * All segments in the retransmit queue are reported as timed out.
+ *
+ * @param[in,out] tcb   A TCB
+ */
+static inline void gnrc_tcp_congure_snd_report_timeout(gnrc_tcp_tcb_t *tcb)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    congure_snd_t *c = tcb->congure;
+
+    if (c != NULL) {
+        clist_node_t msgs = { NULL };
+
+        for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+            if (tcb->rtx[i].congure_msg.size > 0) {
+                clist_rpush(&msgs, &tcb->rtx[i].congure_msg.super);
+            }
+        }
+        if (msgs.next != NULL) {
+            c->driver->report_msgs_timeout(c, (congure_snd_msg_t *)&msgs);
+        }
+    }
+#else
+    (void)tcb;
+#endif
+}
+
+/**
+ * @brief   Add a segment to a list of segments to report as lost.
+ *
+ * @param[in,out] msgs    List of segments to report.
+ * @param[in,out] entry   Entry of the lost segment in the retransmit queue.
+ */
+static inline void gnrc_tcp_congure_snd_msgs_add(clist_node_t *msgs,
+                                                 gnrc_tcp_rtx_entry_t *entry)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    if (entry->congure_msg.size > 0) {
+        clist_rpush(msgs, &entry->congure_msg.super);
+    }
+#else
+    (void)msgs;
+    (void)entry;
+#endif
+}
+
+/**
+ * @brief   Report to CongURE that segments were lost and are fast
+ *          retransmitted.
+ *
+ * @param[in,out] tcb    A TCB
+ * @param[in]     msgs   List of lost segments, filled by
+ *                       @ref gnrc_tcp_congure_snd_msgs_add().
+ */
+static inline void gnrc_tcp_congure_snd_report_lost(gnrc_tcp_tcb_t *tcb,
+                                                    clist_node_t *msgs)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    congure_snd_t *c = tcb->congure;
+
+    if (c != NULL && msgs->next != NULL) {
+        c->driver->report_msgs_lost(c, (congure_snd_msg_t *)msgs);
+    }
+#else
+    (void)tcb;
+    (void)msgs;
+#endif
+}
+
+/**
+ * @brief   Report to CongURE that segments in the retransmit queue were
+ *          acknowledged.
+ *
+ * All segments acknowledged by @p seg_ack are reported as one message, so
+ * a cumulative acknowledgment is not mistaken for duplicates.
+ *
+ * @pre     Must be called before the acknowledged segments are removed from
+ *          the retransmit queue.
+ *
+ * @param[in,out] tcb       A TCB
+ * @param[in]     seg_ack   Acknowledgment number of the received segment.
+ * @param[in]     seg_wnd   Window of the received segment in bytes.
+ * @param[in]     size      Number of payload bytes of the received segment.
+ * @param[in]     clean     True, if neither SYN nor FIN are set in the
+ *                          received segment.
+ */
+static inline void gnrc_tcp_congure_snd_report_acked(gnrc_tcp_tcb_t *tcb,
+                                                     uint32_t seg_ack, uint32_t seg_wnd,
+                                                     unsigned size, bool clean)
+{
+#if IS_USED(MODULE_GNRC_TCP_CONGURE)
+    congure_snd_t *c = tcb->congure;
+
+    if (c != NULL) {
+        congure_snd_msg_t msg = { .size = 0 };
+        uint32_t acked = 0;
+
+        for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+            const gnrc_tcp_rtx_entry_t *entry = &tcb->rtx[i];
+
+            /* stop at the first segment not acknowledged completely */
+            if ((int32_t)(seg_ack - (entry->seq + entry->len)) < 0) {
+                break;
+            }
+            msg.send_time = entry->congure_msg.send_time;
+            acked += entry->congure_msg.size;
+            if (entry->congure_msg.resends > msg.resends) {
+                msg.resends = entry->congure_msg.resends;
+            }
+        }
+        if (acked > 0) {
+            msg.size = (acked < CONGURE_WND_SIZE_MAX) ? acked : CONGURE_WND_SIZE_MAX;
+            congure_snd_ack_t ack = {
+                .recv_time = evtimer_now_msec(),
+                /* relative to the ISS, so IDs grow monotonic from a small value */
+                .id = seg_ack - tcb->iss,
+                .size = size,
+                .wnd = (seg_wnd < CONGURE_WND_SIZE_MAX) ? seg_wnd : CONGURE_WND_SIZE_MAX,
+                .clean = clean,
+            };
+
+            c->driver->report_msg_acked(c, &msg, &ack);
+        }
+    }
+#else
+    (void)tcb;
+    (void)seg_ack;
+    (void)seg_wnd;
+    (void)size;
+    (void)clean;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TCP_TCP_CONGURE_H */
+/** @} */
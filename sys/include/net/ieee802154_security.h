@@ -32,6 +32,8 @@
 
 #include <stdint.h>
 #include "ieee802154.h"
+#include "kernel_defines.h"
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
 
 #ifdef __cplusplus
@@ -64,23 +66,12 @@ typedef struct ieee802154_radio_cipher_ops {
     void (*set_key)(ieee802154_sec_dev_t *dev,
                     const uint8_t *key,
                     uint8_t key_size);
-    /**
-     * @brief   Function type to compute CBC-MAC
-     *
-     * @param[in]       dev         Will be @ref ieee802154_sec_context_t::ieee802154_sec_dev_t
-     * @param[in]       cipher      Output cipher blocks
-     * @param[in, out]  iv          in: IV; out: computed MIC
-     * @param[in]       plain       Input plain blocks
-     * @param[in]       nblocks     Number of blocks
-     */
-    void (*cbc)(const ieee802154_sec_dev_t *dev,
-                uint8_t *cipher,
-                uint8_t *iv,
-                const uint8_t *plain,
-                uint8_t nblocks);
     /**
      * @brief   Function type to perform ECB encryption
      *
+     * The CBC-MAC and the key stream of CCM* are both computed with this
+     * function.
+     *
      * @param[in]       dev         Will be @ref ieee802154_sec_context_t::ieee802154_sec_dev_t
      * @param[out]      cipher      Output cipher blocks
      * @param[in]       plain       Input plain blocks
@@ -266,6 +257,20 @@ typedef struct ieee802154_sec_context {
      * @brief   802.15.4 security dev
      */
     ieee802154_sec_dev_t dev;
+#if IS_USED(MODULE_IEEE802154_SECURITY_SOFT_CIPHER) || defined(DOXYGEN)
+    /**
+     * @brief   Expanded key for the software AES implementation
+     *
+     * Only present with the `ieee802154_security_soft_cipher` module and only
+     * used if the device does not provide an ECB implementation.
+     * It is computed again when the key in @ref cipher changes.
+     */
+    aes_key_schedule_t key_schedule;
+    /**
+     * @brief   Key @ref key_schedule has been computed from
+     */
+    uint8_t key_schedule_key[IEEE802154_SEC_KEY_LENGTH];
+#endif
 } ieee802154_sec_context_t;
 
 /**
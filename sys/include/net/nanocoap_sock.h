@@ -175,6 +175,24 @@ extern "C" {
 #define CONFIG_NANOCOAP_SERVER_STACK_SIZE       THREAD_STACKSIZE_DEFAULT
 #endif
 
+/**
+ * @brief   Number of blocks requested in parallel by
+ *          @ref nanocoap_sock_get_blockwise
+ *
+ * If set to a value > 1, block-wise GET requests keep up to this many
+ * block requests in flight at the same time instead of waiting a full
+ * round trip for every block. Blocks that arrive out of order are buffered
+ * and handed to the callback in order, so this needs
+ * `CONFIG_NANOCOAP_BLOCKWISE_WINDOW << CONFIG_NANOCOAP_BLOCK_SIZE_EXP_MAX`
+ * bytes of stack.
+ *
+ * @note    This exceeds the default NSTART of 1 (RFC 7252, section 4.7),
+ *          only enable it if the server and the path can cope with it.
+ */
+#ifndef CONFIG_NANOCOAP_BLOCKWISE_WINDOW
+#define CONFIG_NANOCOAP_BLOCKWISE_WINDOW        (1)
+#endif
+
 /**
  * @brief   NanoCoAP socket types
  */
@@ -460,6 +478,9 @@ ssize_t nanocoap_sock_delete_url(const char *url);
  * block-wise-transfer. A coap_blockwise_cb_t will be called on each received
  * block.
  *
+ * If @ref CONFIG_NANOCOAP_BLOCKWISE_WINDOW is > 1, this uses
+ * @ref nanocoap_sock_get_blockwise_window with a buffer on the stack.
+ *
  * @param[in]   sock       socket to use for the request
  * @param[in]   path       pointer to source path
  * @param[in]   blksize    sender suggested SZX for the COAP block request
@@ -473,6 +494,43 @@ int nanocoap_sock_get_blockwise(nanocoap_sock_t *sock, const char *path,
                                 coap_blksize_t blksize,
                                 coap_blockwise_cb_t callback, void *arg);
 
+/**
+ * @brief    Performs a blockwise coap get request on a socket, keeping
+ *           multiple block requests in flight.
+ *
+ * After the first block has been received, up to
+ * @ref CONFIG_NANOCOAP_BLOCKWISE_WINDOW blocks are requested in parallel.
+ * The window is further limited by the number of blocks that fit in @p buf,
+ * which is used to buffer blocks that are received out of order.
+ * @p callback is still called for each block in order, with increasing
+ * offsets.
+ *
+ * If @p buf can't hold at least two blocks of the block size chosen by the
+ * server, the remaining blocks are fetched one at a time.
+ *
+ * Blocks behind the end of the resource may be requested before the end is
+ * known. An error response to such a block ends the transfer after the last
+ * block the server delivered. It is only reported if that block still had
+ * the more flag set.
+ *
+ * @param[in]   sock       socket to use for the request
+ * @param[in]   path       pointer to source path
+ * @param[in]   blksize    sender suggested SZX for the COAP block request
+ * @param[in]   buf        buffer for blocks received out of order
+ * @param[in]   len        size of @p buf
+ * @param[in]   callback   callback to be executed on each received block
+ * @param[in]   arg        optional function arguments
+ *
+ * @returns     -ETIMEDOUT if a block could not be retrieved
+ * @returns     -EBADMSG   if the server sent an invalid block
+ * @returns     <0         other error, e.g. returned by @p callback
+ * @returns      0         on success
+ */
+int nanocoap_sock_get_blockwise_window(nanocoap_sock_t *sock, const char *path,
+                                       coap_blksize_t blksize,
+                                       void *buf, size_t len,
+                                       coap_blockwise_cb_t callback, void *arg);
+
 /**
  * @brief    Performs a blockwise coap get request to the specified url.
  *
@@ -24,6 +24,17 @@
  *  - Hardware Random Number Generator (non-seedable)
  *    HWRNG differ in how they generate random numbers and may not use a PRNG internally.
  *    Refer to the manual of your MCU for details.
+ *
+ * The output of Fortuna is generated in blocks of
+ * @ref CONFIG_RANDOM_BUFFER_SIZE bytes and handed out from a buffer, so most
+ * calls to @ref random_uint32() only copy from the buffer instead of running
+ * the generator. Bytes left over from one call are handed out by the next
+ * one, so @ref random_bytes() returns other sequences than without the
+ * buffer. Returned bytes are wiped from the buffer and reseeding with
+ * @ref random_init() discards it. As RIOT has no thread local storage, the
+ * buffer is shared by all threads and protected by a mutex, so Fortuna must
+ * not be used from interrupt context. The SHA based generators hand out
+ * their digests bytewise already and do not use this buffer.
  */
 
 #ifndef RANDOM_H
@@ -44,6 +55,16 @@ extern "C" {
 #define RANDOM_SEED_DEFAULT (1)
 #endif
 
+/**
+ * @brief   Size of the output buffer of Fortuna in bytes
+ *
+ * A multiple of 4, 0 disables the buffer. Larger buffers need fewer
+ * generator runs but keep more future output in memory.
+ */
+#ifndef CONFIG_RANDOM_BUFFER_SIZE
+#define CONFIG_RANDOM_BUFFER_SIZE   (32U)
+#endif
+
 /**
  * @brief Enables support for floating point random number generation
  */
@@ -50,6 +50,15 @@
  * fit into this and FLASHPAGE_SIZE must be a multiple of
  * RIOTBOOT_FLASHPAGE_BUFFER_SIZE
  *
+ * With `USEMODULE += riotboot_flashwrite_heatshrink`, images can be transferred
+ * compressed with @ref pkg_heatshrink. Initialize the update using
+ * riotboot_flashwrite_init_compressed() and pass the compressed image to
+ * riotboot_flashwrite_putbytes(). The data is decompressed while it is
+ * written, so the riotboot header and riotboot_flashwrite_verify_sha256()
+ * refer to the decompressed image. Images must be compressed with the window
+ * and lookahead sizes the decoder is built with, i.e. using
+ * `heatshrink -e -w 8 -l 4` for the defaults of the package.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  * @author      Koen Zandberg <koen@bergzand.net>
  *
@@ -63,8 +72,14 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+
+#include "kernel_defines.h"
 #include "riotboot/slot.h"
 #include "periph/flashpage.h"
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK)
+#include "heatshrink_decoder.h"
+#endif
 
 /**
  * @brief Enable/disable raw writes to flash
@@ -90,6 +105,14 @@ extern "C" {
 
 #endif /* !CONFIG_RIOTBOOT_FLASHWRITE_RAW */
 
+/**
+ * @brief Number of flash pages @ref riotboot_flashwrite_erase_ahead() may
+ *        erase ahead of the page currently written
+ */
+#ifndef CONFIG_RIOTBOOT_FLASHWRITE_ERASE_AHEAD
+#define CONFIG_RIOTBOOT_FLASHWRITE_ERASE_AHEAD  1
+#endif
+
 /**
  * @brief Extra attributes required for the firmware intermediate buffer
  */
@@ -107,6 +130,7 @@ typedef struct {
     int target_slot;                        /**< update targets this slot     */
     size_t offset;                          /**< update is at this position   */
     unsigned flashpage;                     /**< update is at this flashpage  */
+    unsigned erase_page;                    /**< first page not erased yet    */
 
     /**
      * @brief flash writing buffer
@@ -121,6 +145,11 @@ typedef struct {
     uint8_t RIOTBOOT_FLASHPAGE_BUFFER_ATTRS
         firstblock_buf[RIOTBOOT_FLASHPAGE_BUFFER_SIZE];
 #endif
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK) || DOXYGEN
+    heatshrink_decoder decoder;             /**< decoder for compressed images*/
+    size_t skip;                            /**< decompressed bytes to skip   */
+    bool compressed;                        /**< image data is compressed     */
+#endif
 } riotboot_flashwrite_t;
 
 /**
@@ -169,6 +198,22 @@ static inline int riotboot_flashwrite_init(riotboot_flashwrite_t *state,
                                         RIOTBOOT_FLASHWRITE_SKIPLEN);
 }
 
+/**
+ * @brief   Initialize firmware update of a compressed image
+ *
+ * Like @ref riotboot_flashwrite_init(), but the data passed to @ref
+ * riotboot_flashwrite_putbytes() is the complete image compressed with
+ * heatshrink. The first RIOTBOOT_FLASHWRITE_SKIPLEN bytes of the decompressed
+ * image are skipped, the caller must not skip any compressed data.
+ *
+ * @param[in,out]   state       ptr to preallocated state structure
+ * @param[in]       target_slot slot to write update into
+ *
+ * @returns         0 on success, <0 otherwise
+ */
+int riotboot_flashwrite_init_compressed(riotboot_flashwrite_t *state,
+                                        int target_slot);
+
 /**
  * @brief   Feed bytes into the firmware writer
  *
@@ -176,6 +221,10 @@ static inline int riotboot_flashwrite_init(riotboot_flashwrite_t *state,
  *          riotboot_flashwrite_init(), make sure to skip the first
  *          RIOTBOOT_FLASHWRITE_SKIPLEN bytes.
  *
+ * If the update has been initialized via @ref
+ * riotboot_flashwrite_init_compressed(), @p bytes is compressed data and
+ * state::offset counts the decompressed bytes written.
+ *
  * @param[in,out]   state   ptr to previously used update state
  * @param[in]       bytes   ptr to data
  * @param[in]       len     len of data
@@ -224,6 +273,27 @@ static inline int riotboot_flashwrite_finish(riotboot_flashwrite_t *state)
                                           RIOTBOOT_FLASHWRITE_SKIPLEN);
 }
 
+/**
+ * @brief   Erase a flash page ahead of the write position
+ *
+ * Erasing a page takes considerably longer than writing to it. This function
+ * allows erasing the next page in advance, e.g. while waiting for the next
+ * chunk of the image to arrive. Pages erased this way are not erased again by
+ * @ref riotboot_flashwrite_putbytes().
+ *
+ * At most @ref CONFIG_RIOTBOOT_FLASHWRITE_ERASE_AHEAD pages ahead of the
+ * current page are erased, and never pages beyond the end of the slot.
+ *
+ * @note    Only effective with @ref CONFIG_RIOTBOOT_FLASHWRITE_RAW, otherwise
+ *          every page is erased as part of writing it.
+ *
+ * @param[in,out]   state   ptr to previously used update state
+ *
+ * @returns         1 if a page was erased
+ * @returns         0 if there is no page left to erase
+ */
+int riotboot_flashwrite_erase_ahead(riotboot_flashwrite_t *state);
+
 /**
  * @brief   Invalidate a slot header (riotboot version)
  *
@@ -226,6 +226,11 @@ typedef struct {
      * @brief Component offset inside the device memory.
      */
     suit_param_ref_t param_component_offset;
+
+    /**
+     * @brief Component the payload is a delta against, see @ref sys_suit_delta
+     */
+    suit_param_ref_t param_source_component;
 } suit_component_t;
 
 /**
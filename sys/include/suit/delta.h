@@ -0,0 +1,139 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_suit
+ * @defgroup    sys_suit_delta SUIT delta payloads
+ * @brief       VCDIFF encoded delta payloads for SUIT updates
+ *
+ * With `USEMODULE += suit_delta`, a component can be updated with a VCDIFF
+ * delta (as created by `vcdiff delta -interleaved`) instead of the full
+ * payload. The delta is applied while it is downloaded, using
+ * @ref pkg_tinyvcdiff. Only a fixed amount of RAM is needed, independent of
+ * the size of the payload.
+ *
+ * A component receives a delta payload if the manifest sets the
+ * `suit-parameter-source-component` parameter for it. The parameter holds the
+ * index of the component the delta is based on:
+ *
+ * - If the index refers to the component itself, the delta is applied to the
+ *   currently installed payload of the component. This requires a storage
+ *   backend that writes new payloads to a different place than the installed
+ *   one and implements @ref suit_storage_driver_t::read_installed, e.g.
+ *   @ref sys_suit_storage_flashwrite, which reads the running riotboot slot
+ *   and writes the other slot.
+ * - Otherwise, the delta is applied to the payload of the other component,
+ *   e.g. to another RAM region or file.
+ *
+ * The image size and digest parameters of the component refer to the
+ * resulting payload, not to the delta.
+ *
+ * @{
+ *
+ * @brief       SUIT delta payload API
+ */
+
+#ifndef SUIT_DELTA_H
+#define SUIT_DELTA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "suit.h"
+#include "suit/storage.h"
+#include "vcdiff.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of the buffer collecting the decoded payload
+ *
+ * Decoded data is written to the storage backend in chunks of this size.
+ * Must be at least 4 bytes to satisfy the riotboot flashwrite backend.
+ */
+#ifndef CONFIG_SUIT_DELTA_BUFSIZE
+#define CONFIG_SUIT_DELTA_BUFSIZE       64
+#endif
+
+/**
+ * @brief SUIT delta decoder context
+ */
+typedef struct {
+    vcdiff_t vcdiff;                /**< VCDIFF decoder */
+    const suit_manifest_t *manifest;/**< The suit manifest context */
+    suit_storage_t *source;         /**< Storage holding the source payload */
+    suit_storage_t *target;         /**< Storage to write the payload to */
+    size_t target_size;             /**< Expected size of the payload */
+    size_t offset;                  /**< Payload offset of @ref buf */
+    size_t buffered;                /**< Number of bytes in @ref buf */
+    bool installed;                 /**< Source is the installed payload */
+    bool source_selected;           /**< Source location is active */
+    /** Location of the source payload */
+    char source_location[CONFIG_SUIT_COMPONENT_MAX_NAME_LEN];
+    /** Location of the payload */
+    char target_location[CONFIG_SUIT_COMPONENT_MAX_NAME_LEN];
+    /** Decoded data not yet written to @ref target */
+    uint8_t buf[CONFIG_SUIT_DELTA_BUFSIZE];
+} suit_delta_t;
+
+/**
+ * @brief Start decoding a delta payload
+ *
+ * Must be called after @ref suit_storage_start() on @p target.
+ *
+ * @param[out]  delta           Delta decoder context
+ * @param[in]   manifest        The suit manifest context
+ * @param[in]   source          Storage holding the source payload
+ * @param[in]   source_location Location of the source payload, NULL to
+ *                              use the installed payload of @p target
+ * @param[in]   target          Storage to write the payload to
+ * @param[in]   target_location Location to write the payload to
+ * @param[in]   target_size     Size of the resulting payload in bytes
+ *
+ * @returns     @ref SUIT_OK on success
+ * @returns     @ref SUIT_ERR_UNSUPPORTED if @p source_location is NULL and
+ *              @p target can't read its installed payload
+ * @returns     @ref suit_error_t on other errors
+ */
+int suit_delta_start(suit_delta_t *delta, const suit_manifest_t *manifest,
+                     suit_storage_t *source, const char *source_location,
+                     suit_storage_t *target, const char *target_location,
+                     size_t target_size);
+
+/**
+ * @brief Feed the next chunk of the delta payload
+ *
+ * @param[in]   delta       Delta decoder context
+ * @param[in]   buf         Chunk of the delta
+ * @param[in]   len         Length of the chunk
+ *
+ * @returns     @ref SUIT_OK on success
+ * @returns     @ref suit_error_t on error
+ */
+int suit_delta_write(suit_delta_t *delta, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Finish decoding the delta payload
+ *
+ * Writes the remaining decoded data to the storage backend. Must be called
+ * before @ref suit_storage_finish().
+ *
+ * @param[in]   delta       Delta decoder context
+ *
+ * @returns     @ref SUIT_OK if the complete payload was decoded
+ * @returns     @ref suit_error_t on error
+ */
+int suit_delta_finish(suit_delta_t *delta);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUIT_DELTA_H */
+/** @} */
@@ -163,6 +163,9 @@ typedef struct suit_storage_driver {
     /**
      * @brief Read a chunk of previously written data back.
      *
+     * Must also return data that was written, but is still buffered by the
+     * backend. Delta payloads read back their output while it is written.
+     *
      * @param[in]   storage     Storage context
      * @param[out]  buf         Buffer to write the read data in
      * @param[in]   offset      Offset to read from
@@ -189,6 +192,60 @@ typedef struct suit_storage_driver {
     int (*read_ptr)(suit_storage_t *storage,
                     const uint8_t **buf, size_t *len);
 
+    /**
+     * @brief Read a chunk of the currently installed payload
+     *
+     * Only possible for backends that write new payloads to a different
+     * place than the installed one. Used as source for delta payloads.
+     *
+     * @note Optional to implement
+     *
+     * @param[in]   storage     Storage context
+     * @param[out]  buf         Buffer to write the read data in
+     * @param[in]   offset      Offset to read from
+     * @param[in]   len         Number of bytes to read
+     *
+     * @returns     @ref SUIT_OK on successfully reading the chunk
+     * @returns     @ref suit_error_t on error
+     */
+    int (*read_installed)(suit_storage_t *storage, uint8_t *buf,
+                          size_t offset, size_t len);
+
+    /**
+     * @brief Retrieve the SHA-256 digest of the payload, computed while it
+     *        was written
+     *
+     * Allows verifying the payload without reading it back. May be called
+     * repeatedly and must return the same digest each time.
+     *
+     * @note Optional to implement
+     *
+     * @param[in]   storage     Storage context
+     * @param[out]  digest      Buffer of SHA256_DIGEST_LENGTH bytes for the
+     *                          digest
+     * @param[out]  len         Number of payload bytes covered by the digest
+     *
+     * @returns     @ref SUIT_OK on successfully providing the digest
+     * @returns     @ref suit_error_t on error
+     */
+    int (*get_digest)(suit_storage_t *storage, uint8_t *digest, size_t *len);
+
+    /**
+     * @brief Prepare the storage for upcoming writes
+     *
+     * Called repeatedly while waiting for the next payload chunk, e.g. to
+     * erase flash ahead of the write position.
+     *
+     * @note Optional to implement
+     *
+     * @param[in]   storage     Storage context
+     *
+     * @returns     1 if some work was done and more may be left
+     * @returns     0 if there is nothing left to prepare
+     * @returns     @ref suit_error_t on error
+     */
+    int (*prepare)(suit_storage_t *storage);
+
     /**
      * @brief Install the payload or mark the payload as valid
      *
@@ -376,6 +433,34 @@ static inline bool suit_storage_has_readptr(const suit_storage_t *storage)
     return (storage->driver->read_ptr);
 }
 
+/**
+ * @brief Check if the storage backend implements the @ref
+ * suit_storage_driver_t::read_installed function
+ *
+ * @param[in]   storage     Storage context
+ *
+ * @returns     True if the function is implemented,
+ * @returns     False otherwise
+ */
+static inline bool suit_storage_has_read_installed(const suit_storage_t *storage)
+{
+    return (storage->driver->read_installed);
+}
+
+/**
+ * @brief Check if the storage backend implements the @ref
+ * suit_storage_driver_t::get_digest function
+ *
+ * @param[in]   storage     Storage context
+ *
+ * @returns     True if the function is implemented,
+ * @returns     False otherwise
+ */
+static inline bool suit_storage_has_digest(const suit_storage_t *storage)
+{
+    return (storage->driver->get_digest);
+}
+
 /**
  * @brief Check if the storage backend implements the @ref
  * suit_storage_driver_t::match_offset function
@@ -487,6 +572,63 @@ static inline int suit_storage_read_ptr(suit_storage_t *storage, const uint8_t
     return storage->driver->read_ptr(storage, buf, len);
 }
 
+/**
+ * @brief Read a chunk of the currently installed payload
+ *
+ * @note Optional to implement
+ *
+ * @param[in]   storage     Storage context
+ * @param[out]  buf         Buffer to write the read data in
+ * @param[in]   offset      Offset to read from
+ * @param[in]   len         Number of bytes to read
+ *
+ * @returns     @ref SUIT_OK on successfully reading the chunk
+ * @returns     @ref suit_error_t on error
+ */
+static inline int suit_storage_read_installed(suit_storage_t *storage,
+                                              uint8_t *buf, size_t offset,
+                                              size_t len)
+{
+    return storage->driver->read_installed(storage, buf, offset, len);
+}
+
+/**
+ * @brief Retrieve the SHA-256 digest of the payload, computed while it was
+ *        written
+ *
+ * @note Optional to implement
+ *
+ * @param[in]   storage     Storage context
+ * @param[out]  digest      Buffer of SHA256_DIGEST_LENGTH bytes for the
+ *                          digest
+ * @param[out]  len         Number of payload bytes covered by the digest
+ *
+ * @returns     @ref SUIT_OK on successfully providing the digest
+ * @returns     @ref suit_error_t on error
+ */
+static inline int suit_storage_get_digest(suit_storage_t *storage,
+                                          uint8_t *digest, size_t *len)
+{
+    return storage->driver->get_digest(storage, digest, len);
+}
+
+/**
+ * @brief Prepare the storage for upcoming writes
+ *
+ * Does nothing if the backend does not implement
+ * @ref suit_storage_driver_t::prepare.
+ *
+ * @param[in]   storage     Storage context
+ *
+ * @returns     1 if some work was done and more may be left
+ * @returns     0 if there is nothing left to prepare
+ * @returns     @ref suit_error_t on error
+ */
+static inline int suit_storage_prepare(suit_storage_t *storage)
+{
+    return storage->driver->prepare ? storage->driver->prepare(storage) : 0;
+}
+
 /**
  * @brief Install the payload or mark the payload as valid
  *
@@ -22,17 +22,34 @@
 
 #include "suit.h"
 #include "riotboot/flashwrite.h"
+#include "hashes/sha256.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Compute the SHA-256 digest of the image while it is written
+ *
+ * The image digest is then verified without reading the image back from
+ * flash. This saves reading and hashing the whole slot after the download,
+ * but write errors that are not reported by the flash driver go unnoticed
+ * until the image is booted.
+ */
+#ifndef CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST
+#define CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST    0
+#endif
+
 /**
  * @brief riotboot flashwrite SUIT storage context
  */
 typedef struct {
     suit_storage_t storage;       /**< parent struct */
     riotboot_flashwrite_t writer; /**< Riotboot flashwriter */
+#if CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST || DOXYGEN
+    sha256_context_t sha256;      /**< Digest of the image written so far */
+    size_t digest_len;            /**< Number of bytes hashed */
+#endif
 } suit_storage_flashwrite_t;
 
 #ifdef __cplusplus
@@ -21,17 +21,40 @@
  *
  * Both the array of payloads named `payloads` and the size with name
  * `num_payloads` must be provided.
+ *
+ * Payloads are handed out in blocks of
+ * @ref CONFIG_SUIT_TRANSPORT_MOCK_BLOCKSIZE bytes, like a blockwise transfer
+ * would. A round trip time per block can be simulated with
+ * @ref CONFIG_SUIT_TRANSPORT_MOCK_DELAY_US to measure the end-to-end update
+ * time of a transport on `native`.
  */
 
 #ifndef SUIT_TRANSPORT_MOCK_H
 #define SUIT_TRANSPORT_MOCK_H
 
+#include "net/nanocoap.h"
 #include "suit.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Size of the blocks a payload is handed out in
+ */
+#ifndef CONFIG_SUIT_TRANSPORT_MOCK_BLOCKSIZE
+#define CONFIG_SUIT_TRANSPORT_MOCK_BLOCKSIZE    64
+#endif
+
+/**
+ * @brief Simulated delay in microseconds before each block is available
+ *
+ * Requires the `ztimer_usec` module if not 0.
+ */
+#ifndef CONFIG_SUIT_TRANSPORT_MOCK_DELAY_US
+#define CONFIG_SUIT_TRANSPORT_MOCK_DELAY_US     0
+#endif
+
 /**
  * @brief Mock payload.
  */
@@ -47,11 +70,14 @@ typedef struct {
  * suit_manifest_t::component_current member
  *
  * @param[in]   manifest    suit manifest context
+ * @param[in]   cb          callback function to handle the payload blocks
+ * @param[in]   ctx         callback context
  *
  * @returns     SUIT_OK if valid
  * @returns     negative otherwise
  */
-int suit_transport_mock_fetch(const suit_manifest_t *manifest);
+int suit_transport_mock_fetch(const suit_manifest_t *manifest,
+                              coap_blockwise_cb_t cb, void *ctx);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,126 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_suit
+ * @defgroup    sys_suit_transport_pipeline SUIT pipelined payload writes
+ * @brief       Overlaps downloading a SUIT payload with writing it to storage
+ *
+ * Without this module, every payload chunk received by a transport is written
+ * to the storage backend before the next chunk is requested. Download
+ * round trips and flash write and erase times thus add up.
+ *
+ * With `USEMODULE += suit_transport_pipeline`, received chunks are copied to
+ * one of @ref CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS buffers and written by a
+ * separate writer thread, while the transport already requests the next
+ * chunk. Whenever the writer thread has no chunk to write, it calls
+ * @ref suit_storage_prepare() to let the backend prepare upcoming writes,
+ * e.g. erase flash pages ahead of the write position.
+ *
+ * The writer thread runs at a lower priority than the SUIT worker, so that
+ * handling of the download always takes precedence.
+ *
+ * Combined with @ref CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST, the
+ * image digest is computed in the writer thread as well, so that no pass over
+ * the image is left after the download.
+ *
+ * @{
+ *
+ * @brief       SUIT pipelined payload write API
+ */
+
+#ifndef SUIT_TRANSPORT_PIPELINE_H
+#define SUIT_TRANSPORT_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "suit.h"
+#include "suit/storage.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of chunk buffers
+ */
+#ifndef CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS
+#define CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS      2
+#endif
+
+/**
+ * @brief Size of a chunk buffer in bytes
+ *
+ * Received chunks that are larger than a buffer are split over several
+ * buffers.
+ */
+#ifndef CONFIG_SUIT_TRANSPORT_PIPELINE_BUFSIZE
+#define CONFIG_SUIT_TRANSPORT_PIPELINE_BUFSIZE      256
+#endif
+
+/**
+ * @brief Stack size of the writer thread
+ */
+#ifndef SUIT_TRANSPORT_PIPELINE_STACKSIZE
+#define SUIT_TRANSPORT_PIPELINE_STACKSIZE           THREAD_STACKSIZE_DEFAULT
+#endif
+
+/**
+ * @brief Priority of the writer thread
+ */
+#ifndef SUIT_TRANSPORT_PIPELINE_PRIO
+#define SUIT_TRANSPORT_PIPELINE_PRIO                THREAD_PRIORITY_MAIN
+#endif
+
+/**
+ * @brief Start a pipelined payload write sequence
+ *
+ * Must be called after @ref suit_storage_start(). The writer thread is
+ * created on first use.
+ *
+ * @param[in]   storage     Storage backend to write to
+ * @param[in]   manifest    The suit manifest context
+ *
+ * @returns     0 on success
+ * @returns     <0 if the writer thread could not be created
+ */
+int suit_transport_pipeline_start(suit_storage_t *storage,
+                                  const suit_manifest_t *manifest);
+
+/**
+ * @brief Queue a payload chunk for writing
+ *
+ * The chunk is copied, @p buf can be reused as soon as the function returns.
+ * Blocks while all buffers are in use.
+ *
+ * @param[in]   buf         Payload chunk
+ * @param[in]   offset      Offset of the chunk in the payload
+ * @param[in]   len         Length of the chunk
+ *
+ * @returns     @ref SUIT_OK on success
+ * @returns     @ref suit_error_t of a previous failed write
+ */
+int suit_transport_pipeline_write(const uint8_t *buf, size_t offset,
+                                  size_t len);
+
+/**
+ * @brief Wait until all queued chunks are written
+ *
+ * Must be called before @ref suit_storage_finish().
+ *
+ * @returns     @ref SUIT_OK if all chunks were written successfully
+ * @returns     @ref suit_error_t of the first failed write
+ */
+int suit_transport_pipeline_finish(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUIT_TRANSPORT_PIPELINE_H */
+/** @} */
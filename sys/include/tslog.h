@@ -0,0 +1,219 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_tslog Time-series log
+ * @ingroup     sys
+ * @brief       Append-only circular record store for time-stamped samples
+ *              on raw MTD devices
+ *
+ * This module stores time-stamped records, e.g. sensor samples, directly
+ * on the sectors of an MTD device. A general purpose file system has to
+ * commit metadata for every write; this log has no metadata besides a small
+ * header at the start of every sector. Appending a record is a single write
+ * to the device, plus the erase of the next sector whenever a sector is full.
+ *
+ * The sectors are used as a ring buffer: once all sectors are in use, the
+ * sector holding the oldest records is erased and reused. Since sectors are
+ * always written in the same order, all sectors are erased equally often.
+ *
+ * Each sector header holds the time stamp of the first record in the sector.
+ * These headers are used as an index for range queries: the sector a query
+ * starts at is found by a binary search, only records in that sector are
+ * scanned linearly.
+ *
+ * Each record is protected by a CRC-16. Records that fail the check are
+ * skipped together with the rest of their sector, e.g. after a power failure
+ * during a write. After such a failure, new records are written to the next
+ * sector.
+ *
+ * Time stamps are opaque 32 bit values chosen by the application (e.g.
+ * seconds since boot or since the epoch), but must not decrease.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += tslog
+ * ```
+ *
+ * ```
+ * static tslog_t log;
+ *
+ * tslog_init(&log, MTD_0);
+ * tslog_append(&log, ztimer_now(ZTIMER_SEC), &sample, sizeof(sample));
+ *
+ * tslog_iter_t it;
+ * uint32_t ts;
+ * tslog_iter_init(&log, &it, from, to);
+ * while (tslog_iter_next(&it, &ts, &sample, sizeof(sample)) > 0) {
+ *     ...
+ * }
+ * ```
+ *
+ * The log uses the whole MTD device, use @ref drivers_mtd_mapper to place it
+ * on a part of a device.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Time-series log interface
+ */
+
+#ifndef TSLOG_H
+#define TSLOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_tslog_config Time-series log compile configurations
+ * @ingroup config
+ * @{
+ */
+/**
+ * @brief   Largest supported write size of the MTD device in bytes
+ *
+ * Determines the size of a buffer on the stack used to pad records to the
+ * write size of the device.
+ */
+#ifndef CONFIG_TSLOG_WRITE_SIZE_MAX
+#define CONFIG_TSLOG_WRITE_SIZE_MAX     (16)
+#endif
+/** @} */
+
+/**
+ * @brief   Magic number of a sector header ("TSLG")
+ */
+#define TSLOG_MAGIC                     (0x474c5354UL)
+
+/**
+ * @brief   Time-series log descriptor
+ *
+ * The contents are private to the implementation.
+ */
+typedef struct {
+    mtd_dev_t *dev;         /**< MTD device holding the log */
+    mutex_t lock;           /**< lock for concurrent access */
+    uint32_t head;          /**< sequence number of the sector written to */
+    uint32_t tail;          /**< sequence number of the oldest sector */
+    uint32_t offset;        /**< write offset within the head sector */
+    uint32_t last_ts;       /**< time stamp of the newest record */
+    bool empty;             /**< true if the log contains no sectors */
+} tslog_t;
+
+/**
+ * @brief   Iterator over the records of a time range
+ */
+typedef struct {
+    tslog_t *log;           /**< log iterated over */
+    uint32_t seq;           /**< sequence number of the current sector */
+    uint32_t offset;        /**< offset of the next record in the sector */
+    uint32_t from;          /**< first time stamp of the range */
+    uint32_t to;            /**< last time stamp of the range */
+} tslog_iter_t;
+
+/**
+ * @brief   Initialize a log and recover its state from the device
+ *
+ * The device is initialized and scanned for existing records; new records
+ * are appended after them. Sectors without a valid sector header are
+ * treated as free.
+ *
+ * @param[out]  log     log descriptor
+ * @param[in]   dev     MTD device holding the log
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP if the write size of @p dev exceeds
+ *          @ref CONFIG_TSLOG_WRITE_SIZE_MAX
+ * @return  <0 on other errors
+ */
+int tslog_init(tslog_t *log, mtd_dev_t *dev);
+
+/**
+ * @brief   Remove all records from the log
+ *
+ * All sectors of the device are erased.
+ *
+ * @param[in]   log     log descriptor
+ *
+ * @return  0 on success
+ * @return  <0 on error
+ */
+int tslog_erase(tslog_t *log);
+
+/**
+ * @brief   Append a record to the log
+ *
+ * @param[in]   log     log descriptor
+ * @param[in]   ts      time stamp of the record, not smaller than the time
+ *                      stamp of the previous record
+ * @param[in]   data    record payload
+ * @param[in]   len     size of @p data, must not be 0
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p len is 0 or @p ts is smaller than the time stamp of
+ *          the last record
+ * @return  -EFBIG if the record does not fit into a sector
+ * @return  <0 on other errors
+ */
+int tslog_append(tslog_t *log, uint32_t ts, const void *data, size_t len);
+
+/**
+ * @brief   Get the maximum payload size of a record
+ *
+ * @param[in]   log     log descriptor
+ *
+ * @return  maximum value for the @p len parameter of @ref tslog_append
+ */
+size_t tslog_record_size_max(const tslog_t *log);
+
+/**
+ * @brief   Prepare iterating over the records of a time range
+ *
+ * @param[in]   log     log descriptor
+ * @param[out]  it      iterator
+ * @param[in]   from    first time stamp of the range
+ * @param[in]   to      last time stamp of the range
+ *
+ * @return  0 on success
+ * @return  <0 on error
+ */
+int tslog_iter_init(tslog_t *log, tslog_iter_t *it, uint32_t from, uint32_t to);
+
+/**
+ * @brief   Read the next record of the time range, oldest first
+ *
+ * Records appended after the iterator was initialized are returned as well
+ * if they are within the time range. Records that are overwritten while
+ * iterating are skipped.
+ *
+ * @param[in]   it      iterator
+ * @param[out]  ts      time stamp of the record, may be NULL
+ * @param[out]  buf     buffer for the record payload
+ * @param[in]   len     size of @p buf
+ *
+ * @return  size of the payload of the record
+ * @return  0 if there are no more records in the time range
+ * @return  -ENOBUFS if the payload does not fit in @p buf, the record is
+ *          skipped
+ * @return  <0 on other errors
+ */
+int tslog_iter_next(tslog_iter_t *it, uint32_t *ts, void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TSLOG_H */
+/** @} */
@@ -272,6 +272,41 @@ extern "C" {
 #define VFS_NAME_MAX (31)
 #endif
 
+/**
+ * @defgroup sys_vfs_readahead_config VFS read-ahead configuration
+ * @ingroup config
+ * @brief Configuration of the @ref pseudomodule_vfs_readahead module
+ *
+ * Once more than one small read (smaller than the read-ahead size) is done on
+ * a file without a write or seek in between, a read-ahead buffer is assigned
+ * to the file. Subsequent small reads are served from that buffer, which is
+ * refilled by a single read of the file system driver. Writing to or seeking
+ * in the file discards the buffer. Read-ahead is only used for file systems
+ * that implement vfs_file_ops::lseek.
+ * @{
+ */
+#ifndef CONFIG_VFS_READAHEAD_SIZE
+/**
+ * @brief Maximum size of a read-ahead buffer in bytes
+ *
+ * Mount points can use a smaller size by setting vfs_mount_t::readahead.
+ */
+#define CONFIG_VFS_READAHEAD_SIZE (256)
+#endif
+
+#ifndef CONFIG_VFS_READAHEAD_NUMOF
+/**
+ * @brief Number of read-ahead buffers shared by all open files
+ */
+#define CONFIG_VFS_READAHEAD_NUMOF (2)
+#endif
+/** @} */
+
+/**
+ * @brief Value of vfs_mount_t::readahead to disable read-ahead for a mount
+ */
+#define VFS_READAHEAD_OFF (UINT16_MAX)
+
 /**
  * @brief Used with vfs_bind to bind to any available fd number
  */
@@ -359,6 +394,15 @@ struct vfs_mount_struct {
     size_t mount_point_len;      /**< Length of mount_point string (set by vfs_mount) */
     atomic_int open_files;       /**< Number of currently open files and directories */
     void *private_data;          /**< File system driver private data, implementation defined */
+#if defined(MODULE_VFS_READAHEAD) || DOXYGEN
+    /**
+     * @brief Read-ahead size in bytes for files of this mount point
+     *
+     * 0 selects @ref CONFIG_VFS_READAHEAD_SIZE, larger values are limited to
+     * it, @ref VFS_READAHEAD_OFF disables read-ahead.
+     */
+    uint16_t readahead;
+#endif
 };
 
 /**
@@ -530,6 +574,55 @@ struct vfs_file_ops {
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
 
+    /**
+     * @brief Read bytes from an open file into the buffers of an iolist
+     *
+     * The buffers are filled in order. Reading stops early at the end of the
+     * file. Drivers that do not implement this are served by consecutive
+     * calls of @ref vfs_file_ops::read.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  iolist   buffers to read into
+     *
+     * @return number of bytes read on success
+     * @return <0 on error
+     */
+    ssize_t (*readv) (vfs_file_t *filp, const iolist_t *iolist);
+
+    /**
+     * @brief Write the buffers of an iolist to an open file
+     *
+     * Drivers that do not implement this are served by consecutive calls of
+     * @ref vfs_file_ops::write.
+     *
+     * Writing stops at the first buffer that is not written completely. An
+     * error after some bytes were written is not reported, the call returns
+     * the number of bytes written so far instead.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[in]  iolist   buffers to write
+     *
+     * @return number of bytes written on success, less than the total length
+     *         of @p iolist if the volume is full
+     * @return <0 on error
+     */
+    ssize_t (*writev) (vfs_file_t *filp, const iolist_t *iolist);
+
+    /**
+     * @brief Get direct access to the content of an open file
+     *
+     * Only file systems that store a file contiguously in memory mapped
+     * storage (e.g. internal flash) can implement this.
+     *
+     * @param[in]  filp     pointer to open file
+     * @param[out] addr     start of the file content
+     * @param[out] len      length of the file content
+     *
+     * @return 0 on success
+     * @return <0 on error
+     */
+    int (*mmap) (vfs_file_t *filp, const void **addr, size_t *len);
+
     /**
      * @brief Synchronize a file on storage
      *        Any pending writes are written out to storage.
@@ -823,6 +916,40 @@ int vfs_open(const char *name, int flags, mode_t mode);
  */
 ssize_t vfs_read(int fd, void *dest, size_t count);
 
+/**
+ * @brief Read bytes from an open file into the buffers of an iolist
+ *
+ * The buffers are filled in order, as a single operation of the file system
+ * driver if it supports vectored reads.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[in]  iolist   buffers to read into
+ *
+ * @return number of bytes read on success, less than the total length of
+ *         @p iolist at the end of the file
+ * @return <0 on error
+ */
+ssize_t vfs_read_iol(int fd, const iolist_t *iolist);
+
+/**
+ * @brief Get direct read access to the content of an open file
+ *
+ * For files stored contiguously in memory mapped storage, e.g. in a
+ * @ref sys_fs_constfs or @ref sys_fs_romfs, this provides the file content
+ * in place without copying it to RAM. The pointer stays valid until the
+ * file system is unmounted, even after the file is closed. The content must
+ * not be written through it.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ * @param[out] addr     start of the file content
+ * @param[out] len      length of the file content
+ *
+ * @return 0 on success
+ * @return -ENOTSUP if the file system does not support direct access
+ * @return <0 on other errors
+ */
+int vfs_mmap(int fd, const void **addr, size_t *len);
+
 /**
  * @brief Write bytes to an open file
  *
@@ -841,10 +968,17 @@ ssize_t vfs_write(int fd, const void *src, size_t count);
 /**
  * @brief Write bytes from an iolist to an open file
  *
+ * The buffers are written as a single operation of the file system driver if
+ * it supports vectored writes.
+ *
+ * Writing stops at the first buffer that is not written completely, and
+ * an error after some bytes were written returns the number of these bytes.
+ *
  * @param[in]  fd       fd number obtained from vfs_open
  * @param[in]  iolist   iolist to read from
  *
- * @return number of bytes written on success
+ * @return number of bytes written on success, less than the total length of
+ *         @p iolist if the volume is full
  * @return <0 on error
  */
 ssize_t vfs_write_iol(int fd, const iolist_t *iolist);
@@ -11,11 +11,19 @@
  * @{
  * @file
  * @brief   DNS cache implementation
+ *
+ * Names are kept in an open addressed hash table with linear probing.
+ * Every name can hold one A and one AAAA record, each with its own
+ * expiry time. All valid records are additionally kept in a binary
+ * min-heap ordered by expiry time, so expired records can be removed
+ * and the first record to expire can be found without scanning the table.
+ *
  * @author  Benjamin Valentin <benjamin.valentin@ml-pa.com>
  * @}
  */
 
-#include "bitfield.h"
+#include <assert.h>
+
 #include "checksum/fletcher32.h"
 #include "mutex.h"
 #include "net/af.h"
@@ -28,94 +36,292 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+/**
+ * @brief   Number of record types stored per name
+ */
+#define DNS_CACHE_FAMILIES  (IS_ACTIVE(CONFIG_DNS_CACHE_A) + IS_ACTIVE(CONFIG_DNS_CACHE_AAAA))
+
+/**
+ * @brief   Index of the AAAA record of a name
+ */
+#define FAM_V6              (DNS_CACHE_FAMILIES - 1)
+
+/**
+ * @brief   Index of the A record of a name
+ */
+#define FAM_V4              (0)
+
+/**
+ * @brief   Total number of records in the cache
+ */
+#define DNS_CACHE_RECORDS   (CONFIG_DNS_CACHE_SIZE * DNS_CACHE_FAMILIES)
+
+/**
+ * @brief   Marks a record that is not in the expiry heap (= unused)
+ */
+#define HEAP_NONE           (UINT16_MAX)
+
+static_assert(DNS_CACHE_RECORDS < HEAP_NONE, "CONFIG_DNS_CACHE_SIZE too large");
+
 static struct dns_cache_entry {
-    uint32_t hash;
-    uint32_t expires;
-    union {
+    uint32_t hash;                              /**< hash of the name, 0 if unused */
 #if IS_ACTIVE(CONFIG_DNS_CACHE_A)
-        ipv4_addr_t v4;
+    ipv4_addr_t v4;                             /**< A record                      */
 #endif
 #if IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
-        ipv6_addr_t v6;
+    ipv6_addr_t v6;                             /**< AAAA record                   */
 #endif
-    } addr;
+    uint32_t expires[DNS_CACHE_FAMILIES];       /**< expiry time of each record    */
+    uint16_t heap_pos[DNS_CACHE_FAMILIES];      /**< position in the expiry heap   */
 } cache[CONFIG_DNS_CACHE_SIZE];
-static mutex_t cache_mutex = MUTEX_INIT;
 
-#if IS_ACTIVE(CONFIG_DNS_CACHE_A) && IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
-BITFIELD(cache_is_v6, CONFIG_DNS_CACHE_SIZE);
+/* record IDs (slot * DNS_CACHE_FAMILIES + family index), ordered by expiry */
+static uint16_t heap[DNS_CACHE_RECORDS];
+static uint16_t heap_len;
+static uint16_t used;
+static mutex_t cache_mutex = MUTEX_INIT;
 
-static inline uint8_t _get_len(unsigned idx)
+static uint8_t _addr_len(int family)
 {
-    return bf_isset(cache_is_v6, idx) ? 16 : 4;
+    switch (family) {
+#if IS_ACTIVE(CONFIG_DNS_CACHE_A)
+    case AF_INET:
+        return sizeof(ipv4_addr_t);
+#endif
+#if IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
+   case AF_INET6:
+        return sizeof(ipv6_addr_t);
+#endif
+    case AF_UNSPEC:
+        return 0;
+    default:
+        return 255;
+    }
 }
-#elif IS_ACTIVE(CONFIG_DNS_CACHE_A)
-static inline uint8_t _get_len(unsigned idx)
+
+static void *_rec_addr(unsigned idx, unsigned fam)
 {
+#if IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
+    if (fam == FAM_V6) {
+        return &cache[idx].v6;
+    }
+#endif
+#if IS_ACTIVE(CONFIG_DNS_CACHE_A)
+    return &cache[idx].v4;
+#else
     (void)idx;
-    return 4;
+    return NULL;
+#endif
 }
-#elif IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
-static inline uint8_t _get_len(unsigned idx)
+
+static uint8_t _rec_len(unsigned fam)
 {
-    (void)idx;
-    return 16;
+    if (IS_ACTIVE(CONFIG_DNS_CACHE_AAAA) && fam == FAM_V6) {
+        return sizeof(ipv6_addr_t);
+    }
+    return sizeof(ipv4_addr_t);
 }
-#endif
 
-static void _set_len(unsigned idx, uint8_t len)
+static int _rec_fam(uint8_t addr_len)
 {
-#if IS_ACTIVE(CONFIG_DNS_CACHE_A) && IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
-    if (len == 16) {
-        bf_set(cache_is_v6, idx);
-    } else {
-        bf_unset(cache_is_v6, idx);
+    if (IS_ACTIVE(CONFIG_DNS_CACHE_AAAA) && addr_len == sizeof(ipv6_addr_t)) {
+        return FAM_V6;
     }
-#else
-    (void)idx;
-    (void)len;
-#endif
+    if (IS_ACTIVE(CONFIG_DNS_CACHE_A) && addr_len == sizeof(ipv4_addr_t)) {
+        return FAM_V4;
+    }
+    return -1;
+}
+
+static inline bool _rec_valid(unsigned idx, unsigned fam)
+{
+    return cache[idx].heap_pos[fam] != HEAP_NONE;
 }
 
-static bool _is_empty(unsigned idx)
+static inline uint32_t _expires(uint16_t rec)
 {
-    const uint8_t len = _get_len(idx);
-    const uint8_t *addr = (void *)&cache[idx].addr;
-    for (unsigned i = 0; i < len; ++i) {
-        if (addr[i]) {
-            return false;
+    return cache[rec / DNS_CACHE_FAMILIES].expires[rec % DNS_CACHE_FAMILIES];
+}
+
+static inline uint16_t *_heap_pos(uint16_t rec)
+{
+    return &cache[rec / DNS_CACHE_FAMILIES].heap_pos[rec % DNS_CACHE_FAMILIES];
+}
+
+static inline void _heap_set(unsigned pos, uint16_t rec)
+{
+    heap[pos] = rec;
+    *_heap_pos(rec) = pos;
+}
+
+static void _heap_sift_up(unsigned pos)
+{
+    uint16_t rec = heap[pos];
+
+    while (pos) {
+        unsigned parent = (pos - 1) / 2;
+        if (_expires(heap[parent]) <= _expires(rec)) {
+            break;
         }
+        _heap_set(pos, heap[parent]);
+        pos = parent;
     }
+    _heap_set(pos, rec);
+}
 
-    return true;
+static void _heap_sift_down(unsigned pos)
+{
+    uint16_t rec = heap[pos];
+
+    while (1) {
+        unsigned child = 2 * pos + 1;
+        if (child >= heap_len) {
+            break;
+        }
+        if (child + 1 < heap_len && _expires(heap[child + 1]) < _expires(heap[child])) {
+            ++child;
+        }
+        if (_expires(rec) <= _expires(heap[child])) {
+            break;
+        }
+        _heap_set(pos, heap[child]);
+        pos = child;
+    }
+    _heap_set(pos, rec);
 }
 
-static void _set_empty(unsigned idx)
+static void _heap_update(unsigned pos)
 {
-    memset(&cache[idx].addr, 0, _get_len(idx));
+    uint16_t rec = heap[pos];
+
+    _heap_sift_up(pos);
+    _heap_sift_down(*_heap_pos(rec));
 }
 
-static uint8_t _addr_len(int family)
+static void _heap_remove(unsigned pos)
 {
-    switch (family) {
-#if IS_ACTIVE(CONFIG_DNS_CACHE_A)
-    case AF_INET:
-        return sizeof(ipv4_addr_t);
-#endif
-#if IS_ACTIVE(CONFIG_DNS_CACHE_AAAA)
-   case AF_INET6:
-        return sizeof(ipv6_addr_t);
-#endif
-    case AF_UNSPEC:
-        return 0;
-    default:
-        return 255;
+    *_heap_pos(heap[pos]) = HEAP_NONE;
+    if (pos == --heap_len) {
+        return;
+    }
+
+    _heap_set(pos, heap[heap_len]);
+    _heap_update(pos);
+}
+
+static inline unsigned _home(uint32_t hash)
+{
+    return hash % CONFIG_DNS_CACHE_SIZE;
+}
+
+static inline unsigned _next(unsigned idx)
+{
+    return (idx + 1 == CONFIG_DNS_CACHE_SIZE) ? 0 : idx + 1;
+}
+
+static int _find(uint32_t hash)
+{
+    unsigned idx = _home(hash);
+
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; ++i) {
+        if (cache[idx].hash == hash) {
+            return idx;
+        }
+        if (cache[idx].hash == 0) {
+            break;
+        }
+        idx = _next(idx);
+    }
+
+    return -1;
+}
+
+static void _move_slot(unsigned dst, unsigned src)
+{
+    cache[dst] = cache[src];
+    for (unsigned fam = 0; fam < DNS_CACHE_FAMILIES; ++fam) {
+        if (_rec_valid(dst, fam)) {
+            heap[cache[dst].heap_pos[fam]] = dst * DNS_CACHE_FAMILIES + fam;
+        }
+    }
+}
+
+/* backward shift deletion, keeps probe sequences intact without tombstones */
+static void _remove_slot(unsigned idx)
+{
+    unsigned next = idx;
+
+    DEBUG("dns_cache[%u] remove name\n", idx);
+
+    cache[idx].hash = 0;
+    --used;
+
+    while (1) {
+        next = _next(next);
+        if (cache[next].hash == 0) {
+            break;
+        }
+
+        /* entry may be moved into the gap if its home slot
+         * is not cyclically in (idx, next] */
+        unsigned home = _home(cache[next].hash);
+        bool in_range = (idx <= next) ? (idx < home && home <= next)
+                                      : (idx < home || home <= next);
+        if (!in_range) {
+            _move_slot(idx, next);
+            cache[next].hash = 0;
+            idx = next;
+        }
+    }
+}
+
+static void _remove_record(unsigned idx, unsigned fam)
+{
+    DEBUG("dns_cache[%u] remove record %u\n", idx, fam);
+
+    _heap_remove(cache[idx].heap_pos[fam]);
+
+    for (unsigned i = 0; i < DNS_CACHE_FAMILIES; ++i) {
+        if (_rec_valid(idx, i)) {
+            return;
+        }
+    }
+
+    _remove_slot(idx);
+}
+
+static void _remove_first(void)
+{
+    uint16_t rec = heap[0];
+    _remove_record(rec / DNS_CACHE_FAMILIES, rec % DNS_CACHE_FAMILIES);
+}
+
+static void _expire(uint32_t now)
+{
+    while (heap_len && now > _expires(heap[0])) {
+        DEBUG("dns_cache: record %u expired\n", heap[0]);
+        _remove_first();
     }
 }
 
 static uint32_t _hash(const void *data, size_t len)
 {
-    return fletcher32(data, (len + 1) / 2);
+    uint32_t hash = fletcher32(data, (len + 1) / 2);
+
+    /* 0 marks an empty slot */
+    return hash ? hash : 1;
+}
+
+static bool _query_record(int idx, int fam, void *addr_out, int *res)
+{
+    if (fam < 0 || !_rec_valid(idx, fam)) {
+        return false;
+    }
+
+    DEBUG("dns_cache[%u] hit\n", idx);
+    *res = _rec_len(fam);
+    memcpy(addr_out, _rec_addr(idx, fam), *res);
+    return true;
 }
 
 int dns_cache_query(const char *domain_name, void *addr_out, int family)
@@ -126,25 +332,25 @@ int dns_cache_query(const char *domain_name, void *addr_out, int family)
     uint8_t addr_len = _addr_len(family);
 
     mutex_lock(&cache_mutex);
-    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; ++i) {
-        /* empty slot */
-        if (_is_empty(i)) {
-            continue;
-        }
-        /* TTL expired - invalidate slot */
-        if (now > cache[i].expires) {
-            DEBUG("dns_cache[%u] expired\n", i);
-            _set_empty(i);
-            continue;
-        }
-        /* check if hash and length match */
-        if (cache[i].hash == hash && (!addr_len || addr_len == _get_len(i))) {
-            DEBUG("dns_cache[%u] hit\n", i);
-            memcpy(addr_out, &cache[i].addr, _get_len(i));
-            res = _get_len(i);
-            break;
+    _expire(now);
+
+    int idx = _find(hash);
+    if (idx < 0) {
+        goto exit;
+    }
+
+    if (addr_len) {
+        _query_record(idx, _rec_fam(addr_len), addr_out, &res);
+    }
+    else {
+        for (int fam = DNS_CACHE_FAMILIES - 1; fam >= 0; --fam) {
+            if (_query_record(idx, fam, addr_out, &res)) {
+                break;
+            }
         }
     }
+
+exit:
     if (res == 0) {
         DEBUG("dns_cache miss\n");
     }
@@ -152,14 +358,32 @@ int dns_cache_query(const char *domain_name, void *addr_out, int family)
     return res;
 }
 
-static void _add_entry(uint8_t i, uint32_t hash, const void *addr_out,
-                       int addr_len, uint32_t expires)
+static int _add_slot(uint32_t hash, uint32_t expires)
 {
-    DEBUG("dns_cache[%u] add cache entry\n", i);
-    cache[i].hash = hash;
-    cache[i].expires = expires;
-    memcpy(&cache[i].addr, addr_out, addr_len);
-    _set_len(i, addr_len);
+    /* make room by evicting the records that expire first, but only those
+     * that expire before the new record would */
+    while (used == CONFIG_DNS_CACHE_SIZE) {
+        if (_expires(heap[0]) >= expires) {
+            DEBUG("dns_cache: all entries outlive the new one\n");
+            return -1;
+        }
+        DEBUG("dns_cache: evict first entry to expire\n");
+        _remove_first();
+    }
+
+    unsigned idx = _home(hash);
+    while (cache[idx].hash) {
+        idx = _next(idx);
+    }
+
+    DEBUG("dns_cache[%u] add name\n", idx);
+    cache[idx].hash = hash;
+    for (unsigned fam = 0; fam < DNS_CACHE_FAMILIES; ++fam) {
+        cache[idx].heap_pos[fam] = HEAP_NONE;
+    }
+    ++used;
+
+    return idx;
 }
 
 void dns_cache_add(const char *domain_name, const void *addr_out,
@@ -167,41 +391,46 @@ void dns_cache_add(const char *domain_name, const void *addr_out,
 {
     uint32_t now = ztimer_now(ZTIMER_MSEC) / MS_PER_SEC;
     uint32_t hash = _hash(domain_name, strlen(domain_name));
-    uint32_t oldest = ttl;
-    int idx = -1;
+    int fam = _rec_fam(addr_len);
 
     assert(addr_len == 4 || addr_len == 16);
     DEBUG("dns_cache: lifetime of %s is %"PRIu32" s\n", domain_name, ttl);
 
+    if (fam < 0) {
+        return;
+    }
+
     mutex_lock(&cache_mutex);
-    /* iterate even if TTL = 0 just in case we need to expire */
-    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; ++i) {
-        if (ttl && (now > cache[i].expires || _is_empty(i))) {
-            _add_entry(i, hash, addr_out, addr_len, now + ttl);
-            goto exit;
+    _expire(now);
+
+    int idx = _find(hash);
+    if (ttl == 0) {
+        /* remove the record immediately */
+        if (idx >= 0 && _rec_valid(idx, fam)) {
+            _remove_record(idx, fam);
         }
-        if (cache[i].hash == hash && _get_len(i) == addr_len) {
-            DEBUG("dns_cache[%u] update ttl\n", i);
-            if (ttl) {
-                cache[i].expires = now + ttl;
-            }
-            else {
-                /* put one second into past so that it is immediately expired */
-                cache[i].expires = now - 1;
-            }
+        goto exit;
+    }
+
+    if (idx < 0) {
+        idx = _add_slot(hash, now + ttl);
+        if (idx < 0) {
             goto exit;
         }
-        uint32_t _ttl = cache[i].expires - now;
-        if (_ttl < oldest) {
-            oldest = _ttl;
-            idx = i;
-        }
     }
 
-    if (ttl && idx >= 0) {
-        DEBUG("dns_cache: evict first entry to expire\n");
-        _add_entry(idx, hash, addr_out, addr_len, now + ttl);
+    DEBUG("dns_cache[%u] set record %d\n", idx, fam);
+    memcpy(_rec_addr(idx, fam), addr_out, addr_len);
+    cache[idx].expires[fam] = now + ttl;
+
+    if (_rec_valid(idx, fam)) {
+        _heap_update(cache[idx].heap_pos[fam]);
     }
+    else {
+        heap[heap_len] = idx * DNS_CACHE_FAMILIES + fam;
+        _heap_sift_up(heap_len++);
+    }
+
 exit:
     mutex_unlock(&cache_mutex);
 }
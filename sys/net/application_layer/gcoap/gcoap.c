@@ -280,6 +280,8 @@ static void _on_sock_dtls_evt(sock_dtls_t *sock, sock_async_flags_t type, void *
             DEBUG("gcoap: DTLS recv failure: %d\n", (int)res);
             return;
         }
+        /* keep active sessions from being freed up */
+        dsm_touch(sock, &socket.ctx_dtls_session);
         sock_udp_ep_t ep;
         sock_dtls_session_get_udp_ep(&socket.ctx_dtls_session, &ep);
         /* Truncated DTLS messages would already have gotten lost at verification */
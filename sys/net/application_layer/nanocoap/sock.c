@@ -26,10 +26,12 @@
 #include <stdio.h>
 
 #include "atomic_utils.h"
+#include "byteorder.h"
 #include "net/credman.h"
 #include "net/nanocoap_sock.h"
 #include "net/sock/util.h"
 #include "net/sock/udp.h"
+#include "macros/utils.h"
 #include "net/iana/portrange.h"
 #include "random.h"
 #include "sys/uio.h"
@@ -60,8 +62,50 @@ typedef struct {
     coap_blockwise_cb_t callback;
     void *arg;
     bool more;
+    uint8_t blksize;
 } _block_ctx_t;
 
+enum {
+    SLOT_FREE,              /**< slot not in use                              */
+    SLOT_PENDING,           /**< block requested, waiting for the response    */
+    SLOT_SEPARATE,          /**< empty ACK received, waiting for the response */
+    SLOT_DONE,              /**< block received out of order, buffered        */
+};
+
+/**
+ * @brief   Length of the token used for windowed blockwise requests
+ *
+ *          Two bytes of random transfer ID followed by the block number
+ */
+#define WINDOW_TOKEN_LEN    (6)
+
+typedef struct {
+    uint32_t num;           /**< block number requested in this slot   */
+    uint32_t deadline;      /**< deadline for the response [µs]        */
+    uint32_t timeout;       /**< current retransmission timeout [µs]   */
+    uint16_t id;            /**< message ID of the request             */
+    uint16_t len;           /**< length of the buffered block          */
+    uint8_t state;          /**< slot state                            */
+    uint8_t tries_left;     /**< retransmissions left                  */
+    bool more;              /**< more flag of the buffered block       */
+} _window_slot_t;
+
+typedef struct {
+    nanocoap_sock_t *sock;
+    const char *path;
+    coap_blockwise_cb_t callback;
+    void *arg;
+    uint8_t *buf;           /**< reorder buffer, one block per slot    */
+    uint32_t next_req;      /**< next block number to request          */
+    uint32_t next_cb;       /**< next block number to pass to callback */
+    uint32_t last;          /**< number of the last block, if known    */
+    int err;                /**< error response behind the last block  */
+    uint16_t xfer_id;       /**< random transfer ID used in the token  */
+    uint8_t szx;            /**< negotiated block size                 */
+    uint8_t window;         /**< number of slots in use                */
+    _window_slot_t slots[CONFIG_NANOCOAP_BLOCKWISE_WINDOW];
+} _window_ctx_t;
+
 int nanocoap_sock_dtls_connect(nanocoap_sock_t *sock, sock_udp_ep_t *local,
                                const sock_udp_ep_t *remote, credman_tag_t tag)
 {
@@ -562,9 +606,11 @@ static int _block_cb(void *arg, coap_pkt_t *pkt)
     if (!coap_get_block2(pkt, &block2)) {
         block2.offset = 0;
         block2.more = false;
+        block2.szx = ctx->blksize;
     }
 
     ctx->more = block2.more;
+    ctx->blksize = block2.szx;
     return ctx->callback(ctx->arg, block2.offset, pkt->payload, pkt->payload_len, block2.more);
 }
 
@@ -638,34 +684,380 @@ int nanocoap_sock_block_request(coap_block_request_t *req,
     return len;
 }
 
-int nanocoap_sock_get_blockwise(nanocoap_sock_t *sock, const char *path,
-                                coap_blksize_t blksize,
-                                coap_blockwise_cb_t callback, void *arg)
+static int _get_blockwise_seq(nanocoap_sock_t *sock, const char *path,
+                              coap_blksize_t blksize, unsigned num,
+                              _block_ctx_t *ctx)
 {
     uint8_t buf[CONFIG_NANOCOAP_BLOCK_HEADER_MAX];
 
-    _block_ctx_t ctx = {
+    while (ctx->more) {
+        DEBUG("fetching block %u\n", num);
+
+        int res = _fetch_block(sock, buf, sizeof(buf), path, blksize, num, ctx);
+        if (res < 0) {
+            DEBUG("error fetching block %u: %d\n", num, res);
+            return res;
+        }
+
+        num += 1;
+    }
+
+    return 0;
+}
+
+static void _window_token(const _window_ctx_t *ctx, uint32_t num, uint8_t *token)
+{
+    byteorder_htobebufs(&token[0], ctx->xfer_id);
+    byteorder_htobebufl(&token[2], num);
+}
+
+static int _window_request(_window_ctx_t *ctx, _window_slot_t *slot)
+{
+    uint8_t buf[CONFIG_NANOCOAP_BLOCK_HEADER_MAX];
+    uint8_t token[WINDOW_TOKEN_LEN];
+    uint8_t *pktpos = buf;
+    uint16_t lastonum = 0;
+
+    _window_token(ctx, slot->num, token);
+    pktpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, token, sizeof(token),
+                             COAP_METHOD_GET, slot->id);
+    pktpos += coap_opt_put_uri_pathquery(pktpos, &lastonum, ctx->path);
+    pktpos += coap_opt_put_uint(pktpos, lastonum, COAP_OPT_BLOCK2,
+                                (slot->num << 4) | ctx->szx);
+    assert((uintptr_t)pktpos - (uintptr_t)buf < sizeof(buf));
+
+    const iolist_t snip = {
+        .iol_base = buf,
+        .iol_len  = pktpos - buf,
+    };
+
+    DEBUG("nanocoap: request block %"PRIu32" (id %u)\n", slot->num, slot->id);
+
+    slot->deadline = _deadline_from_interval(slot->timeout);
+    slot->state = SLOT_PENDING;
+
+    int res = _sock_sendv(ctx->sock, &snip);
+    return res < 0 ? res : 0;
+}
+
+static int _window_request_new(_window_ctx_t *ctx, uint32_t num)
+{
+    _window_slot_t *slot = &ctx->slots[num % ctx->window];
+
+    slot->num = num;
+    slot->id = nanocoap_sock_next_msg_id(ctx->sock);
+    slot->tries_left = CONFIG_COAP_MAX_RETRANSMIT;
+    slot->timeout = random_uint32_range(CONFIG_COAP_ACK_TIMEOUT_MS * US_PER_MS,
+                                        CONFIG_COAP_ACK_TIMEOUT_MS * CONFIG_COAP_RANDOM_FACTOR_1000);
+
+    return _window_request(ctx, slot);
+}
+
+static _window_slot_t *_window_match(_window_ctx_t *ctx, const coap_pkt_t *pkt)
+{
+    uint8_t token[WINDOW_TOKEN_LEN];
+
+    for (unsigned i = 0; i < ctx->window; ++i) {
+        _window_slot_t *slot = &ctx->slots[i];
+
+        if (slot->state != SLOT_PENDING && slot->state != SLOT_SEPARATE) {
+            continue;
+        }
+
+        _window_token(ctx, slot->num, token);
+        if (!_id_or_token_missmatch(pkt, slot->id, token, sizeof(token))) {
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+static int _window_deliver(_window_ctx_t *ctx, uint32_t num,
+                           uint8_t *data, size_t len, bool more)
+{
+    size_t offset = num * coap_szx2size(ctx->szx);
+
+    DEBUG("nanocoap: deliver block %"PRIu32"\n", num);
+
+    /* the resource did not end before the block that failed, so the error
+     * response was not caused by requesting past its end */
+    if (more && num == ctx->last) {
+        return ctx->err;
+    }
+
+    int res = ctx->callback(ctx->arg, offset, data, len, more);
+    if (res < 0) {
+        return res;
+    }
+
+    ctx->next_cb = num + 1;
+    return 0;
+}
+
+static void _window_truncate(_window_ctx_t *ctx, uint32_t last)
+{
+    ctx->last = last;
+
+    /* cancel requests for blocks behind the end of the resource */
+    for (unsigned i = 0; i < ctx->window; ++i) {
+        if (ctx->slots[i].num > ctx->last) {
+            ctx->slots[i].state = SLOT_FREE;
+        }
+    }
+}
+
+static int _window_complete(_window_ctx_t *ctx, _window_slot_t *slot,
+                            uint8_t *data, size_t len, bool more)
+{
+    const size_t blksize = coap_szx2size(ctx->szx);
+    unsigned idx = slot - ctx->slots;
+
+    if (!more) {
+        _window_truncate(ctx, slot->num);
+    }
+
+    /* block arrived out of order, keep it until it's its turn */
+    if (slot->num != ctx->next_cb) {
+        memcpy(ctx->buf + idx * blksize, data, len);
+        slot->len = len;
+        slot->more = more;
+        slot->state = SLOT_DONE;
+        return 0;
+    }
+
+    slot->state = SLOT_FREE;
+    int res = _window_deliver(ctx, slot->num, data, len, more);
+
+    /* flush blocks that were received ahead of this one */
+    while (res == 0 && ctx->next_cb <= ctx->last) {
+        idx = ctx->next_cb % ctx->window;
+        slot = &ctx->slots[idx];
+
+        if (slot->state != SLOT_DONE || slot->num != ctx->next_cb) {
+            break;
+        }
+
+        slot->state = SLOT_FREE;
+        res = _window_deliver(ctx, slot->num, ctx->buf + idx * blksize,
+                              slot->len, slot->more);
+    }
+
+    return res;
+}
+
+static int _window_handle(_window_ctx_t *ctx, uint8_t *buf, size_t len)
+{
+    coap_pkt_t pkt;
+    coap_block1_t block2;
+
+    if (coap_parse(&pkt, buf, len) < 0) {
+        DEBUG("nanocoap: error parsing packet\n");
+        return 0;
+    }
+
+    _window_slot_t *slot = _window_match(ctx, &pkt);
+    if (slot == NULL) {
+        /* our ACK to a separate response might have been lost */
+        if (coap_get_type(&pkt) == COAP_TYPE_CON &&
+            coap_get_token_len(&pkt) == WINDOW_TOKEN_LEN &&
+            byteorder_bebuftohs(coap_get_token(&pkt)) == ctx->xfer_id) {
+            _send_ack(ctx->sock, &pkt);
+        }
+        DEBUG("nanocoap: unexpected response (id %u)\n", coap_get_id(&pkt));
+        return 0;
+    }
+
+    switch (coap_get_type(&pkt)) {
+    case COAP_TYPE_RST:
+        return -EBADMSG;
+    case COAP_TYPE_CON:
+        _send_ack(ctx->sock, &pkt);
+        /* fall-through */
+    case COAP_TYPE_ACK:
+        if (coap_get_code(&pkt) == COAP_CODE_EMPTY) {
+            /* empty ACK, wait for separate response */
+            slot->state = SLOT_SEPARATE;
+            slot->deadline = _deadline_from_interval(CONFIG_COAP_SEPARATE_RESPONSE_TIMEOUT_MS
+                                                     * US_PER_MS);
+            return 0;
+        }
+        break;
+    default:
+        break;
+    }
+
+    int res = _get_error(&pkt);
+    if (res) {
+        /* blocks are requested before the end of the resource is known, so
+         * an error for a block that is not the next one to deliver may just
+         * mean it lies behind the end */
+        if (slot->num > ctx->next_cb) {
+            DEBUG("nanocoap: error %d for block %"PRIu32", assume end of resource\n",
+                  res, slot->num);
+            ctx->err = res;
+            _window_truncate(ctx, slot->num - 1);
+            return 0;
+        }
+        return res;
+    }
+
+    /* the block size was negotiated with the first block, the server must
+     * not change it in the middle of the transfer */
+    if (!coap_get_block2(&pkt, &block2) || block2.blknum != slot->num ||
+        block2.szx != ctx->szx || pkt.payload_len > coap_szx2size(ctx->szx) ||
+        (block2.more && pkt.payload_len != coap_szx2size(ctx->szx))) {
+        DEBUG("nanocoap: invalid block2 response for block %"PRIu32"\n", slot->num);
+        return -EBADMSG;
+    }
+
+    return _window_complete(ctx, slot, pkt.payload, pkt.payload_len, block2.more);
+}
+
+static int _window_recv(_window_ctx_t *ctx, uint32_t timeout)
+{
+    void *payload, *buf_ctx = NULL;
+
+    int res = _sock_recv_buf(ctx->sock, &payload, &buf_ctx, timeout);
+    if (res <= 0) {
+        return res;
+    }
+
+    res = _window_handle(ctx, payload, res);
+
+    /* release the receive buffer */
+    _sock_recv_buf(ctx->sock, &payload, &buf_ctx, 0);
+    assert(buf_ctx == NULL);
+
+    return res;
+}
+
+static uint32_t _window_retransmit(_window_ctx_t *ctx, int *res)
+{
+    uint32_t timeout = UINT32_MAX;
+
+    for (unsigned i = 0; i < ctx->window; ++i) {
+        _window_slot_t *slot = &ctx->slots[i];
+
+        if (slot->state != SLOT_PENDING && slot->state != SLOT_SEPARATE) {
+            continue;
+        }
+
+        uint32_t left = _deadline_left_us(slot->deadline);
+        if (left == 0) {
+            if (slot->state == SLOT_SEPARATE || slot->tries_left == 0) {
+                DEBUG("nanocoap: timeout fetching block %"PRIu32"\n", slot->num);
+                *res = -ETIMEDOUT;
+                return 0;
+            }
+
+            --slot->tries_left;
+            slot->timeout *= 2;
+            *res = _window_request(ctx, slot);
+            if (*res < 0) {
+                return 0;
+            }
+            left = slot->timeout;
+        }
+
+        if (left < timeout) {
+            timeout = left;
+        }
+    }
+
+    *res = 0;
+    return timeout;
+}
+
+int nanocoap_sock_get_blockwise_window(nanocoap_sock_t *sock, const char *path,
+                                       coap_blksize_t blksize,
+                                       void *buf, size_t len,
+                                       coap_blockwise_cb_t callback, void *arg)
+{
+    uint8_t hdr[CONFIG_NANOCOAP_BLOCK_HEADER_MAX];
+
+    _block_ctx_t first = {
         .callback = callback,
         .arg = arg,
         .more = true,
+        .blksize = blksize,
     };
 
-    unsigned num = 0;
-    while (ctx.more) {
-        DEBUG("fetching block %u\n", num);
+    /* fetch the first block alone to learn whether the resource is
+     * block-wise at all and which block size the server settles on */
+    int res = _fetch_block(sock, hdr, sizeof(hdr), path, blksize, 0, &first);
+    if (res < 0) {
+        DEBUG("error fetching block 0: %d\n", res);
+        return res;
+    }
+    if (!first.more) {
+        return 0;
+    }
+
+    _window_ctx_t ctx = {
+        .sock = sock,
+        .path = path,
+        .callback = callback,
+        .arg = arg,
+        .buf = buf,
+        .next_req = 1,
+        .next_cb = 1,
+        .last = UINT32_MAX,
+        .xfer_id = random_uint32(),
+        .szx = first.blksize,
+        .window = MIN(len / coap_szx2size(first.blksize),
+                      CONFIG_NANOCOAP_BLOCKWISE_WINDOW),
+    };
 
-        int res = _fetch_block(sock, buf, sizeof(buf), path, blksize, num, &ctx);
+    if (ctx.window < 2) {
+        return _get_blockwise_seq(sock, path, ctx.szx, 1, &first);
+    }
+
+    while (ctx.next_cb <= ctx.last) {
+        /* keep the window filled */
+        while (ctx.next_req <= ctx.last &&
+               ctx.next_req < ctx.next_cb + ctx.window) {
+            res = _window_request_new(&ctx, ctx.next_req++);
+            if (res < 0) {
+                return res;
+            }
+        }
+
+        uint32_t timeout = _window_retransmit(&ctx, &res);
         if (res < 0) {
-            DEBUG("error fetching block %u: %d\n", num, res);
             return res;
         }
 
-        num += 1;
+        res = _window_recv(&ctx, timeout);
+        if (res < 0 && res != -ETIMEDOUT) {
+            DEBUG("nanocoap: windowed transfer failed: %d\n", res);
+            return res;
+        }
     }
 
     return 0;
 }
 
+int nanocoap_sock_get_blockwise(nanocoap_sock_t *sock, const char *path,
+                                coap_blksize_t blksize,
+                                coap_blockwise_cb_t callback, void *arg)
+{
+#if CONFIG_NANOCOAP_BLOCKWISE_WINDOW > 1
+    uint8_t buf[CONFIG_NANOCOAP_BLOCKWISE_WINDOW << CONFIG_NANOCOAP_BLOCK_SIZE_EXP_MAX];
+
+    return nanocoap_sock_get_blockwise_window(sock, path, blksize, buf, sizeof(buf),
+                                              callback, arg);
+#else
+    _block_ctx_t ctx = {
+        .callback = callback,
+        .arg = arg,
+        .more = true,
+    };
+
+    return _get_blockwise_seq(sock, path, blksize, 0, &ctx);
+#endif
+}
+
 int nanocoap_sock_url_connect(const char *url, nanocoap_sock_t *sock)
 {
     char hostport[CONFIG_SOCK_HOSTPORT_MAXLEN];
@@ -18,10 +18,11 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "net/dsm.h"
 #include "mutex.h"
 #include "net/sock/util.h"
-#include "xtimer.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -30,7 +31,7 @@ typedef struct {
     sock_dtls_t *sock;
     sock_dtls_session_t session;
     dsm_state_t state;
-    uint32_t last_used_sec;
+    uint32_t last_used;     /**< value of _use_count on last use */
 } dsm_session_t;
 
 static int _find_session(sock_dtls_t *sock, sock_dtls_session_t *to_find,
@@ -39,6 +40,13 @@ static int _find_session(sock_dtls_t *sock, sock_dtls_session_t *to_find,
 static mutex_t _lock;
 static dsm_session_t _sessions[CONFIG_DSM_PEER_MAX];
 static uint8_t _available_slots;
+/* counts session uses, orders sessions by last use without needing a timer */
+static uint32_t _use_count;
+
+static void _touch(dsm_session_t *session_slot)
+{
+    session_slot->last_used = ++_use_count;
+}
 
 void dsm_init(void)
 {
@@ -79,7 +87,7 @@ dsm_state_t dsm_store(sock_dtls_t *sock, sock_dtls_session_t *session,
         DEBUG("dsm: existing session found, restoring\n");
         memcpy(session, &session_slot->session, sizeof(sock_dtls_session_t));
     }
-    session_slot->last_used_sec = (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+    _touch(session_slot);
 
 out:
     mutex_unlock(&_lock);
@@ -109,6 +117,20 @@ out:
     mutex_unlock(&_lock);
 }
 
+int dsm_touch(sock_dtls_t *sock, sock_dtls_session_t *session)
+{
+    dsm_session_t *session_slot = NULL;
+    int res = -ENOENT;
+
+    mutex_lock(&_lock);
+    if (_find_session(sock, session, &session_slot) == 1) {
+        _touch(session_slot);
+        res = 0;
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
 uint8_t dsm_get_num_available_slots(void)
 {
     return _available_slots;
@@ -137,8 +159,11 @@ ssize_t dsm_get_least_recently_used_session(sock_dtls_t *sock, sock_dtls_session
             continue;
         }
 
+        /* compare the distance to the current count, robust against the
+         * count wrapping around */
         if (session_slot == NULL ||
-            session_slot->last_used_sec > _sessions[i].last_used_sec) {
+            (_use_count - _sessions[i].last_used) >
+            (_use_count - session_slot->last_used)) {
             session_slot = &_sessions[i];
         }
     }
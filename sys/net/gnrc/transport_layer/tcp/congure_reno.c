@@ -0,0 +1,82 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       TCP Reno (and ABE) congestion control for GNRC TCP
+ */
+
+#include "kernel_defines.h"
+#include "congure/abe.h"
+#include "congure/reno.h"
+#include "net/gnrc/tcp/config.h"
+
+#include "net/gnrc/tcp/tcp_congure.h"
+
+#if IS_USED(MODULE_CONGURE_ABE)
+typedef congure_abe_snd_t _tcp_congure_snd_t;
+#else
+typedef congure_reno_snd_t _tcp_congure_snd_t;
+#endif
+
+/* initial window bounds in bytes, see RFC 3390 */
+#define TCP_CONGURE_RENO_CONSTS { \
+        .fr = _fr, \
+        .same_wnd_adv = _same_wnd_adv, \
+        .init_mss = CONFIG_GNRC_TCP_MSS, \
+        .cwnd_lower = 1095U, \
+        .cwnd_upper = 2190U, \
+        .init_ssthresh = CONGURE_WND_SIZE_MAX, \
+        .frthresh = CONFIG_GNRC_TCP_DUPACK_THRESH, \
+    }
+
+static void _fr(congure_reno_snd_t *c);
+static bool _same_wnd_adv(congure_reno_snd_t *c, congure_snd_ack_t *ack);
+
+static _tcp_congure_snd_t _tcp_congures[CONFIG_GNRC_TCP_CONGURE_NUMOF];
+#if IS_USED(MODULE_CONGURE_ABE)
+static const congure_abe_snd_consts_t _tcp_congure_abe_consts = {
+    .reno = TCP_CONGURE_RENO_CONSTS,
+    .abe_multiplier_numerator = CONFIG_CONGURE_ABE_MULTIPLIER_NUMERATOR_DEFAULT,
+    .abe_multiplier_denominator = CONFIG_CONGURE_ABE_MULTIPLIER_DENOMINATOR_DEFAULT,
+};
+#else
+static const congure_reno_snd_consts_t _tcp_congure_reno_consts = TCP_CONGURE_RENO_CONSTS;
+#endif
+
+congure_snd_t *gnrc_tcp_congure_snd_get(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_tcp_congures); i++) {
+        if (_tcp_congures[i].super.driver == NULL) {
+#if IS_USED(MODULE_CONGURE_ABE)
+            congure_abe_snd_setup(&_tcp_congures[i], &_tcp_congure_abe_consts);
+#else
+            congure_reno_snd_setup(&_tcp_congures[i], &_tcp_congure_reno_consts);
+#endif
+            return &_tcp_congures[i].super;
+        }
+    }
+    return NULL;
+}
+
+static void _fr(congure_reno_snd_t *c)
+{
+    (void)c;
+    /* GNRC TCP retransmits on its own before it reports a segment as lost,
+     * so do nothing */
+}
+
+static bool _same_wnd_adv(congure_reno_snd_t *c, congure_snd_ack_t *ack)
+{
+    gnrc_tcp_tcb_t *tcb = c->super.ctx;
+
+    return ack->wnd == ((tcb->snd_wnd < CONGURE_WND_SIZE_MAX) ? tcb->snd_wnd
+                                                              : CONGURE_WND_SIZE_MAX);
+}
+
+/** @} */
@@ -97,7 +97,7 @@ static void _close(gnrc_tcp_tcb_t *tcb)
     _sched_connection_timeout(&tcb->event_misc, &mbox);
 
     /* Start connection teardown sequence */
-    _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
+    int ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
 
     /* Loop until the connection has been closed */
     state = _gnrc_tcp_fsm_get_state(tcb);
@@ -111,6 +111,11 @@ static void _close(gnrc_tcp_tcb_t *tcb)
 
             case MSG_TYPE_NOTIFY_USER:
                 TCP_DEBUG_INFO("Received MSG_TYPE_NOTIFY_USER.");
+
+                /* Retry sending FIN once acknowledgments made room for it */
+                if (ret < 0) {
+                    ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_CLOSE, NULL, NULL, 0);
+                }
                 break;
 
             default:
@@ -325,6 +330,35 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     TCP_DEBUG_LEAVE;
 }
 
+int gnrc_tcp_tcb_set_rcvbuf(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    TCP_DEBUG_ENTER;
+    assert(tcb != NULL);
+    assert(buf != NULL);
+
+    int ret = 0;
+
+    mutex_lock(&(tcb->function_lock));
+    if (_gnrc_tcp_fsm_get_state(tcb) != FSM_STATE_CLOSED) {
+        TCP_DEBUG_ERROR("-EISCONN: TCB is already in use.");
+        ret = -EISCONN;
+    }
+    else if (len < CONFIG_GNRC_TCP_MSS) {
+        TCP_DEBUG_ERROR("-EINVAL: Receive buffer is smaller than CONFIG_GNRC_TCP_MSS.");
+        ret = -EINVAL;
+    }
+    else {
+        /* Return a buffer that may be still taken from the pool */
+        _gnrc_tcp_rcvbuf_release_buffer(tcb);
+        tcb->rcv_buf_raw = buf;
+        ringbuffer_init(&tcb->rcv_buf, buf, len);
+        tcb->status |= STATUS_RCVBUF_USER;
+    }
+    mutex_unlock(&(tcb->function_lock));
+    TCP_DEBUG_LEAVE;
+    return ret;
+}
+
 void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue)
 {
     TCP_DEBUG_ENTER;
@@ -705,8 +739,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                     MSG_TYPE_USER_SPEC_TIMEOUT, &mbox);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent and the retransmit queue has space for more */
+    while (ret == 0 || tcb->rtx_num >= CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
         state = _gnrc_tcp_fsm_get_state(tcb);
 
         /* Check if the connections state is closed. If so, a reset was received */
@@ -732,6 +766,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         /* Try to send data in case there nothing has been sent and we are not probing */
         if (ret == 0 && !probing_mode) {
             ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+
+            /* Don't wait for acknowledgments while further segments can be sent */
+            if (ret > 0 && tcb->rtx_num < CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
+                break;
+            }
         }
 
         /* Wait for responses */
@@ -871,8 +910,8 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
             break;
         }
 
-        /* Try to read available data */
-        ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        /* Try to read available data, post buffer for direct receive if there is none */
+        ret = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_RECV_POST, NULL, data, max_len);
 
         /* If FIN was received (CLOSE_WAIT), no further data can be received. Leave event loop */
         if (state == FSM_STATE_CLOSE_WAIT) {
@@ -907,6 +946,14 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
         }
     }
 
+    /* Unpost buffer. Prefer data that was received directly over an error */
+    if (ret <= 0) {
+        ssize_t rcvd = _gnrc_tcp_fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        if (rcvd > 0) {
+            ret = rcvd;
+        }
+    }
+
     /* Cleanup */
     _gnrc_tcp_fsm_set_mbox(tcb, NULL);
     _unsched_mbox(&tcb->event_misc);
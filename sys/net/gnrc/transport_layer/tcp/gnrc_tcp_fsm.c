@@ -17,6 +17,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <utlist.h>
 #include <errno.h>
 #include "random.h"
@@ -24,12 +25,14 @@
 #include "net/gnrc.h"
 #include "evtimer.h"
 #include "evtimer_msg.h"
+#include "kernel_defines.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_pkt.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_rcvbuf.h"
 #include "include/gnrc_tcp_fsm.h"
+#include "net/gnrc/tcp/tcp_congure.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -92,10 +95,87 @@ static uint16_t _get_random_local_port(void)
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
+    if (tcb->rtx_num > 0) {
         _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+            gnrc_pktbuf_release(tcb->rtx[i].pkt);
+        }
+        tcb->rtx_num = 0;
+    }
+    TCP_DEBUG_LEAVE;
+    return 0;
+}
+
+/**
+ * @brief Starts loss recovery, lasting until everything sent so far is acknowledged.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _start_recovery(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->recover = tcb->snd_nxt;
+    for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+        tcb->rtx[i].resent = false;
+    }
+}
+
+/**
+ * @brief Checks if a segment in the retransmit queue is considered lost.
+ *
+ * The oldest segment and all segments below the newest selectively
+ * acknowledged segment, that are not selectively acknowledged themselves,
+ * are considered lost. Each segment is retransmitted once per loss recovery.
+ *
+ * @param[in] tcb     TCB holding the retransmit queue.
+ * @param[in] idx     Index of the segment in the retransmit queue.
+ * @param[in] limit   Index of the newest selectively acknowledged segment.
+ *
+ * @return   True if the segment at @p idx needs to be retransmitted.
+ */
+static bool _is_lost(const gnrc_tcp_tcb_t *tcb, uint8_t idx, uint8_t limit)
+{
+    const gnrc_tcp_rtx_entry_t *entry = &tcb->rtx[idx];
+
+    return (idx == 0 || idx < limit) && !entry->sacked && !entry->resent;
+}
+
+/**
+ * @brief Retransmits lost segments without waiting for the retransmission
+ *        timeout (see RFC 5681, RFC 6582 and RFC 6675).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @return   Zero on success.
+ */
+static int _retransmit_lost(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    clist_node_t lost = { NULL };
+    uint8_t limit = 0;
+
+    for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+        if (tcb->rtx[i].sacked) {
+            limit = i;
+        }
+    }
+
+    /* Report all lost segments at once, then retransmit them */
+    for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+        if (_is_lost(tcb, i, limit)) {
+            gnrc_tcp_congure_snd_msgs_add(&lost, &tcb->rtx[i]);
+        }
+    }
+    gnrc_tcp_congure_snd_report_lost(tcb, &lost);
+
+    for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+        if (_is_lost(tcb, i, limit)) {
+            TCP_DEBUG_INFO("Fast retransmit.");
+            tcb->rtx[i].resent = true;
+
+            /* Keep retransmission timer running, every send attempt consumes a user */
+            gnrc_pktbuf_hold(tcb->rtx[i].pkt, 1);
+            _gnrc_tcp_pkt_send(tcb, tcb->rtx[i].pkt, 0, true);
+        }
     }
     TCP_DEBUG_LEAVE;
     return 0;
@@ -148,8 +228,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit queue and congestion control state */
             _clear_retransmit(tcb);
+            gnrc_tcp_congure_snd_destroy(tcb);
 
             /* Close connection if not listenng */
             if (!(tcb->status & STATUS_LISTENING))
@@ -174,8 +255,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             break;
 
         case FSM_STATE_LISTEN:
-            /* Clear Accepted Status */
-            tcb->status &= ~(STATUS_ACCEPTED);
+            /* Clear Accepted Status and negotiated options */
+            tcb->status &= ~(STATUS_ACCEPTED | STATUS_WND_SCALE | STATUS_SACK_PERM);
+            tcb->snd_wnd_scale = 0;
 
             /* Clear address info */
 #ifdef MODULE_GNRC_IPV6
@@ -237,6 +319,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             if (tcb->status & STATUS_LISTENING) {
                 _gnrc_tcp_eventloop_unsched(&tcb->event_timeout);
             }
+            /* Setup congestion control for sending data */
+            gnrc_tcp_congure_snd_setup(tcb);
+            tcb->dup_acks = 0;
             tcb->status |= STATUS_NOTIFY_USER;
             break;
 
@@ -273,7 +358,21 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
         return -ENOMEM;
     }
 
-    tcb->rcv_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    /* User supplied receive buffers announce their full size */
+    if (tcb->status & STATUS_RCVBUF_USER) {
+        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    }
+    else {
+        tcb->rcv_wnd = CONFIG_GNRC_TCP_DEFAULT_WINDOW;
+    }
+
+    /* Clear negotiated options of previous connections */
+    tcb->status &= ~(STATUS_WND_SCALE | STATUS_SACK_PERM);
+    tcb->snd_wnd_scale = 0;
+    tcb->rcv_wnd_scale = 0;
+    if (IS_ACTIVE(CONFIG_GNRC_TCP_WND_SCALE_EN)) {
+        tcb->rcv_wnd_scale = _gnrc_tcp_option_calc_ws(tcb->rcv_wnd);
+    }
 
     if (tcb->status & STATUS_LISTENING) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -284,6 +383,8 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
         tcb->iss = random_uint32();
         tcb->snd_nxt = tcb->iss;
         tcb->snd_una = tcb->iss;
+        tcb->rtt_seq = tcb->iss;
+        tcb->recover = tcb->iss;
 
         /* Transition FSM to SYN_SENT */
         ret = _transition_to(tcb, FSM_STATE_SYN_SENT);
@@ -317,52 +418,85 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     TCP_DEBUG_ENTER;
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    /* Usable window is limited by the peers window and the congestion window */
+    uint32_t wnd = tcb->snd_wnd;
+    uint32_t cwnd = gnrc_tcp_congure_snd_cwnd(tcb);
+    wnd = (wnd < cwnd) ? wnd : cwnd;
+
+    size_t sent = 0;
+
+    /* Send segments as long as the window is open and the retransmit queue has space */
+    while (sent < len && tcb->rtx_num < CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
+        uint32_t in_flight = tcb->snd_nxt - tcb->snd_una;
+        if (in_flight >= wnd) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
+        size_t left = len - sent;
+        size_t payload = wnd - in_flight;
         payload = (payload < CONFIG_GNRC_TCP_MSS) ? payload : CONFIG_GNRC_TCP_MSS;
         payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+
+        /* Avoid small segments while data is in flight (sender side SWS avoidance) */
+        if (payload < left && tcb->rtx_num > 0 &&
+            payload < CONFIG_GNRC_TCP_MSS && payload < tcb->mss) {
+            break;
+        }
+        payload = (payload < left) ? payload : left;
 
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH,
-                            tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt,
+                                tcb->rcv_nxt, (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
-        TCP_DEBUG_LEAVE;
-        return payload;
+        sent += payload;
     }
     TCP_DEBUG_LEAVE;
-    return 0;
+    return sent;
 }
 
 /**
  * @brief FSM handling function for receiving data.
  *
- * @param[in,out] tcb   TCB holding the connection information.
- * @param[in,out] buf   Buffer to store received data into.
- * @param[in]     len   Maximum number of bytes to receive.
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in,out] buf    Buffer to store received data into.
+ * @param[in]     len    Maximum number of bytes to receive.
+ * @param[in]     post   If no data is available, post @p buf to let incoming
+ *                       payload be copied directly into it.
  *
  * @returns   Number of successfully received bytes.
  */
-static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len, bool post)
 {
     TCP_DEBUG_ENTER;
-
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
+    /* Take data that was copied into a previously posted buffer, unpost it */
+    size_t rcvd = tcb->rcv_usr_got;
+    tcb->rcv_usr_buf = NULL;
+    tcb->rcv_usr_len = 0;
+    tcb->rcv_usr_got = 0;
+
+    if (rcvd == 0 && ringbuffer_empty(&tcb->rcv_buf)) {
+        if (post) {
+            tcb->rcv_usr_buf = buf;
+            tcb->rcv_usr_len = len;
+        }
         TCP_DEBUG_LEAVE;
         return 0;
     }
 
     /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+    if (rcvd == 0) {
+        rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+    }
 
     /* If receive buffer can store more than CONFIG_GNRC_TCP_MSS: set window to free buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= CONFIG_GNRC_TCP_MSS) {
+    if (ringbuffer_get_free(&tcb->rcv_buf) >= CONFIG_GNRC_TCP_MSS &&
+        tcb->rcv_wnd < ringbuffer_get_free(&tcb->rcv_buf)) {
         tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
 
         /* Send ACK to announce window update */
@@ -382,6 +516,8 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
  * @param[in,out] tcb   TCB holding the connection information.
  *
  * @returns   Zero on success.
+ *            -ENOMEM if the FIN could not be queued for retransmission, e.g.
+ *            because the retransmit queue is full. The state is unchanged.
  */
 static int _fsm_call_close(gnrc_tcp_tcb_t *tcb)
 {
@@ -393,9 +529,19 @@ static int _fsm_call_close(gnrc_tcp_tcb_t *tcb)
         /* Send FIN packet */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_FIN_ACK, tcb->snd_nxt,
-                            tcb->rcv_nxt, NULL, 0);
-        _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
+        if (_gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_FIN_ACK, tcb->snd_nxt,
+                                tcb->rcv_nxt, NULL, 0) < 0) {
+            TCP_DEBUG_ERROR("-ENOMEM: Can't build FIN.");
+            TCP_DEBUG_LEAVE;
+            return -ENOMEM;
+        }
+        /* A FIN that is not in the retransmit queue would never be resent */
+        if (_gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false) < 0) {
+            gnrc_pktbuf_release(out_pkt);
+            TCP_DEBUG_ERROR("-ENOMEM: Can't queue FIN for retransmission.");
+            TCP_DEBUG_LEAVE;
+            return -ENOMEM;
+        }
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
     }
 
@@ -481,6 +627,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* Window field of SYN segments is never scaled (see RFC 7323) */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_scale;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_IPV6);
@@ -572,8 +723,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->iss = random_uint32();
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
+            tcb->rtt_seq = tcb->iss;
+            tcb->recover = tcb->iss;
             tcb->snd_wnd = seg_wnd;
 
+            /* Use window scaling only if the peer announced it as well */
+            tcb->rcv_wnd_scale = 0;
+            if (IS_ACTIVE(CONFIG_GNRC_TCP_WND_SCALE_EN) && (tcb->status & STATUS_WND_SCALE)) {
+                tcb->rcv_wnd_scale = _gnrc_tcp_option_calc_ws(tcb->rcv_wnd);
+            }
+
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
             _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss,
                                 tcb->rcv_nxt, NULL, 0);
@@ -613,6 +772,12 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_SYN) {
             tcb->rcv_nxt = seg_seq + 1;
             tcb->irs = seg_seq;
+
+            /* Disable window scaling if the peer did not announce it */
+            if (!(tcb->status & STATUS_WND_SCALE)) {
+                tcb->snd_wnd_scale = 0;
+                tcb->rcv_wnd_scale = 0;
+            }
             if (ctl & MSK_ACK) {
                 tcb->snd_una = seg_ack;
                 _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
@@ -710,10 +875,42 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2 || tcb->state == FSM_STATE_CLOSE_WAIT ||
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
+                /* Mark segments the peer received out of order */
+                if (tcb->sack_num > 0) {
+                    _gnrc_tcp_pkt_mark_sacked(tcb);
+                }
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    /* Report acknowledged data to congestion control */
+                    gnrc_tcp_congure_snd_report_acked(tcb, seg_ack, seg_wnd, pay_len,
+                                                      !(ctl & (MSK_SYN | MSK_FIN)));
                     tcb->snd_una = seg_ack;
+                    tcb->dup_acks = 0;
                     _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+
+                    /* Partial ACK during loss recovery: Retransmit next lost segment */
+                    if (LSS_32_BIT(seg_ack, tcb->recover)) {
+                        _retransmit_lost(tcb);
+                    }
+                }
+                /* Duplicate ACK (see RFC 5681, section 2): Retransmit on threshold */
+                else if (seg_ack == tcb->snd_una && tcb->rtx_num > 0 &&
+                         pay_len == 0 && !(ctl & (MSK_SYN | MSK_FIN)) &&
+                         (seg_wnd == tcb->snd_wnd || tcb->sack_num > 0)) {
+                    if (tcb->dup_acks < UINT8_MAX) {
+                        tcb->dup_acks += 1;
+                    }
+                    /* Start loss recovery, if not already recovering (see RFC 6582) */
+                    if (CONFIG_GNRC_TCP_DUPACK_THRESH > 0 &&
+                        tcb->dup_acks == CONFIG_GNRC_TCP_DUPACK_THRESH &&
+                        !LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+                        _start_recovery(tcb);
+                        _retransmit_lost(tcb);
+                    }
+                    /* SACK blocks may reveal further lost segments during recovery */
+                    else if (tcb->sack_num > 0 && LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+                        _retransmit_lost(tcb);
+                    }
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -738,25 +935,25 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         TCP_DEBUG_LEAVE;
                         return 0;
@@ -779,7 +976,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 if (tcb->rcv_nxt == seg_seq) {
                     /* Copy contents into receive buffer */
                     while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
+                        tcb->rcv_nxt += _gnrc_tcp_rcvbuf_add(tcb, snp->data, snp->size);
                         snp = snp->next;
                     }
                     /* Shrink receive window */
@@ -813,7 +1010,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_num == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -857,9 +1054,22 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->pkt_retransmit != NULL) {
-        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->rtx_num > 0) {
+        gnrc_tcp_rtx_entry_t *entry = &tcb->rtx[0];
+
+        gnrc_tcp_congure_snd_report_timeout(tcb);
+        tcb->dup_acks = 0;
+
+        /* Start loss recovery, SACK information must not be relied on (see RFC 2018) */
+        _start_recovery(tcb);
+        for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+            tcb->rtx[i].sacked = false;
+        }
+
+        /* Retransmit oldest segment */
+        entry->resent = true;
+        _gnrc_tcp_pkt_setup_retransmit(tcb, entry->pkt, true);
+        _gnrc_tcp_pkt_send(tcb, entry->pkt, 0, true);
     }
     else {
         TCP_DEBUG_INFO("Retransmission queue is empty.");
@@ -947,7 +1157,10 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_event_t event,
             ret = _fsm_call_send(tcb, buf, len);
             break;
         case FSM_EVENT_CALL_RECV :
-            ret = _fsm_call_recv(tcb, buf, len);
+            ret = _fsm_call_recv(tcb, buf, len, false);
+            break;
+        case FSM_EVENT_CALL_RECV_POST :
+            ret = _fsm_call_recv(tcb, buf, len, true);
             break;
         case FSM_EVENT_CALL_CLOSE :
             ret = _fsm_call_close(tcb);
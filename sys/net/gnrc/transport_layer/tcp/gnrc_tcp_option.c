@@ -16,7 +16,10 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include "byteorder.h"
+#include "kernel_defines.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_fsm.h"
 #include "include/gnrc_tcp_option.h"
 
 #define ENABLE_DEBUG 0
@@ -25,6 +28,9 @@
 int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
     TCP_DEBUG_ENTER;
+    /* SACK blocks are only valid for the segment they were received with */
+    tcb->sack_num = 0;
+
     /* Extract offset value. Return if no options are set */
     uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
     if (offset <= TCP_HDR_OFFSET_MIN) {
@@ -64,6 +70,65 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                 tcb->mss = (option->value[0] << 8) | option->value[1];
                 break;
 
+            case TCP_OPTION_KIND_WS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WS) {
+                    TCP_DEBUG_ERROR("Invalid WS option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("WS option found.");
+                /* Window scale option is only valid in SYN segments during connection setup.
+                 * Scaling is only used if both sides send the option (see RFC 7323), we
+                 * never send it if window scaling is disabled. */
+                if (IS_ACTIVE(CONFIG_GNRC_TCP_WND_SCALE_EN) &&
+                    (byteorder_ntohs(hdr->off_ctl) & MSK_SYN) &&
+                    (tcb->state == FSM_STATE_LISTEN || tcb->state == FSM_STATE_SYN_SENT)) {
+                    tcb->snd_wnd_scale = (option->value[0] < TCP_OPTION_WS_MAX) ?
+                                         option->value[0] : TCP_OPTION_WS_MAX;
+                    tcb->status |= STATUS_WND_SCALE;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    TCP_DEBUG_ERROR("Invalid SACK permitted option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK permitted option found.");
+                /* SACK permitted option is only valid in SYN segments during connection setup */
+                if ((byteorder_ntohs(hdr->off_ctl) & MSK_SYN) &&
+                    (tcb->state == FSM_STATE_LISTEN || tcb->state == FSM_STATE_SYN_SENT)) {
+                    tcb->status |= STATUS_SACK_PERM;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    (option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+                    TCP_DEBUG_ERROR("Invalid SACK option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK option found.");
+                /* Store blocks only if SACK was negotiated */
+                if (IS_ACTIVE(CONFIG_GNRC_TCP_SACK_EN) && (tcb->status & STATUS_SACK_PERM)) {
+                    uint8_t *block = option->value;
+                    uint8_t num = (option->length - TCP_OPTION_LENGTH_MIN) /
+                                  TCP_OPTION_LENGTH_SACK_BLOCK;
+
+                    num = (num < TCP_OPTION_SACK_BLOCKS_MAX) ? num : TCP_OPTION_SACK_BLOCKS_MAX;
+                    for (tcb->sack_num = 0; tcb->sack_num < num; ++tcb->sack_num) {
+                        tcb->sack[tcb->sack_num].left = byteorder_bebuftohl(block);
+                        tcb->sack[tcb->sack_num].right = byteorder_bebuftohl(block + 4);
+                        block += TCP_OPTION_LENGTH_SACK_BLOCK;
+                    }
+                }
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     TCP_DEBUG_INFO("Valid, unsupported option found.");
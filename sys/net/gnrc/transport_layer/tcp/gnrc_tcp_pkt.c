@@ -16,18 +16,21 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <stdbool.h>
 #include <string.h>
 #include <utlist.h>
 #include <errno.h>
 #include "byteorder.h"
 #include "evtimer.h"
 #include "evtimer_msg.h"
+#include "kernel_defines.h"
 #include "net/inet_csum.h"
 #include "net/gnrc.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_pkt.h"
+#include "net/gnrc/tcp/tcp_congure.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -49,6 +52,50 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Searches a packet in the retransmit queue.
+ *
+ * @param[in] tcb   TCB holding the retransmit queue.
+ * @param[in] pkt   Packet to search for.
+ *
+ * @returns   Retransmit queue entry of @p pkt.
+ *            NULL if @p pkt is not in the retransmit queue.
+ */
+static gnrc_tcp_rtx_entry_t *_rtx_find(gnrc_tcp_tcb_t *tcb, const gnrc_pktsnip_t *pkt)
+{
+    for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+        if (tcb->rtx[i].pkt == pkt) {
+            return &tcb->rtx[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Calculates the RTO from the current round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the round trip time estimation.
+ */
+static void _set_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without round trip time estimation: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
+                                    CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
+    }
+    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
+        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+    }
+}
+
 int _gnrc_tcp_pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt,
                                        gnrc_pktsnip_t *in_pkt)
 {
@@ -173,13 +220,32 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
+    /* Window field of SYN segments is never scaled (see RFC 7323) */
+    uint32_t wnd = (ctl & MSK_SYN) ? tcb->rcv_wnd : (tcb->rcv_wnd >> tcb->rcv_wnd_scale);
+    tcp_hdr.window = byteorder_htons((wnd < UINT16_MAX) ? wnd : UINT16_MAX);
+
     /* Calculate option field size. */
     /* Add MSS option if SYN is sent */
+    bool add_ws = false;
+    bool add_sack_perm = false;
     if (ctl & MSK_SYN) {
         offset += 1;
+
+        /* Add SACK permitted option to SYN, to SYN+ACK only if the peer sent it */
+        if (IS_ACTIVE(CONFIG_GNRC_TCP_SACK_EN) &&
+            (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERM))) {
+            add_sack_perm = true;
+            offset += 1;
+        }
+
+        /* Add window scale option to SYN, to SYN+ACK only if the peer sent it */
+        if (IS_ACTIVE(CONFIG_GNRC_TCP_WND_SCALE_EN) &&
+            (!(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE))) {
+            add_ws = true;
+            offset += 1;
+        }
     }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(
@@ -217,6 +283,23 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
                     _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
 
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            /* If SACK is negotiated: Add NOPs and SACK permitted option */
+            if (add_sack_perm) {
+                network_uint32_t sack_perm_option = byteorder_htonl(
+                    _gnrc_tcp_option_build_sack_perm());
+
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+            }
+            /* If window scaling is negotiated: Add NOP and WS option */
+            if (add_ws) {
+                network_uint32_t ws_option = byteorder_htonl(
+                    _gnrc_tcp_option_build_ws(tcb->rcv_wnd_scale));
+
+                memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                opt_ptr += sizeof(ws_option);
             }
             /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
@@ -285,13 +368,27 @@ int _gnrc_tcp_pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt,
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* Report segments in the retransmit queue carrying data to congestion control */
+    gnrc_tcp_rtx_entry_t *entry = _rtx_find(tcb, out_pkt);
+    if (entry != NULL) {
+        uint32_t pay_len = _gnrc_tcp_pkt_get_pay_len(out_pkt);
+        if (pay_len > 0) {
+            gnrc_tcp_congure_snd_report_sent(tcb, entry, pay_len, retransmit);
+        }
+    }
+
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
+        /* Measure time for one segment at a time if none is timed yet */
+        if (seq_con > 0 && !LSS_32_BIT(tcb->snd_una, tcb->rtt_seq)) {
+            tcb->rtt_seq = tcb->snd_nxt + seq_con;
+            tcb->rtt_start = evtimer_now_msec();
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = evtimer_now_msec();
     }
     else {
+        /* Stop time measurement on retransmissions (Karns Algorithm) */
+        tcb->rtt_seq = tcb->snd_una;
         tcb->retries += 1;
     }
 
@@ -390,13 +487,6 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
-        TCP_DEBUG_LEAVE;
-        return -ENOMEM;
-    }
-
     /* Extract control bits and segment length */
     snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
     ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
@@ -408,20 +498,40 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Retransmissions must be in the retransmit queue, new packets need space in it */
+    if (retransmit) {
+        if (_rtx_find(tcb, pkt) == NULL) {
+            TCP_DEBUG_ERROR("-EINVAL: pkt is not in retransmit queue.");
+            TCP_DEBUG_LEAVE;
+            return -EINVAL;
+        }
+    }
+    else if (tcb->rtx_num >= CONFIG_GNRC_TCP_SND_QUEUE_SIZE) {
+        TCP_DEBUG_ERROR("-ENOMEM: Retransmit queue is full.");
+        TCP_DEBUG_LEAVE;
+        return -ENOMEM;
+    }
+
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(CONFIG_GNRC_TCP_RTO_GRANULARITY_MS,
-                                        CONFIG_GNRC_TCP_RTO_K * tcb->rtt_var);
+        /* Append pkt to retransmit queue */
+        gnrc_tcp_rtx_entry_t *entry = &tcb->rtx[tcb->rtx_num++];
+
+        memset(entry, 0, sizeof(*entry));
+        entry->pkt = pkt;
+        entry->seq = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+        entry->len = _gnrc_tcp_pkt_get_seg_len(pkt);
+
+        /* Retransmission timer is already running for the oldest segment */
+        if (tcb->rtx_num > 1) {
+            TCP_DEBUG_LEAVE;
+            return 0;
         }
+
+        /* RTO adjustment */
+        _set_rto(tcb);
     }
     else {
         /* If this is a retransmission: Double the rto (Timer Backoff) */
@@ -433,17 +543,15 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
             tcb->srtt = RTO_UNINITIALIZED;
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
-    }
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_LOWER_BOUND_MS;
-    }
-    else if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
-        tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+        /* Perform boundary checks on current RTO before usage */
+        if (tcb->rto > (int32_t) CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS) {
+            tcb->rto = CONFIG_GNRC_TCP_RTO_UPPER_BOUND_MS;
+        }
     }
 
     /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
     _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
                               MSG_TYPE_RETRANSMISSION, tcb);
     TCP_DEBUG_LEAVE;
@@ -453,35 +561,44 @@ int _gnrc_tcp_pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
 int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
     TCP_DEBUG_ENTER;
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    uint8_t acked = 0;
+    bool timed = false;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->rtx_num == 0) {
         TCP_DEBUG_ERROR("-ENODATA: No packet to acknowledge.");
         TCP_DEBUG_LEAVE;
         return -ENODATA;
     }
 
-    snp = gnrc_pktsnip_search_type(tcb->pkt_retransmit, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
-
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _gnrc_tcp_pkt_get_seg_len(
-        tcb->pkt_retransmit) - 1;
+    /* Release all segments that were acknowledged completely */
+    while (acked < tcb->rtx_num) {
+        gnrc_tcp_rtx_entry_t *entry = &tcb->rtx[acked];
+        uint32_t seg = entry->seq + entry->len - 1;
 
-        /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        if (entry->seq + entry->len == tcb->rtt_seq) {
+            timed = true;
+        }
+        gnrc_pktbuf_release(entry->pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        TCP_DEBUG_LEAVE;
+        return 0;
+    }
+    tcb->rtx_num -= acked;
+    memmove(&tcb->rtx[0], &tcb->rtx[acked], tcb->rtx_num * sizeof(tcb->rtx[0]));
+    tcb->retries = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time if the timed segment was acknowledged */
+    if (timed) {
         int32_t rtt = evtimer_now_msec() - tcb->rtt_start;
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        /* Use time only if there was no timer overflow (Karns Algorithm is applied on sending) */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -496,10 +613,38 @@ int _gnrc_tcp_pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Stop retransmission timer or restart it for the oldest unacknowledged segment */
+    _gnrc_tcp_eventloop_unsched(&tcb->event_retransmit);
+    if (tcb->rtx_num > 0) {
+        _set_rto(tcb);
+        _gnrc_tcp_eventloop_sched(&tcb->event_retransmit, tcb->rto,
+                                  MSG_TYPE_RETRANSMISSION, tcb);
+    }
     TCP_DEBUG_LEAVE;
     return 0;
 }
 
+int _gnrc_tcp_pkt_mark_sacked(gnrc_tcp_tcb_t *tcb)
+{
+    TCP_DEBUG_ENTER;
+    int marked = 0;
+
+    for (uint8_t i = 0; i < tcb->rtx_num; i++) {
+        gnrc_tcp_rtx_entry_t *entry = &tcb->rtx[i];
+
+        for (uint8_t j = 0; !entry->sacked && j < tcb->sack_num; j++) {
+            if (LEQ_32_BIT(tcb->sack[j].left, entry->seq) &&
+                LEQ_32_BIT(entry->seq + entry->len, tcb->sack[j].right)) {
+                entry->sacked = true;
+                marked++;
+            }
+        }
+    }
+    TCP_DEBUG_LEAVE;
+    return marked;
+}
+
 uint16_t _gnrc_tcp_pkt_calc_csum(const gnrc_pktsnip_t *hdr,
                                  const gnrc_pktsnip_t *pseudo_hdr,
                                  const gnrc_pktsnip_t *payload)
@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <mutex.h>
 #include <stdint.h>
+#include <string.h>
 #include "net/gnrc/tcp/config.h"
 #include "include/gnrc_tcp_common.h"
 #include "include/gnrc_tcp_rcvbuf.h"
@@ -100,7 +101,11 @@ void _gnrc_tcp_rcvbuf_init(void)
 int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->rcv_buf_raw == NULL) {
+    /* User supplied buffers are not taken from the pool, just reset them */
+    if (tcb->status & STATUS_RCVBUF_USER) {
+        ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, tcb->rcv_buf.size);
+    }
+    else if (tcb->rcv_buf_raw == NULL) {
         tcb->rcv_buf_raw = _rcvbuf_alloc();
         if (tcb->rcv_buf_raw == NULL) {
             TCP_DEBUG_ERROR("-ENOMEM: Failed to allocate receive buffer.");
@@ -118,9 +123,29 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
-    if (tcb->rcv_buf_raw != NULL) {
+    if (tcb->rcv_buf_raw != NULL && !(tcb->status & STATUS_RCVBUF_USER)) {
         _rcvbuf_free(tcb->rcv_buf_raw);
         tcb->rcv_buf_raw = NULL;
     }
     TCP_DEBUG_LEAVE;
 }
+
+size_t _gnrc_tcp_rcvbuf_add(gnrc_tcp_tcb_t *tcb, const uint8_t *data, size_t len)
+{
+    TCP_DEBUG_ENTER;
+    size_t added = 0;
+
+    /* Copy directly into a posted user buffer. This is only allowed if the
+     * receive buffer is empty, otherwise data would be delivered out of order. */
+    if (tcb->rcv_usr_buf != NULL && ringbuffer_empty(&tcb->rcv_buf)) {
+        added = tcb->rcv_usr_len - tcb->rcv_usr_got;
+        added = (added < len) ? added : len;
+        memcpy(tcb->rcv_usr_buf + tcb->rcv_usr_got, data, added);
+        tcb->rcv_usr_got += added;
+    }
+
+    /* Store the remainder in the receive buffer */
+    added += ringbuffer_add(&tcb->rcv_buf, (const char *) data + added, len - added);
+    TCP_DEBUG_LEAVE;
+    return added;
+}
@@ -42,6 +42,52 @@ static inline uint32_t _gnrc_tcp_option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the window scale option.
+ *
+ * @note The option is prefixed with a NOP to keep the option field aligned.
+ *
+ * @param[in] shift   Shift count that should be set.
+ *
+ * @returns   NOP and window scale option value.
+ */
+static inline uint32_t _gnrc_tcp_option_build_ws(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WS << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WS << 8) | shift);
+}
+
+/**
+ * @brief Helper function to build the SACK permitted option.
+ *
+ * @note The option is prefixed with two NOPs to keep the option field aligned.
+ *
+ * @returns   NOP, NOP and SACK permitted option value.
+ */
+static inline uint32_t _gnrc_tcp_option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to calculate the window scale shift count.
+ *
+ * @param[in] size   Size of the receive buffer.
+ *
+ * @returns   Smallest shift count allowing to announce @p size.
+ */
+static inline uint8_t _gnrc_tcp_option_calc_ws(uint32_t size)
+{
+    uint8_t shift = 0;
+    while ((size >> shift) > UINT16_MAX && shift < TCP_OPTION_WS_MAX) {
+        shift += 1;
+    }
+    return shift;
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -59,6 +105,10 @@ static inline uint16_t _gnrc_tcp_option_build_offset_control(uint16_t nopts, uin
 /**
  * @brief Parses options of a given TCP header.
  *
+ * @note The window scale and SACK permitted options are only honored in SYN
+ *       segments received in state LISTEN or SYN_SENT. SACK blocks are stored
+ *       in @p tcb if SACK was negotiated.
+ *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     hdr   TCP header to be parsed.
  *
@@ -20,6 +20,9 @@
 #ifndef GNRC_TCP_RCVBUF_H
 #define GNRC_TCP_RCVBUF_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef __cplusplus
@@ -48,6 +51,21 @@ int _gnrc_tcp_rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _gnrc_tcp_rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Store received payload.
+ *
+ * If a user buffer was posted and the receive buffer is empty, the payload
+ * is copied directly into the user buffer. The remainder is stored in the
+ * receive buffer.
+ *
+ * @param[in,out] tcb    TCB holding the receive buffer.
+ * @param[in]     data   Payload to store.
+ * @param[in]     len    Size of @p data.
+ *
+ * @returns   Number of bytes stored.
+ */
+size_t _gnrc_tcp_rcvbuf_add(gnrc_tcp_tcb_t *tcb, const uint8_t *data, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
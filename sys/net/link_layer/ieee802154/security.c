@@ -18,15 +18,14 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "crypto/aes.h"
 #include "crypto/ciphers.h"
-#include "crypto/modes/ecb.h"
-#include "crypto/modes/cbc.h"
+#include "crypto/helper.h"
 #include "net/ieee802154_security.h"
 
 const ieee802154_radio_cipher_ops_t ieee802154_radio_cipher_ops = {
     .set_key = NULL,
-    .ecb = NULL,
-    .cbc = NULL
+    .ecb = NULL
 };
 
 static inline uint16_t _min(uint16_t a, uint16_t b)
@@ -40,55 +39,50 @@ static void _set_key(ieee802154_sec_context_t *ctx,
     if (ctx->dev.cipher_ops->set_key) {
         ctx->dev.cipher_ops->set_key(&ctx->dev, key, IEEE802154_SEC_BLOCK_SIZE);
     }
-    memcpy(ctx->cipher.context.context, key, IEEE802154_SEC_KEY_LENGTH);
+    if (key != ctx->cipher.context.context) {
+        memcpy(ctx->cipher.context.context, key, IEEE802154_SEC_KEY_LENGTH);
+    }
+#if IS_USED(MODULE_IEEE802154_SECURITY_SOFT_CIPHER)
+    /* the key schedule only has to be computed when the key changed */
+    if (!ctx->dev.cipher_ops->ecb &&
+        memcmp(ctx->key_schedule_key, key, IEEE802154_SEC_KEY_LENGTH)) {
+        aes_expand_key(&ctx->key_schedule, key, IEEE802154_SEC_KEY_LENGTH);
+        memcpy(ctx->key_schedule_key, key, IEEE802154_SEC_KEY_LENGTH);
+    }
+#endif
 }
 
 /**
  * @brief   Perform an ECB block cipher for IEEE 802.15.4 security layer.
  *
- * This is the fallback implementation for the case where the security device
- * does not provide an specific implementation.
+ * Uses the implementation of the security device if there is one, else the
+ * software implementation, with the cached key schedule if the
+ * `ieee802154_security_soft_cipher` module is used.
  *
- * @param[in]  dev       Security device
+ * @param[in]  ctx       Security context
  * @param[out] cipher    Output cipher blocks
  * @param[in]  plain     Input plain blocks
  * @param[in]  nblocks   Number of blocks
  */
-static void _sec_ecb(const ieee802154_sec_dev_t *dev,
+static void _sec_ecb(ieee802154_sec_context_t *ctx,
                      uint8_t *cipher,
                      const uint8_t *plain,
                      uint8_t nblocks)
 {
-    cipher_encrypt_ecb(&((ieee802154_sec_context_t *)dev->ctx)->cipher,
-                       plain,
-                       nblocks * IEEE802154_SEC_BLOCK_SIZE,
-                       cipher);
-}
-
-/**
- * @brief   Perform a CBC block cipher for IEEE 802.15.4 security layer MIC
- *          computation.
- *
- * This is the fallback implementation for the case where the security device
- * does not provide an specific implementation.
- *
- * @param[in]  dev      Security device
- * @param[out] cipher   Output cipher blocks
- * @param[in]  iv       Initial vector
- * @param[in]  plain    Input plain blocks
- * @param[in]  nblocks  Number of blocks
- */
-static void _sec_cbc(const ieee802154_sec_dev_t *dev,
-                     uint8_t *cipher,
-                     uint8_t *iv,
-                     const uint8_t *plain,
-                     uint8_t nblocks)
-{
-    cipher_encrypt_cbc(&((ieee802154_sec_context_t *)dev->ctx)->cipher,
-                       iv,
-                       plain,
-                       nblocks * IEEE802154_SEC_BLOCK_SIZE,
-                       cipher);
+    if (ctx->dev.cipher_ops->ecb) {
+        ctx->dev.cipher_ops->ecb(&ctx->dev, cipher, plain, nblocks);
+    }
+    else {
+#if IS_USED(MODULE_IEEE802154_SECURITY_SOFT_CIPHER)
+        aes_encrypt_expanded(&ctx->key_schedule, plain, cipher, nblocks);
+#else
+        for (uint8_t i = 0; i < nblocks; i++) {
+            cipher_encrypt(&ctx->cipher,
+                           plain + i * IEEE802154_SEC_BLOCK_SIZE,
+                           cipher + i * IEEE802154_SEC_BLOCK_SIZE);
+        }
+#endif
+    }
 }
 
 /**
@@ -304,89 +298,123 @@ static const uint8_t *_get_decryption_key(const ieee802154_sec_context_t *ctx,
 }
 
 /**
- * @brief   Perform ECB on one block of data and and add padding if necessary
+ * @brief   State of a CCM* operation
+ *
+ * The CBC-MAC block and the CTR block are encrypted together, so that the
+ * MIC and the payload are processed in a single pass.
+ */
+typedef struct {
+    /**
+     * @brief   CBC-MAC state and CTR block Ai
+     */
+    uint8_t in[2][IEEE802154_SEC_BLOCK_SIZE];
+    /**
+     * @brief   Encrypted CBC-MAC state and key stream block
+     */
+    uint8_t out[2][IEEE802154_SEC_BLOCK_SIZE];
+    /**
+     * @brief   Input has been added to the CBC-MAC state,
+     *          which has not been encrypted yet
+     */
+    bool mac_pending;
+} _ccm_state_t;
+
+/**
+ * @brief   Encrypt the pending CBC-MAC state and, if @p ctr is set, the
+ *          CTR block with one call
  */
-static uint8_t _ecb(ieee802154_sec_context_t *ctx,
-                    uint8_t *tmp1, uint8_t *tmp2, uint8_t *data,
-                    const uint8_t *Ai, uint16_t size)
+static void _ccm_step(ieee802154_sec_context_t *ctx, _ccm_state_t *state,
+                      bool ctr)
 {
-    uint16_t s = _min(IEEE802154_SEC_BLOCK_SIZE, size);
-    if (ctx->dev.cipher_ops->ecb) {
-        ctx->dev.cipher_ops->ecb(&ctx->dev, tmp2, Ai, 1);
+    if (state->mac_pending) {
+        _sec_ecb(ctx, state->out[0], state->in[0], ctr ? 2 : 1);
+        memcpy(state->in[0], state->out[0], IEEE802154_SEC_BLOCK_SIZE);
+        state->mac_pending = false;
     }
-    else {
-        _sec_ecb(&ctx->dev, tmp2, Ai, 1);
+    else if (ctr) {
+        _sec_ecb(ctx, state->out[1], state->in[1], 1);
     }
-    memcpy(tmp1, data, s);
-    memset(tmp1 + s, 0, IEEE802154_SEC_BLOCK_SIZE - s);
-    _memxor(tmp1, tmp2, IEEE802154_SEC_BLOCK_SIZE);
-    memcpy(data, tmp1, s);
-    return s;
 }
 
 /**
- * @brief   Perform CBC on one block of data and add padding if necessary
+ * @brief   Add up to one block of data to the CBC-MAC state, padded with
+ *          zeros
  */
-static uint8_t _cbc_next(ieee802154_sec_context_t *ctx,
-                         uint8_t *last, uint8_t *tmp,
-                         const uint8_t *next, uint16_t size)
+static uint16_t _ccm_mac(ieee802154_sec_context_t *ctx, _ccm_state_t *state,
+                         const uint8_t *data, uint16_t size)
 {
     uint16_t s = _min(IEEE802154_SEC_BLOCK_SIZE, size);
-    memcpy(tmp, next, s);
-    memset(tmp + s, 0, IEEE802154_SEC_BLOCK_SIZE - s);
-    if (ctx->dev.cipher_ops->cbc){
-        ctx->dev.cipher_ops->cbc(&ctx->dev, last, last, tmp, 1);
-    }
-    else {
-        _sec_cbc(&ctx->dev, last, last, tmp, 1);
+    if (state->mac_pending) {
+        _ccm_step(ctx, state, false);
     }
+    _memxor(state->in[0], data, s);
+    state->mac_pending = true;
     return s;
 }
 
-static void _comp_mic(ieee802154_sec_context_t *ctx,
-                      uint8_t mic[IEEE802154_SEC_MAX_MAC_SIZE],
-                      ieee802154_sec_ccm_block_t *B0,
-                      const void *a, uint16_t a_len,
-                      const void *m, uint16_t m_len)
+/**
+ * @brief   Compute the MIC and en- or decrypt the payload in place
+ *
+ * The MIC is encrypted with the key stream of A0 and written to @p mic.
+ */
+static void _ccm(ieee802154_sec_context_t *ctx, uint8_t security_level,
+                 uint32_t frame_counter, const uint8_t *src_address,
+                 const uint8_t *a, uint16_t a_len,
+                 uint8_t *m, uint16_t m_len,
+                 uint8_t mic[IEEE802154_SEC_MAX_MAC_SIZE], bool decrypt)
 {
-    uint8_t tmp[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint16_t off;
-    memset(mic, 0, IEEE802154_SEC_MAX_MAC_SIZE);
-    _cbc_next(ctx, mic, tmp, (uint8_t *)B0, sizeof(*B0));
-    byteorder_htobebufs(tmp, a_len);
-    off = _min(sizeof(tmp) - sizeof(uint16_t), a_len);
-    memcpy(tmp + sizeof(uint16_t), a, off);
-    _cbc_next(ctx, mic, tmp, tmp, sizeof(uint16_t) + off);
-    for (;off < a_len;) {
-        off += _cbc_next(ctx, mic, tmp, &(((uint8_t *)a)[off]), a_len - off);
-    }
-    for (off = 0; off < m_len;) {
-        off += _cbc_next(ctx, mic, tmp, &(((uint8_t *)m)[off]), m_len - off);
+    _ccm_state_t state = { .mac_pending = false };
+    ieee802154_sec_ccm_block_t *Ai = (ieee802154_sec_ccm_block_t *)state.in[1];
+    bool mac = _req_mac(security_level);
+    bool enc = _req_encryption(security_level);
+    uint8_t mic_size = _mac_size(security_level);
+
+    _init_ctr_A0(Ai, frame_counter, security_level, src_address);
+    if (mac) {
+        /* encrypt B0 together with A0 */
+        _init_cbc_B0((ieee802154_sec_ccm_block_t *)state.in[0], frame_counter,
+                     security_level, m_len, mic_size, src_address);
+        state.mac_pending = true;
+        _ccm_step(ctx, &state, true);
+        memcpy(mic, state.out[1], mic_size);
+
+        /* add length of a and a */
+        uint8_t tmp[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
+        byteorder_htobebufs(tmp, a_len);
+        uint16_t off = _min(sizeof(tmp) - sizeof(uint16_t), a_len);
+        memcpy(tmp + sizeof(uint16_t), a, off);
+        _ccm_mac(ctx, &state, tmp, sizeof(uint16_t) + off);
+        while (off < a_len) {
+            off += _ccm_mac(ctx, &state, &a[off], a_len - off);
+        }
     }
-}
-
-static void _ctr(ieee802154_sec_context_t *ctx,
-                 ieee802154_sec_ccm_block_t *A0,
-                 const void *m, uint16_t m_len)
-{
-    uint8_t tmp1[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint8_t tmp2[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
 
+    /* the pending CBC-MAC state of the previous block is encrypted together
+       with the key stream block of the current block */
     for (uint16_t off = 0; off < m_len;) {
-        _advance_ctr_Ai(A0);
-        off += _ecb(ctx, tmp1, tmp2,
-                    &(((uint8_t *)m)[off]), (uint8_t *)A0, m_len - off);
+        uint16_t s = _min(IEEE802154_SEC_BLOCK_SIZE, m_len - off);
+        if (enc) {
+            _advance_ctr_Ai(Ai);
+            _ccm_step(ctx, &state, true);
+        }
+        /* the MIC is computed over the plain text */
+        if (mac && !decrypt) {
+            _ccm_mac(ctx, &state, &m[off], s);
+        }
+        if (enc) {
+            _memxor(&m[off], state.out[1], s);
+        }
+        if (mac && decrypt) {
+            _ccm_mac(ctx, &state, &m[off], s);
+        }
+        off += s;
     }
-}
 
-static void _ctr_mic(ieee802154_sec_context_t *ctx,
-                     ieee802154_sec_ccm_block_t *A0,
-                     void *mic, uint8_t mic_size)
-{
-    uint8_t tmp1[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint8_t tmp2[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-
-    _ecb(ctx, tmp1, tmp2, mic, (uint8_t *)A0, mic_size);
+    if (mac) {
+        _ccm_step(ctx, &state, false);
+        /* MIC = T xor S0 */
+        _memxor(mic, state.in[0], mic_size);
+    }
 }
 
 void ieee802154_sec_init(ieee802154_sec_context_t *ctx)
@@ -405,6 +433,10 @@ void ieee802154_sec_init(ieee802154_sec_context_t *ctx)
     assert(sizeof(key) >= IEEE802154_SEC_KEY_LENGTH);
     assert(CIPHER_MAX_CONTEXT_SIZE >= IEEE802154_SEC_KEY_LENGTH);
     cipher_init(&ctx->cipher, CIPHER_AES, key, IEEE802154_SEC_KEY_LENGTH);
+#if IS_USED(MODULE_IEEE802154_SECURITY_SOFT_CIPHER)
+    aes_expand_key(&ctx->key_schedule, key, IEEE802154_SEC_KEY_LENGTH);
+    memcpy(ctx->key_schedule_key, key, IEEE802154_SEC_KEY_LENGTH);
+#endif
 }
 
 int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx,
@@ -444,22 +476,10 @@ int ieee802154_sec_encrypt_frame(ieee802154_sec_context_t *ctx,
     uint8_t *m = payload;
     uint16_t a_len = *header_size + aux_size;
     uint16_t m_len = payload_size;
-    ieee802154_sec_ccm_block_t ccm; /* Ai or Bi */
 
-    /* compute MIC */
-    if (_req_mac(ctx->security_level)) {
-        _init_cbc_B0(&ccm, ctx->frame_counter, ctx->security_level, m_len, *mic_size, src_address);
-        _comp_mic(ctx, mic, &ccm, a, a_len, m, m_len);
-
-        /* encrypt MIC */
-        _init_ctr_A0(&ccm, ctx->frame_counter, ctx->security_level, src_address);
-        _ctr_mic(ctx, &ccm, mic, *mic_size);
-    }
-    /* encrypt payload */
-    if (_req_encryption(ctx->security_level)) {
-        _init_ctr_A0(&ccm, ctx->frame_counter, ctx->security_level, src_address);
-        _ctr(ctx, &ccm, m, m_len);
-    }
+    /* compute and encrypt MIC, encrypt payload */
+    _ccm(ctx, ctx->security_level, ctx->frame_counter, src_address,
+         a, a_len, m, m_len, mic, false);
     *header_size += aux_size;
     ctx->frame_counter++;
     return IEEE802154_SEC_OK;
@@ -509,8 +529,7 @@ int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx,
     uint8_t *c = *payload;
     uint16_t a_len = *header_size + aux_size;
     uint16_t c_len = *payload_size;
-    uint8_t *mac = *mic;
-    ieee802154_sec_ccm_block_t ccm; /* Ai or Bi */
+    uint8_t tmp_mic[IEEE802154_SEC_MAX_MAC_SIZE];
 
     /* TODO:
        A better implementation would check if the received frame counter is
@@ -519,24 +538,13 @@ int ieee802154_sec_decrypt_frame(ieee802154_sec_context_t *ctx,
        But we do not store this information because we also do not have
        a proper key store, to avoid complexity on embedded devices. */
 
-    /* decrypt MIC */
-    if (mac_size) {
-        _init_ctr_A0(&ccm, frame_counter, security_level, src_address);
-        _ctr_mic(ctx, &ccm, mac, mac_size);
-    }
-    /* decrypt cipher */
-    if (_req_encryption(security_level)) {
-        _init_ctr_A0(&ccm, frame_counter, security_level, src_address);
-        _ctr(ctx, &ccm, c, c_len);
-    }
+    /* decrypt cipher, compute encrypted MIC of the plain text */
+    _ccm(ctx, security_level, frame_counter, src_address,
+         a, a_len, c, c_len, tmp_mic, true);
     /* check MIC */
-    if (_req_mac(security_level)) {
-        uint8_t tmp_mic[IEEE802154_SEC_MAX_MAC_SIZE];
-        _init_cbc_B0(&ccm, frame_counter, security_level, c_len, mac_size, src_address);
-        _comp_mic(ctx, tmp_mic, &ccm, a, a_len, c, c_len);
-        if (memcmp(tmp_mic, *mic, mac_size)) {
-            return -IEEE802154_SEC_MAC_CHECK_FAILURE;
-        }
+    if (_req_mac(security_level) &&
+        !crypto_equals(tmp_mic, *mic, mac_size)) {
+        return -IEEE802154_SEC_MAC_CHECK_FAILURE;
     }
     *header_size += aux_size;
     return IEEE802154_SEC_OK;
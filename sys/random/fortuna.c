@@ -22,6 +22,7 @@
 #include "log.h"
 #include "mutex.h"
 #include "fortuna/fortuna.h"
+#include "random_buffer.h"
 
 /**
  * @brief This holds the PRNG state.
@@ -48,6 +49,8 @@ static void _init(uint8_t *in, size_t bytes)
 
     /* update the PRNG seed (seed will be overwritten by design!) */
     fortuna_update_seed(&fortuna_state, &seed);
+
+    random_buffer_flush();
 }
 
 /**
@@ -76,7 +79,7 @@ static void _read(uint8_t *out, size_t bytes)
         /* advance bytes and buffer */
         bytes -= chunk;
         out += chunk;
-    } while (bytes > FORTUNA_RESEED_LIMIT);
+    } while (bytes > 0);
 }
 
 void random_init_by_array(uint32_t init_key[], int key_length)
@@ -89,6 +92,12 @@ void random_init(uint32_t s)
     _init((uint8_t *) &s, sizeof(s));
 }
 
+#if RANDOM_BUFFERED
+void prng_fill(uint32_t *words, size_t count)
+{
+    _read((uint8_t *) words, count * sizeof(*words));
+}
+#else
 uint32_t random_uint32(void)
 {
     uint32_t data;
@@ -97,3 +106,4 @@ uint32_t random_uint32(void)
 
     return data;
 }
+#endif
@@ -20,10 +20,13 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 
 #include "log.h"
+#include "mutex.h"
 #include "random.h"
+#include "random_buffer.h"
 #include "bitarithm.h"
 
 #ifdef MODULE_PUF_SRAM
@@ -60,6 +63,57 @@ void auto_init_random(void)
     random_init(seed);
 }
 
+#if RANDOM_BUFFERED
+static_assert(CONFIG_RANDOM_BUFFER_SIZE % sizeof(uint32_t) == 0,
+              "CONFIG_RANDOM_BUFFER_SIZE must be a multiple of 4");
+
+static mutex_t _lock = MUTEX_INIT;
+static uint32_t _buf[CONFIG_RANDOM_BUFFER_SIZE / sizeof(uint32_t)];
+/* number of bytes already handed out */
+static size_t _pos = sizeof(_buf);
+
+void random_buffer_flush(void)
+{
+    mutex_lock(&_lock);
+    memset(_buf, 0, sizeof(_buf));
+    _pos = sizeof(_buf);
+    mutex_unlock(&_lock);
+}
+
+void random_bytes(void *target, size_t n)
+{
+    uint8_t *dst = target;
+    uint8_t *buf = (uint8_t *)_buf;
+
+    mutex_lock(&_lock);
+    while (n) {
+        if (_pos == sizeof(_buf)) {
+            prng_fill(_buf, ARRAY_SIZE(_buf));
+            _pos = 0;
+        }
+
+        size_t chunk = sizeof(_buf) - _pos;
+        if (chunk > n) {
+            chunk = n;
+        }
+        memcpy(dst, &buf[_pos], chunk);
+        /* don't keep output around that was already handed out */
+        memset(&buf[_pos], 0, chunk);
+        _pos += chunk;
+        dst += chunk;
+        n -= chunk;
+    }
+    mutex_unlock(&_lock);
+}
+
+uint32_t random_uint32(void)
+{
+    uint32_t ret;
+
+    random_bytes(&ret, sizeof(ret));
+    return ret;
+}
+#else
 void random_bytes(void *target, size_t n)
 {
     uint32_t random;
@@ -75,6 +129,7 @@ void random_bytes(void *target, size_t n)
         *dst++ = *random_pos++;
     }
 }
+#endif
 
 uint32_t random_uint32_range(uint32_t a, uint32_t b)
 {
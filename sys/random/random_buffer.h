@@ -0,0 +1,73 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_random
+ * @{
+ *
+ * @file
+ * @brief       Interface between the output buffer and the CSPRNGs
+ *
+ * Fortuna produces its output in blocks and rekeys after every request,
+ * generating it four bytes at a time wastes most of each block. When
+ * @ref RANDOM_BUFFERED is set,
+ * @ref random_uint32() and @ref random_bytes() are implemented on top of a
+ * buffer of @ref CONFIG_RANDOM_BUFFER_SIZE bytes that the PRNG refills with
+ * @ref prng_fill().
+ *
+ * @internal
+ */
+
+#ifndef RANDOM_BUFFER_H
+#define RANDOM_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "random.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Whether the selected PRNG is used through the output buffer
+ */
+#define RANDOM_BUFFERED     ((CONFIG_RANDOM_BUFFER_SIZE > 0) && \
+                             IS_USED(MODULE_PRNG_FORTUNA))
+
+/**
+ * @brief   Generate words for the output buffer
+ *
+ * Implemented by the PRNG as a single request for all words, so the output
+ * depends on the buffer size. Calls are serialized by the buffer.
+ *
+ * @param[out] words    Buffer to fill
+ * @param[in]  count    Number of words to generate
+ */
+void prng_fill(uint32_t *words, size_t count);
+
+/**
+ * @brief   Discard the buffered output
+ *
+ * Called by the PRNG after it was (re)seeded, so no output of the previous
+ * state is returned afterwards.
+ */
+#if RANDOM_BUFFERED
+void random_buffer_flush(void);
+#else
+static inline void random_buffer_flush(void)
+{
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RANDOM_BUFFER_H */
+/** @} */
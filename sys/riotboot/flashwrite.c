@@ -35,6 +35,9 @@ static inline size_t min(size_t a, size_t b)
     return a <= b ? a : b;
 }
 
+/* decompressed data is passed to the flash writer in chunks of this size */
+#define DECOMPRESS_CHUNK_SIZE   (32U)
+
 size_t riotboot_flashwrite_slotsize(
     const riotboot_flashwrite_t *state)
 {
@@ -65,6 +68,7 @@ int riotboot_flashwrite_init_raw(riotboot_flashwrite_t *state, int target_slot,
     state->target_slot = target_slot;
     state->flashpage =
         flashpage_page((void *)riotboot_slot_get_hdr(target_slot));
+    state->erase_page = state->flashpage + 1;
 
     if (CONFIG_RIOTBOOT_FLASHWRITE_RAW && offset) {
         /* Erase the first page only if the offset (!=0) specifies that there is
@@ -104,8 +108,8 @@ int riotboot_flashwrite_flush(riotboot_flashwrite_t *state)
     return 0;
 }
 
-int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
-                                 const uint8_t *bytes, size_t len, bool more)
+static int _putbytes(riotboot_flashwrite_t *state,
+                     const uint8_t *bytes, size_t len, bool more)
 {
     LOG_DEBUG(LOG_PREFIX "processing bytes %u-%u\n", state->offset,
               state->offset + len - 1);
@@ -126,10 +130,13 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
 
         if (CONFIG_RIOTBOOT_FLASHWRITE_RAW &&
             flashpage_pos == flashpage_size(state->flashpage)) {
-            /* Erase the next page */
+            /* Erase the next page, unless it was erased ahead already */
             state->flashpage++;
             flashpage_pos = 0;
-            flashpage_erase(state->flashpage);
+            if (state->flashpage >= state->erase_page) {
+                flashpage_erase(state->flashpage);
+                state->erase_page = state->flashpage + 1;
+            }
         }
         if (CONFIG_RIOTBOOT_FLASHWRITE_RAW &&
             flashwrite_buffer_pos == 0) {
@@ -153,7 +160,10 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
                        state->flashpage_buf, RIOTBOOT_FLASHPAGE_BUFFER_SIZE);
             }
             else {
-                flashpage_write((uint8_t *)addr + flashpage_pos,
+                /* the buffer may have been filled by several calls, write it
+                 * to the start of its block */
+                flashpage_write((uint8_t *)addr + flashpage_pos -
+                                flashwrite_buffer_pos,
                                 state->flashpage_buf,
                                 RIOTBOOT_FLASHPAGE_BUFFER_SIZE);
             }
@@ -173,6 +183,113 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
     return 0;
 }
 
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK)
+int riotboot_flashwrite_init_compressed(riotboot_flashwrite_t *state,
+                                        int target_slot)
+{
+    int res = riotboot_flashwrite_init(state, target_slot);
+
+    heatshrink_decoder_reset(&state->decoder);
+    /* the magic number is written by riotboot_flashwrite_finish() */
+    state->skip = RIOTBOOT_FLASHWRITE_SKIPLEN;
+    state->compressed = true;
+
+    return res;
+}
+
+static int _write_decompressed(riotboot_flashwrite_t *state,
+                               const uint8_t *bytes, size_t len)
+{
+    size_t skip = min(state->skip, len);
+
+    state->skip -= skip;
+    if (len == skip) {
+        return 0;
+    }
+    return _putbytes(state, bytes + skip, len - skip, true);
+}
+
+static int _putbytes_compressed(riotboot_flashwrite_t *state,
+                                const uint8_t *bytes, size_t len, bool more)
+{
+    heatshrink_decoder *hsd = &state->decoder;
+    uint8_t buf[DECOMPRESS_CHUNK_SIZE];
+
+    while (1) {
+        if (len) {
+            size_t sunk = 0;
+            if (heatshrink_decoder_sink(hsd, (uint8_t *)bytes, len,
+                                        &sunk) < 0) {
+                return -1;
+            }
+            bytes += sunk;
+            len -= sunk;
+        }
+        else if (!more) {
+            HSD_finish_res res = heatshrink_decoder_finish(hsd);
+            if (res < 0) {
+                return -1;
+            }
+            if (res == HSDR_FINISH_DONE) {
+                break;
+            }
+        }
+        else {
+            return 0;
+        }
+
+        HSD_poll_res res;
+        do {
+            size_t out = 0;
+            res = heatshrink_decoder_poll(hsd, buf, sizeof(buf), &out);
+            if ((res < 0) || (_write_decompressed(state, buf, out) < 0)) {
+                LOG_WARNING(LOG_PREFIX "error decompressing image\n");
+                return -1;
+            }
+        } while (res == HSDR_POLL_MORE);
+    }
+
+    /* write the last partially filled buffer */
+    if (state->offset % RIOTBOOT_FLASHPAGE_BUFFER_SIZE) {
+        return riotboot_flashwrite_flush(state);
+    }
+    return 0;
+}
+#endif
+
+int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
+                                 const uint8_t *bytes, size_t len, bool more)
+{
+#if IS_USED(MODULE_RIOTBOOT_FLASHWRITE_HEATSHRINK)
+    if (state->compressed) {
+        return _putbytes_compressed(state, bytes, len, more);
+    }
+#endif
+    return _putbytes(state, bytes, len, more);
+}
+
+int riotboot_flashwrite_erase_ahead(riotboot_flashwrite_t *state)
+{
+    if (!CONFIG_RIOTBOOT_FLASHWRITE_RAW) {
+        return 0;
+    }
+
+    const uint8_t *slot_start =
+        (const uint8_t *)riotboot_slot_get_hdr(state->target_slot);
+    unsigned last_page = flashpage_page(
+        (void *)(slot_start + riotboot_slot_size(state->target_slot) - 1));
+
+    if ((state->erase_page > last_page) ||
+        (state->erase_page > state->flashpage +
+                             CONFIG_RIOTBOOT_FLASHWRITE_ERASE_AHEAD)) {
+        return 0;
+    }
+
+    LOG_DEBUG(LOG_PREFIX "erasing page %u ahead\n", state->erase_page);
+    flashpage_erase(state->erase_page++);
+    return 1;
+}
+
 int riotboot_flashwrite_invalidate(int slot)
 {
     if (riotboot_slot_numof == 1) {
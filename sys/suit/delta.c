@@ -0,0 +1,238 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_suit_delta
+ * @{
+ *
+ * @file
+ * @brief       SUIT VCDIFF delta payloads
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "log.h"
+#include "suit.h"
+#include "suit/delta.h"
+#include "suit/storage.h"
+#include "vcdiff.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static int _select(suit_delta_t *delta, bool source)
+{
+    /* Source and target share the active location of a storage backend */
+    if ((delta->source != delta->target) || delta->installed ||
+        (delta->source_selected == source)) {
+        return SUIT_OK;
+    }
+
+    delta->source_selected = source;
+    return suit_storage_set_active_location(delta->target, source
+                                            ? delta->source_location
+                                            : delta->target_location);
+}
+
+static int _flush(suit_delta_t *delta)
+{
+    if (delta->buffered == 0) {
+        return SUIT_OK;
+    }
+
+    int res = _select(delta, false);
+    if (res == SUIT_OK) {
+        res = suit_storage_write(delta->target, delta->manifest, delta->buf,
+                                 delta->offset, delta->buffered);
+    }
+    if (res != SUIT_OK) {
+        return res;
+    }
+
+    delta->offset += delta->buffered;
+    delta->buffered = 0;
+    return SUIT_OK;
+}
+
+static int _source_read(void *dev, uint8_t *dest, size_t offset, size_t len)
+{
+    suit_delta_t *delta = dev;
+    int res;
+
+    DEBUG("suit_delta: reading %u source bytes at %u\n",
+          (unsigned)len, (unsigned)offset);
+
+    if (delta->installed) {
+        res = suit_storage_read_installed(delta->target, dest, offset, len);
+    }
+    else {
+        res = _select(delta, true);
+        if (res == SUIT_OK) {
+            res = suit_storage_read(delta->source, dest, offset, len);
+        }
+    }
+
+    return (res == SUIT_OK) ? 0 : -EIO;
+}
+
+static int _target_read(void *dev, uint8_t *dest, size_t offset, size_t len)
+{
+    suit_delta_t *delta = dev;
+
+    if (offset + len > delta->offset + delta->buffered) {
+        return -EINVAL;
+    }
+
+    /* part already written to the storage backend */
+    if (offset < delta->offset) {
+        size_t chunk = delta->offset - offset;
+        if (chunk > len) {
+            chunk = len;
+        }
+        if ((_select(delta, false) != SUIT_OK) ||
+            (suit_storage_read(delta->target, dest, offset, chunk) != SUIT_OK)) {
+            return -EIO;
+        }
+        dest += chunk;
+        offset += chunk;
+        len -= chunk;
+    }
+
+    /* part still in the buffer */
+    memcpy(dest, &delta->buf[offset - delta->offset], len);
+    return 0;
+}
+
+static int _target_write(void *dev, uint8_t *src, size_t offset, size_t len)
+{
+    suit_delta_t *delta = dev;
+
+    DEBUG("suit_delta: writing %u bytes at %u\n", (unsigned)len, (unsigned)offset);
+
+    /* VCDIFF produces the target sequentially */
+    if (offset != delta->offset + delta->buffered) {
+        return -EINVAL;
+    }
+    if ((offset + len > delta->target_size) || (offset + len < offset)) {
+        LOG_ERROR("suit_delta: payload exceeds %u bytes\n",
+                  (unsigned)delta->target_size);
+        return -EFBIG;
+    }
+
+    while (len) {
+        size_t chunk = sizeof(delta->buf) - delta->buffered;
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(&delta->buf[delta->buffered], src, chunk);
+        delta->buffered += chunk;
+        src += chunk;
+        len -= chunk;
+
+        if ((delta->buffered == sizeof(delta->buf)) && (_flush(delta) != SUIT_OK)) {
+            return -EIO;
+        }
+    }
+
+    return 0;
+}
+
+static int _target_flush(void *dev)
+{
+    return (_flush(dev) == SUIT_OK) ? 0 : -EIO;
+}
+
+static const vcdiff_driver_t _source_driver = {
+    .read = _source_read,
+};
+
+static const vcdiff_driver_t _target_driver = {
+    .read = _target_read,
+    .write = _target_write,
+    .flush = _target_flush,
+};
+
+int suit_delta_start(suit_delta_t *delta, const suit_manifest_t *manifest,
+                     suit_storage_t *source, const char *source_location,
+                     suit_storage_t *target, const char *target_location,
+                     size_t target_size)
+{
+    memset(delta, 0, sizeof(*delta));
+
+    if (source_location == NULL) {
+        if (!suit_storage_has_read_installed(target)) {
+            LOG_ERROR("suit_delta: storage can't read installed payload\n");
+            return SUIT_ERR_UNSUPPORTED;
+        }
+        delta->installed = true;
+    }
+    else if ((strlen(source_location) >= sizeof(delta->source_location)) ||
+             (strlen(target_location) >= sizeof(delta->target_location))) {
+        return SUIT_ERR_UNSUPPORTED;
+    }
+    else {
+        strcpy(delta->source_location, source_location);
+        strcpy(delta->target_location, target_location);
+    }
+
+    delta->manifest = manifest;
+    delta->source = source;
+    delta->target = target;
+    delta->target_size = target_size;
+
+    vcdiff_init(&delta->vcdiff);
+    vcdiff_set_source_driver(&delta->vcdiff, &_source_driver, delta);
+    vcdiff_set_target_driver(&delta->vcdiff, &_target_driver, delta);
+
+    if (!delta->installed && (source != target)) {
+        /* the source backend is only read from */
+        return suit_storage_set_active_location(source, source_location);
+    }
+    return SUIT_OK;
+}
+
+int suit_delta_write(suit_delta_t *delta, const uint8_t *buf, size_t len)
+{
+    int res = vcdiff_apply_delta(&delta->vcdiff, buf, len);
+
+    if (res < 0) {
+        LOG_ERROR("suit_delta: applying delta failed with %d\n", res);
+        return SUIT_ERR_STORAGE;
+    }
+    return SUIT_OK;
+}
+
+int suit_delta_finish(suit_delta_t *delta)
+{
+    int res = vcdiff_finish(&delta->vcdiff);
+
+    if (res < 0) {
+        LOG_ERROR("suit_delta: incomplete delta (%d)\n", res);
+        return SUIT_ERR_STORAGE;
+    }
+
+    /* no-op if the decoder already flushed the target */
+    res = _flush(delta);
+    if (res != SUIT_OK) {
+        return res;
+    }
+
+    /* leave the target location active for verification and install */
+    res = _select(delta, false);
+    if (res != SUIT_OK) {
+        return res;
+    }
+
+    if (delta->offset != delta->target_size) {
+        LOG_ERROR("suit_delta: got %u bytes, expected %u\n",
+                  (unsigned)delta->offset, (unsigned)delta->target_size);
+        return SUIT_ERR_STORAGE;
+    }
+    return SUIT_OK;
+}
@@ -46,6 +46,10 @@
 #include "suit/transport/custom.h"
 #endif
 #include "suit/transport/mock.h"
+#include "suit/transport/pipeline.h"
+#if IS_USED(MODULE_SUIT_DELTA)
+#include "suit/delta.h"
+#endif
 
 #if defined(MODULE_PROGRESS_BAR)
 #include "progress_bar.h"
@@ -293,6 +297,9 @@ static int _dtv_set_param(suit_manifest_t *manifest, int key,
             case SUIT_PARAMETER_URI:
                 ref = &comp->param_uri;
                 break;
+            case SUIT_PARAMETER_SOURCE_COMPONENT:
+                ref = &comp->param_source_component;
+                break;
             default:
                 LOG_DEBUG("Unsupported parameter %" PRIi32 "\n", param_key);
                 return SUIT_ERR_UNSUPPORTED;
@@ -325,6 +332,46 @@ static int _start_storage(suit_manifest_t *manifest, suit_component_t *comp)
     return suit_storage_start(comp->storage_backend, manifest, img_size);
 }
 
+#if IS_USED(MODULE_SUIT_DELTA)
+/* Decoder of the delta payload currently fetched, if any */
+static suit_delta_t _delta;
+static bool _delta_active;
+
+static int _start_delta(suit_manifest_t *manifest, suit_component_t *comp,
+                        nanocbor_value_t *param_source)
+{
+    uint32_t img_size = 0;
+    uint32_t source_idx;
+    char target_name[CONFIG_SUIT_COMPONENT_MAX_NAME_LEN];
+    char source_name[CONFIG_SUIT_COMPONENT_MAX_NAME_LEN];
+
+    if ((nanocbor_get_uint32(param_source, &source_idx) < 0) ||
+        (source_idx >= manifest->components_len) ||
+        (_get_component_size(manifest, comp, &img_size) < 0)) {
+        return SUIT_ERR_INVALID_MANIFEST;
+    }
+
+    suit_component_t *source = &manifest->components[source_idx];
+    suit_storage_t *source_storage = source->storage_backend;
+    suit_storage_t *target_storage = comp->storage_backend;
+
+    suit_component_name_to_string(manifest, comp,
+                                  suit_storage_get_separator(target_storage),
+                                  target_name, sizeof(target_name));
+    suit_component_name_to_string(manifest, source,
+                                  suit_storage_get_separator(source_storage),
+                                  source_name, sizeof(source_name));
+
+    LOG_INFO("Fetching delta against component %" PRIu32 "\n", source_idx);
+
+    int res = suit_delta_start(&_delta, manifest, source_storage,
+                               (source == comp) ? NULL : source_name,
+                               target_storage, target_name, img_size);
+    _delta_active = (res == SUIT_OK);
+    return res;
+}
+#endif
+
 static inline void _print_download_progress(suit_manifest_t *manifest,
                                             size_t offset, size_t len,
                                             size_t image_size)
@@ -348,7 +395,8 @@ static inline void _print_download_progress(suit_manifest_t *manifest,
 #endif
 }
 
-#if defined(MODULE_SUIT_TRANSPORT_COAP) || defined(MODULE_SUIT_TRANSPORT_VFS) || defined(MODULE_SUIT_TRANSPORT_CUSTOM)
+#if defined(MODULE_SUIT_TRANSPORT_COAP) || defined(MODULE_SUIT_TRANSPORT_VFS) || \
+    defined(MODULE_SUIT_TRANSPORT_CUSTOM) || defined(MODULE_SUIT_TRANSPORT_MOCK)
 static int _storage_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
                            int more)
 {
@@ -367,7 +415,14 @@ static int _storage_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
         return -1;
     }
 
-    if (image_size < offset + len) {
+    /* The size of a delta payload is unrelated to the image size, the
+     * decoder checks the size of the output */
+    bool delta = false;
+#if IS_USED(MODULE_SUIT_DELTA)
+    delta = _delta_active;
+#endif
+
+    if (!delta && (image_size < offset + len)) {
         /* Extra newline at the start to compensate for the progress bar */
         LOG_ERROR(
             "\n_suit_coap(): Image beyond size, offset + len=%u, "
@@ -375,7 +430,7 @@ static int _storage_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
         return -1;
     }
 
-    if (!more && image_size != total) {
+    if (!delta && !more && image_size != total) {
         LOG_INFO("Incorrect size received, got %u, expected %u\n",
                  (unsigned)total, (unsigned)image_size);
         return -1;
@@ -383,9 +438,34 @@ static int _storage_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
 
     _print_download_progress(manifest, offset, len, image_size);
 
-    int res = suit_storage_write(comp->storage_backend, manifest, buf, offset, len);
+    int res = SUIT_OK;
+    if (delta) {
+#if IS_USED(MODULE_SUIT_DELTA)
+        res = suit_delta_write(&_delta, buf, len);
+        if ((res == SUIT_OK) && !more) {
+            _delta_active = false;
+            res = suit_delta_finish(&_delta);
+        }
+        if (res != SUIT_OK) {
+            return res;
+        }
+#endif
+    }
+    else if (IS_USED(MODULE_SUIT_TRANSPORT_PIPELINE)) {
+        /* Written by the pipeline thread while the next block is fetched */
+        res = suit_transport_pipeline_write(buf, offset, len);
+    }
+    else {
+        res = suit_storage_write(comp->storage_backend, manifest, buf, offset, len);
+    }
     if (!more) {
         LOG_INFO("Finalizing payload store\n");
+        if (!delta && IS_USED(MODULE_SUIT_TRANSPORT_PIPELINE)) {
+            res = suit_transport_pipeline_finish();
+            if (res != SUIT_OK) {
+                return res;
+            }
+        }
         /* Finalize the write if no more data available */
         res = suit_storage_finish(comp->storage_backend, manifest);
     }
@@ -437,6 +517,26 @@ static int _dtv_fetch(suit_manifest_t *manifest, int key,
         return SUIT_ERR_STORAGE;
     }
 
+    nanocbor_value_t param_source;
+    if (suit_param_ref_to_cbor(manifest, &comp->param_source_component,
+                               &param_source) != 0) {
+#if IS_USED(MODULE_SUIT_DELTA)
+        res = _start_delta(manifest, comp, &param_source);
+        if (res != SUIT_OK) {
+            LOG_ERROR("Unable to start delta decoder\n");
+            return res;
+        }
+#else
+        LOG_ERROR("Delta payloads not supported\n");
+        return SUIT_ERR_UNSUPPORTED;
+#endif
+    }
+    /* Delta payloads are decoded while downloading, not pipelined */
+    else if (IS_USED(MODULE_SUIT_TRANSPORT_PIPELINE) &&
+             suit_transport_pipeline_start(comp->storage_backend, manifest) < 0) {
+        return SUIT_ERR_STORAGE;
+    }
+
     res = -1;
 
     if (0) {}
@@ -450,7 +550,7 @@ static int _dtv_fetch(suit_manifest_t *manifest, int key,
 #endif
 #ifdef MODULE_SUIT_TRANSPORT_MOCK
     else if (strncmp(manifest->urlbuf, "test://", 7) == 0) {
-        res = suit_transport_mock_fetch(manifest);
+        res = suit_transport_mock_fetch(manifest, _storage_helper, manifest);
     }
 #endif
 #ifdef MODULE_SUIT_TRANSPORT_VFS
@@ -465,9 +565,24 @@ static int _dtv_fetch(suit_manifest_t *manifest, int key,
 #endif
     else {
         LOG_WARNING("suit: unsupported URL scheme!\n)");
+        if (IS_USED(MODULE_SUIT_TRANSPORT_PIPELINE)) {
+            suit_transport_pipeline_finish();
+        }
+#if IS_USED(MODULE_SUIT_DELTA)
+        _delta_active = false;
+#endif
         return res;
     }
 
+    if (IS_USED(MODULE_SUIT_TRANSPORT_PIPELINE)) {
+        /* No-op after a complete download, otherwise stops writing */
+        suit_transport_pipeline_finish();
+    }
+#if IS_USED(MODULE_SUIT_DELTA)
+    /* Drop the decoder state of an incomplete delta */
+    _delta_active = false;
+#endif
+
     suit_component_set_flag(comp, SUIT_COMPONENT_STATE_FETCHED);
 
     if (res) {
@@ -508,7 +623,17 @@ static int _validate_payload(suit_component_t *component, const uint8_t *digest,
     uint8_t payload_digest[SHA256_DIGEST_LENGTH];
     suit_storage_t *storage = component->storage_backend;
 
-    if (suit_storage_has_readptr(storage)) {
+    if (suit_storage_has_digest(storage)) {
+        /* Digest computed while writing */
+        size_t digest_len = 0;
+
+        if ((suit_storage_get_digest(storage, payload_digest,
+                                     &digest_len) != SUIT_OK) ||
+            (payload_size != digest_len)) {
+            return SUIT_ERR_STORAGE_EXCEEDED;
+        }
+    }
+    else if (suit_storage_has_readptr(storage)) {
         /* Direct read possible */
         const uint8_t *payload = NULL;
         size_t payload_len = 0;
@@ -55,6 +55,11 @@ static int _flashwrite_start(suit_storage_t *storage,
     suit_storage_flashwrite_t *fw = _get_fw(storage);
     int target_slot = riotboot_slot_other();
 
+#if CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST
+    sha256_init(&fw->sha256);
+    fw->digest_len = 0;
+#endif
+
     return riotboot_flashwrite_init(&fw->writer, target_slot);
 }
 
@@ -65,6 +70,17 @@ static int _flashwrite_write(suit_storage_t *storage,
     (void)manifest;
     suit_storage_flashwrite_t *fw = _get_fw(storage);
 
+#if CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST
+    if (offset != fw->digest_len) {
+        LOG_ERROR("Unexpected offset: %u - expected: %u\n", (unsigned)offset,
+                  (unsigned)fw->digest_len);
+        return SUIT_ERR_STORAGE;
+    }
+    /* hash the image as received, including the magic number skipped below */
+    sha256_update(&fw->sha256, buf, len);
+    fw->digest_len += len;
+#endif
+
     if (offset == 0) {
         if (len < RIOTBOOT_FLASHWRITE_SKIPLEN) {
             LOG_WARNING("_suit_flashwrite(): offset==0, len<4. aborting\n");
@@ -94,6 +110,28 @@ static int _flashwrite_finish(suit_storage_t *storage,
            0 ? SUIT_ERR_STORAGE : SUIT_OK;
 }
 
+#if CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST
+static int _flashwrite_get_digest(suit_storage_t *storage, uint8_t *digest,
+                                  size_t *len)
+{
+    suit_storage_flashwrite_t *fw = _get_fw(storage);
+    /* finalize a copy, the image match condition is checked by both the
+     * install and the validate sequence */
+    sha256_context_t ctx = fw->sha256;
+
+    sha256_final(&ctx, digest);
+    *len = fw->digest_len;
+    return SUIT_OK;
+}
+#endif
+
+static int _flashwrite_prepare(suit_storage_t *storage)
+{
+    suit_storage_flashwrite_t *fw = _get_fw(storage);
+
+    return riotboot_flashwrite_erase_ahead(&fw->writer);
+}
+
 static int _flashwrite_install(suit_storage_t *storage,
                                const suit_manifest_t *manifest)
 {
@@ -116,6 +154,9 @@ static int _flashwrite_read(suit_storage_t *storage, uint8_t *buf,
     /* Insert the "RIOT" magic number */
     if (offset < (_prefix_len)) {
         size_t prefix_to_copy = _prefix_len - offset;
+        if (prefix_to_copy > len) {
+            prefix_to_copy = len;
+        }
         memcpy(buf, _prefix + offset, prefix_to_copy);
         len -= prefix_to_copy;
         offset = _prefix_len;
@@ -123,13 +164,25 @@ static int _flashwrite_read(suit_storage_t *storage, uint8_t *buf,
 
     }
 
+    if (offset + len > slot_size) {
+        return -1;
+    }
+
+    /* The data written last may not have reached the flash yet, it is still
+     * in the flashwrite buffer up to the next buffer boundary */
+    size_t written = fw->writer.offset;
+    size_t buffered = written - (written % RIOTBOOT_FLASHPAGE_BUFFER_SIZE);
+    uint8_t *read_buf = buf;
+    size_t read_offset = offset;
+    size_t read_len = len;
+
 #if CONFIG_RIOTBOOT_FLASHWRITE_RAW
     /* Insert the first chunk from the separate buffer here, there are cases
      * where the chunk size is 4 bytes and we can skip this because it only
      * contains the magic number already copied above. */
     if (offset < RIOTBOOT_FLASHPAGE_BUFFER_SIZE) {
         const size_t chunk_remaining =
-            RIOTBOOT_FLASHPAGE_BUFFER_SIZE - _prefix_len;
+            RIOTBOOT_FLASHPAGE_BUFFER_SIZE - offset;
         /* How much of the first page must be copied */
         size_t firstpage_to_copy = len > chunk_remaining ?
             (chunk_remaining) : len;
@@ -140,20 +193,42 @@ static int _flashwrite_read(suit_storage_t *storage, uint8_t *buf,
         buf += firstpage_to_copy;
         len -= firstpage_to_copy;
     }
-#else
-    (void)fw;
 #endif /* CONFIG_RIOTBOOT_FLASHWRITE_RAW */
 
-    if (offset + len > slot_size) {
-        return -1;
-    }
-
     uint8_t *slot = (uint8_t *)riotboot_slot_get_hdr(target_slot);
 
     memcpy(buf, slot + offset, len);
+
+    /* Replace the part that is still buffered */
+    if ((read_offset < written) && (read_offset + read_len > buffered)) {
+        size_t start = (read_offset > buffered) ? read_offset : buffered;
+        size_t end = (read_offset + read_len < written) ? read_offset + read_len
+                                                        : written;
+
+        memcpy(read_buf + (start - read_offset),
+               fw->writer.flashpage_buf + (start - buffered), end - start);
+    }
     return 0;
 }
 
+static int _flashwrite_read_installed(suit_storage_t *storage, uint8_t *buf,
+                                      size_t offset, size_t len)
+{
+    (void)storage;
+
+    int slot = riotboot_slot_current();
+    size_t slot_size = riotboot_slot_size(slot);
+
+    if ((offset > slot_size) || (len > slot_size - offset)) {
+        return SUIT_ERR_STORAGE_EXCEEDED;
+    }
+
+    const uint8_t *slot_start = (const uint8_t *)riotboot_slot_get_hdr(slot);
+
+    memcpy(buf, slot_start + offset, len);
+    return SUIT_OK;
+}
+
 static bool _flashwrite_has_location(const suit_storage_t *storage,
                                      const char *location)
 {
@@ -228,6 +303,11 @@ static const suit_storage_driver_t suit_storage_flashwrite_driver = {
     .write = _flashwrite_write,
     .finish = _flashwrite_finish,
     .read = _flashwrite_read,
+    .read_installed = _flashwrite_read_installed,
+#if CONFIG_SUIT_STORAGE_FLASHWRITE_STREAM_DIGEST
+    .get_digest = _flashwrite_get_digest,
+#endif
+    .prepare = _flashwrite_prepare,
     .install = _flashwrite_install,
     .has_location = _flashwrite_has_location,
     .set_active_location = _flashwrite_set_active_location,
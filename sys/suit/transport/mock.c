@@ -16,27 +16,46 @@
 #include "suit.h"
 #include "suit/storage.h"
 #include "suit/transport/mock.h"
+#if CONFIG_SUIT_TRANSPORT_MOCK_DELAY_US
+#include "ztimer.h"
+#endif
 
 /* Must be defined by the test */
 extern const suit_transport_mock_payload_t payloads[];
 extern const size_t num_payloads;
 
-static const suit_component_t *_get_component(const suit_manifest_t *manifest)
-{
-    assert(manifest->component_current < CONFIG_SUIT_COMPONENT_MAX);
-    return &manifest->components[manifest->component_current];
-}
-
-int suit_transport_mock_fetch(const suit_manifest_t *manifest)
+int suit_transport_mock_fetch(const suit_manifest_t *manifest,
+                              coap_blockwise_cb_t cb, void *ctx)
 {
     size_t file = manifest->component_current;
-    const suit_component_t *comp = _get_component(manifest);
+    const uint8_t *buf;
+    size_t offset = 0;
+    int res = 0;
 
     assert(file < num_payloads);
 
     LOG_INFO("Mock writing payload %d\n", (unsigned)file);
 
-    suit_storage_write(comp->storage_backend, manifest, payloads[file].buf, 0,
-                       payloads[file].len);
-    return 0;
+    buf = payloads[file].buf;
+    do {
+        size_t len = payloads[file].len - offset;
+        if (len > CONFIG_SUIT_TRANSPORT_MOCK_BLOCKSIZE) {
+            len = CONFIG_SUIT_TRANSPORT_MOCK_BLOCKSIZE;
+        }
+
+#if CONFIG_SUIT_TRANSPORT_MOCK_DELAY_US
+        ztimer_sleep(ZTIMER_USEC, CONFIG_SUIT_TRANSPORT_MOCK_DELAY_US);
+#endif
+
+        /* blockwise callbacks take a mutable buffer */
+        res = cb(ctx, offset, (uint8_t *)&buf[offset], len,
+                 offset + len < payloads[file].len);
+        if (res < 0) {
+            LOG_ERROR("Mock write failed with %d\n", res);
+            return res;
+        }
+        offset += len;
+    } while (offset < payloads[file].len);
+
+    return res;
 }
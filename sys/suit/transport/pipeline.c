@@ -0,0 +1,196 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_suit_transport_pipeline
+ * @{
+ *
+ * @file
+ * @brief       SUIT pipelined payload writes
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "log.h"
+#include "mutex.h"
+#include "sema.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#include "suit.h"
+#include "suit/storage.h"
+#include "suit/transport/pipeline.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* wakes up the writer thread */
+#define FLAG_WAKEUP     (0x1)
+
+typedef struct {
+    size_t offset;
+    size_t len;
+    uint8_t buf[CONFIG_SUIT_TRANSPORT_PIPELINE_BUFSIZE];
+} _chunk_t;
+
+static char _stack[SUIT_TRANSPORT_PIPELINE_STACKSIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+static _chunk_t _chunks[CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS];
+/* next chunk to fill, only accessed by the producer */
+static unsigned _head;
+/* next chunk to write, only accessed by the writer thread */
+static unsigned _tail;
+static sema_t _free = SEMA_CREATE(CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS);
+static sema_t _filled = SEMA_CREATE_LOCKED();
+
+/* held by the writer thread while accessing the storage backend, guards the
+ * variables below */
+static mutex_t _lock = MUTEX_INIT;
+static suit_storage_t *_storage;
+static const suit_manifest_t *_manifest;
+/* also read by the producer without the lock to abort early */
+static volatile int _res;
+static bool _active;
+static bool _prepare;
+
+static void _write_chunk(void)
+{
+    _chunk_t *chunk = &_chunks[_tail];
+
+    _tail = (_tail + 1) % CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS;
+
+    mutex_lock(&_lock);
+    if (_res == SUIT_OK) {
+        DEBUG("suit_pipeline: writing %u bytes at %u\n",
+              (unsigned)chunk->len, (unsigned)chunk->offset);
+        _res = suit_storage_write(_storage, _manifest, chunk->buf,
+                                  chunk->offset, chunk->len);
+    }
+    /* the write may have consumed prepared space */
+    _prepare = _active && (_res == SUIT_OK);
+    mutex_unlock(&_lock);
+
+    sema_post(&_free);
+}
+
+static bool _prepare_storage(void)
+{
+    bool more = false;
+
+    mutex_lock(&_lock);
+    if (_prepare) {
+        int res = suit_storage_prepare(_storage);
+        if (res < 0) {
+            _res = res;
+        }
+        more = _prepare = (res > 0);
+    }
+    mutex_unlock(&_lock);
+
+    return more;
+}
+
+static void *_writer_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        if (sema_try_wait(&_filled) == 0) {
+            _write_chunk();
+        }
+        else if (!_prepare_storage()) {
+            thread_flags_wait_any(FLAG_WAKEUP);
+        }
+    }
+
+    return NULL;
+}
+
+int suit_transport_pipeline_start(suit_storage_t *storage,
+                                  const suit_manifest_t *manifest)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        int pid = thread_create(_stack, sizeof(_stack),
+                                SUIT_TRANSPORT_PIPELINE_PRIO,
+                                THREAD_CREATE_STACKTEST,
+                                _writer_thread, NULL, "suit pipeline");
+        if (pid < 0) {
+            LOG_ERROR("suit_pipeline: unable to start writer thread\n");
+            return pid;
+        }
+        _pid = pid;
+    }
+
+    mutex_lock(&_lock);
+    _storage = storage;
+    _manifest = manifest;
+    _res = SUIT_OK;
+    _active = true;
+    _prepare = true;
+    mutex_unlock(&_lock);
+
+    /* start preparing while the first chunk is requested */
+    thread_flags_set(thread_get(_pid), FLAG_WAKEUP);
+    return 0;
+}
+
+int suit_transport_pipeline_write(const uint8_t *buf, size_t offset,
+                                  size_t len)
+{
+    while (len) {
+        /* abort the download early if a previous write failed */
+        int res = _res;
+        if (res != SUIT_OK) {
+            return res;
+        }
+
+        sema_wait(&_free);
+
+        _chunk_t *chunk = &_chunks[_head];
+        size_t chunk_len = len < sizeof(chunk->buf) ? len : sizeof(chunk->buf);
+
+        _head = (_head + 1) % CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS;
+        chunk->offset = offset;
+        chunk->len = chunk_len;
+        memcpy(chunk->buf, buf, chunk_len);
+
+        buf += chunk_len;
+        offset += chunk_len;
+        len -= chunk_len;
+
+        sema_post(&_filled);
+        thread_flags_set(thread_get(_pid), FLAG_WAKEUP);
+    }
+
+    return _res;
+}
+
+int suit_transport_pipeline_finish(void)
+{
+    int res;
+
+    /* all buffers are free once the last chunk is written */
+    for (unsigned i = 0; i < CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS; i++) {
+        sema_wait(&_free);
+    }
+
+    /* waits for the writer thread to leave the storage backend */
+    mutex_lock(&_lock);
+    _active = false;
+    _prepare = false;
+    res = _res;
+    mutex_unlock(&_lock);
+
+    for (unsigned i = 0; i < CONFIG_SUIT_TRANSPORT_PIPELINE_BUFFERS; i++) {
+        sema_post(&_free);
+    }
+
+    return res;
+}
@@ -0,0 +1,491 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_tslog
+ * @{
+ *
+ * @file
+ * @brief       Time-series log implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "macros/utils.h"
+#include "mtd.h"
+#include "tslog.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/**
+ * @brief   Header at the start of every sector in use
+ */
+typedef struct {
+    uint32_t magic;         /**< TSLOG_MAGIC */
+    uint32_t seq;           /**< sequence number of the sector */
+    uint32_t first_ts;      /**< time stamp of the first record */
+    uint32_t crc;           /**< CRC-16 of the fields above */
+} _sector_hdr_t;
+
+/**
+ * @brief   Header of a record, followed by the payload
+ */
+typedef struct {
+    uint32_t ts;            /**< time stamp */
+    uint16_t len;           /**< size of the payload */
+    uint16_t crc;           /**< CRC-16 of ts, len and the payload */
+} _record_hdr_t;
+
+/* size of the chunks the payload is read in to verify the CRC on recovery */
+#define CRC_CHUNK_SIZE  (32U)
+
+static uint32_t _sector_size(const tslog_t *log)
+{
+    return log->dev->pages_per_sector * log->dev->page_size;
+}
+
+static uint32_t _align(const tslog_t *log, uint32_t size)
+{
+    const uint32_t ws = log->dev->write_size;
+    return (size + ws - 1) / ws * ws;
+}
+
+static uint32_t _data_start(const tslog_t *log)
+{
+    return _align(log, sizeof(_sector_hdr_t));
+}
+
+static uint32_t _record_size(const tslog_t *log, size_t len)
+{
+    return _align(log, sizeof(_record_hdr_t) + len);
+}
+
+static int _read(tslog_t *log, uint32_t seq, uint32_t offset, void *dest, size_t len)
+{
+    mtd_dev_t *dev = log->dev;
+    uint32_t page = (seq % dev->sector_count) * dev->pages_per_sector;
+
+    return mtd_read_page(dev, dest, page, offset, len);
+}
+
+static int _program(tslog_t *log, uint32_t seq, uint32_t offset,
+                    const void *src, size_t len)
+{
+    mtd_dev_t *dev = log->dev;
+    uint32_t page = (seq % dev->sector_count) * dev->pages_per_sector;
+
+    return mtd_write_page_raw(dev, src, page, offset, len);
+}
+
+/* writes a header followed by data, padded to the write size of the device */
+static int _write(tslog_t *log, uint32_t seq, uint32_t offset,
+                  const void *hdr, size_t hdr_len, const void *data, size_t len)
+{
+    uint8_t buf[sizeof(_sector_hdr_t) + CONFIG_TSLOG_WRITE_SIZE_MAX];
+    const uint8_t *src = data;
+    const uint32_t ws = log->dev->write_size;
+    int res;
+
+    /* complete the first write unit with the start of the payload */
+    memcpy(buf, hdr, hdr_len);
+    size_t fill = hdr_len;
+    size_t n = MIN(len, _align(log, fill) - fill);
+    if (n) {
+        memcpy(buf + fill, src, n);
+        fill += n;
+        src += n;
+        len -= n;
+    }
+
+    /* this only pads if there is no payload left */
+    memset(buf + fill, 0xff, _align(log, fill) - fill);
+    fill = _align(log, fill);
+    res = _program(log, seq, offset, buf, fill);
+    if (res < 0 || len == 0) {
+        return res;
+    }
+    offset += fill;
+
+    /* write the aligned part of the payload directly */
+    n = len - len % ws;
+    if (n) {
+        res = _program(log, seq, offset, src, n);
+        if (res < 0) {
+            return res;
+        }
+        offset += n;
+        src += n;
+        len -= n;
+    }
+
+    if (len) {
+        memcpy(buf, src, len);
+        memset(buf + len, 0xff, ws - len);
+        res = _program(log, seq, offset, buf, ws);
+    }
+    return res;
+}
+
+static uint16_t _sector_crc(const _sector_hdr_t *hdr)
+{
+    return crc16_ccitt_false_calc((const void *)hdr, offsetof(_sector_hdr_t, crc));
+}
+
+static uint16_t _record_crc(const _record_hdr_t *hdr, const void *data, size_t len)
+{
+    uint16_t crc = crc16_ccitt_false_calc((const void *)hdr,
+                                          offsetof(_record_hdr_t, crc));
+    return crc16_ccitt_false_update(crc, data, len);
+}
+
+/* reads the header of the sector at position seq in the ring, returns
+ * -ENOENT if the header is not valid */
+static int _read_sector_hdr(tslog_t *log, uint32_t seq, _sector_hdr_t *hdr)
+{
+    int res = _read(log, seq, 0, hdr, sizeof(*hdr));
+    if (res < 0) {
+        return res;
+    }
+    if ((hdr->magic != TSLOG_MAGIC) || (hdr->crc != _sector_crc(hdr)) ||
+        (hdr->seq % log->dev->sector_count != seq % log->dev->sector_count)) {
+        return -ENOENT;
+    }
+    return 0;
+}
+
+static bool _is_erased(const _record_hdr_t *hdr)
+{
+    return (hdr->ts == UINT32_MAX) && (hdr->len == UINT16_MAX) &&
+           (hdr->crc == UINT16_MAX);
+}
+
+static bool _len_valid(const tslog_t *log, uint32_t offset, uint32_t len)
+{
+    return (len > 0) && (offset + _record_size(log, len) <= _sector_size(log));
+}
+
+/* finds the end of the records in the head sector */
+static int _recover_head(tslog_t *log)
+{
+    const uint32_t sector_size = _sector_size(log);
+    uint32_t offset = _data_start(log);
+
+    while (offset + sizeof(_record_hdr_t) <= sector_size) {
+        _record_hdr_t hdr;
+        uint8_t chunk[CRC_CHUNK_SIZE];
+
+        int res = _read(log, log->head, offset, &hdr, sizeof(hdr));
+        if (res < 0) {
+            return res;
+        }
+        if (_is_erased(&hdr)) {
+            break;
+        }
+        if (!_len_valid(log, offset, hdr.len)) {
+            DEBUG("tslog: invalid record at %" PRIu32 "\n", offset);
+            offset = sector_size;
+            break;
+        }
+
+        uint16_t crc = crc16_ccitt_false_calc((const void *)&hdr,
+                                              offsetof(_record_hdr_t, crc));
+        for (uint32_t pos = 0; pos < hdr.len; pos += sizeof(chunk)) {
+            size_t n = MIN(sizeof(chunk), hdr.len - pos);
+            res = _read(log, log->head, offset + sizeof(hdr) + pos, chunk, n);
+            if (res < 0) {
+                return res;
+            }
+            crc = crc16_ccitt_false_update(crc, chunk, n);
+        }
+        if (crc != hdr.crc) {
+            /* interrupted write, continue in the next sector */
+            DEBUG("tslog: CRC mismatch at %" PRIu32 "\n", offset);
+            offset = sector_size;
+            break;
+        }
+
+        log->last_ts = hdr.ts;
+        offset += _record_size(log, hdr.len);
+    }
+
+    log->offset = offset;
+    return 0;
+}
+
+int tslog_init(tslog_t *log, mtd_dev_t *dev)
+{
+    int res = mtd_init(dev);
+    if (res < 0) {
+        return res;
+    }
+    if (dev->write_size > CONFIG_TSLOG_WRITE_SIZE_MAX) {
+        return -ENOTSUP;
+    }
+
+    *log = (tslog_t) {
+        .dev = dev,
+        .lock = MUTEX_INIT,
+        .empty = true,
+    };
+
+    /* find the newest and the oldest sector */
+    for (uint32_t s = 0; s < dev->sector_count; s++) {
+        _sector_hdr_t hdr;
+
+        res = _read_sector_hdr(log, s, &hdr);
+        if (res == -ENOENT) {
+            continue;
+        }
+        if (res < 0) {
+            return res;
+        }
+        if (log->empty || hdr.seq > log->head) {
+            log->head = hdr.seq;
+            log->last_ts = hdr.first_ts;
+        }
+        if (log->empty || hdr.seq < log->tail) {
+            log->tail = hdr.seq;
+        }
+        log->empty = false;
+    }
+
+    if (log->empty) {
+        DEBUG("tslog: empty\n");
+        return 0;
+    }
+
+    res = _recover_head(log);
+    DEBUG("tslog: sectors %" PRIu32 "-%" PRIu32 ", offset %" PRIu32 "\n",
+          log->tail, log->head, log->offset);
+    return res;
+}
+
+int tslog_erase(tslog_t *log)
+{
+    mutex_lock(&log->lock);
+    int res = mtd_erase_sector(log->dev, 0, log->dev->sector_count);
+    if (res == 0) {
+        log->head = 0;
+        log->tail = 0;
+        log->offset = 0;
+        log->empty = true;
+    }
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+size_t tslog_record_size_max(const tslog_t *log)
+{
+    /* the sector size is a multiple of the write size, so a record of this
+     * size fills the sector including its padding */
+    uint32_t len = _sector_size(log) - _data_start(log) - sizeof(_record_hdr_t);
+
+    return MIN(len, UINT16_MAX - 1);
+}
+
+/* starts a new sector, erasing the oldest one if the ring is full */
+static int _next_sector(tslog_t *log, uint32_t ts)
+{
+    const uint32_t count = log->dev->sector_count;
+    uint32_t seq = log->empty ? 0 : log->head + 1;
+
+    if (!log->empty && (seq - log->tail >= count)) {
+        /* drop the oldest sector */
+        log->tail = seq - count + 1;
+    }
+
+    /* make sure no stale header remains if this fails */
+    log->offset = _sector_size(log);
+
+    int res = mtd_erase_sector(log->dev, seq % count, 1);
+    if (res < 0) {
+        return res;
+    }
+
+    _sector_hdr_t hdr = {
+        .magic = TSLOG_MAGIC,
+        .seq = seq,
+        .first_ts = ts,
+    };
+    hdr.crc = _sector_crc(&hdr);
+    res = _write(log, seq, 0, &hdr, sizeof(hdr), NULL, 0);
+    if (res < 0) {
+        return res;
+    }
+
+    if (log->empty) {
+        log->tail = seq;
+        log->empty = false;
+    }
+    log->head = seq;
+    log->offset = _data_start(log);
+    DEBUG("tslog: new sector %" PRIu32 ", oldest %" PRIu32 "\n", seq, log->tail);
+    return 0;
+}
+
+int tslog_append(tslog_t *log, uint32_t ts, const void *data, size_t len)
+{
+    int res = 0;
+
+    if (len == 0) {
+        return -EINVAL;
+    }
+    if (len > tslog_record_size_max(log)) {
+        return -EFBIG;
+    }
+
+    mutex_lock(&log->lock);
+    if (!log->empty && ts < log->last_ts) {
+        res = -EINVAL;
+        goto out;
+    }
+
+    const uint32_t size = _record_size(log, len);
+    if (log->empty || log->offset + size > _sector_size(log)) {
+        res = _next_sector(log, ts);
+        if (res < 0) {
+            goto out;
+        }
+    }
+
+    _record_hdr_t hdr = {
+        .ts = ts,
+        .len = len,
+    };
+    hdr.crc = _record_crc(&hdr, data, len);
+    res = _write(log, log->head, log->offset, &hdr, sizeof(hdr), data, len);
+    if (res < 0) {
+        /* do not append after a partially written record */
+        log->offset = _sector_size(log);
+        goto out;
+    }
+    log->offset += size;
+    log->last_ts = ts;
+
+out:
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+int tslog_iter_init(tslog_t *log, tslog_iter_t *it, uint32_t from, uint32_t to)
+{
+    int res = 0;
+
+    mutex_lock(&log->lock);
+    *it = (tslog_iter_t) {
+        .log = log,
+        .seq = log->tail,
+        .offset = _data_start(log),
+        .from = from,
+        .to = to,
+    };
+
+    if (log->empty) {
+        goto out;
+    }
+
+    /* find the last sector starting before the time range, all earlier
+     * sectors only contain older records */
+    uint32_t lo = log->tail + 1;
+    uint32_t hi = log->head + 1;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        _sector_hdr_t hdr;
+
+        res = _read_sector_hdr(log, mid, &hdr);
+        if (res < 0) {
+            res = (res == -ENOENT) ? -EIO : res;
+            goto out;
+        }
+        if (hdr.first_ts < from) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    it->seq = lo - 1;
+    DEBUG("tslog: range starts in sector %" PRIu32 "\n", it->seq);
+
+out:
+    mutex_unlock(&log->lock);
+    return res;
+}
+
+int tslog_iter_next(tslog_iter_t *it, uint32_t *ts, void *buf, size_t len)
+{
+    tslog_t *log = it->log;
+    const uint32_t sector_size = _sector_size(log);
+    int res = 0;
+
+    mutex_lock(&log->lock);
+    while (!log->empty) {
+        if (it->seq < log->tail) {
+            /* the sector was overwritten, continue with the oldest one */
+            it->seq = log->tail;
+            it->offset = _data_start(log);
+        }
+        if (it->seq > log->head ||
+            (it->seq == log->head && it->offset >= log->offset)) {
+            break;
+        }
+        if (it->offset + sizeof(_record_hdr_t) > sector_size) {
+            it->seq++;
+            it->offset = _data_start(log);
+            continue;
+        }
+
+        _record_hdr_t hdr;
+        res = _read(log, it->seq, it->offset, &hdr, sizeof(hdr));
+        if (res < 0) {
+            break;
+        }
+        if (_is_erased(&hdr) || !_len_valid(log, it->offset, hdr.len)) {
+            /* end of a sector that was not filled completely */
+            it->offset = sector_size;
+            continue;
+        }
+        if (hdr.ts > it->to) {
+            break;
+        }
+
+        const uint32_t offset = it->offset;
+        it->offset += _record_size(log, hdr.len);
+        if (hdr.ts < it->from) {
+            continue;
+        }
+        if (hdr.len > len) {
+            res = -ENOBUFS;
+            break;
+        }
+
+        res = _read(log, it->seq, offset + sizeof(hdr), buf, hdr.len);
+        if (res < 0) {
+            break;
+        }
+        if (hdr.crc != _record_crc(&hdr, buf, hdr.len)) {
+            /* the length might be corrupted as well, skip the sector */
+            DEBUG("tslog: CRC mismatch at %" PRIu32 ":%" PRIu32 "\n",
+                  it->seq, offset);
+            it->offset = sector_size;
+            continue;
+        }
+
+        if (ts) {
+            *ts = hdr.ts;
+        }
+        res = hdr.len;
+        break;
+    }
+    mutex_unlock(&log->lock);
+    return res;
+}
@@ -24,6 +24,7 @@
 #include <unistd.h> /* for STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO */
 
 #include "container.h"
+#include "macros/utils.h"
 #include "modules.h"
 #include "vfs.h"
 #include "mutex.h"
@@ -142,9 +143,189 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
  */
 static inline int _fd_is_valid(int fd);
 
+/**
+ * @internal
+ * @brief Release the read-ahead buffer of a file, if any
+ *
+ * Buffered data is discarded without adjusting the file position of the file
+ * system driver.
+ *
+ * @param[in]  fd    fd of the file
+ */
+static inline void _readahead_release(int fd);
+
+/**
+ * @internal
+ * @brief Discard buffered data of a file before the file is written or sought
+ *
+ * The file position of the file system driver is moved back by the number of
+ * buffered bytes not yet returned to the user.
+ *
+ * @param[in]  fd    fd of the file
+ *
+ * @return 0 on success
+ * @return <0 on error
+ */
+static inline int _readahead_drop(int fd);
+
 static mutex_t _mount_mutex = MUTEX_INIT;
 static mutex_t _open_mutex = MUTEX_INIT;
 
+#if IS_USED(MODULE_VFS_READAHEAD)
+/**
+ * @internal
+ * @brief Read-ahead buffer
+ */
+typedef struct {
+    uint8_t owner;      /**< fd + 1 of the owning file, 0 if unused */
+    uint16_t len;       /**< number of valid bytes in buf */
+    uint16_t off;       /**< number of bytes in buf already returned */
+    uint8_t buf[CONFIG_VFS_READAHEAD_SIZE]; /**< buffered file content */
+} _readahead_t;
+
+static _readahead_t _readahead[CONFIG_VFS_READAHEAD_NUMOF];
+static mutex_t _readahead_mutex = MUTEX_INIT;
+
+/**
+ * @internal
+ * @brief Number of consecutive small reads per open file
+ */
+static uint8_t _readahead_seq[VFS_MAX_OPEN_FILES];
+
+static _readahead_t *_readahead_get(int fd)
+{
+    for (unsigned i = 0; i < CONFIG_VFS_READAHEAD_NUMOF; i++) {
+        if (_readahead[i].owner == fd + 1) {
+            return &_readahead[i];
+        }
+    }
+    return NULL;
+}
+
+static _readahead_t *_readahead_alloc(int fd)
+{
+    _readahead_t *ra = NULL;
+
+    mutex_lock(&_readahead_mutex);
+    for (unsigned i = 0; i < CONFIG_VFS_READAHEAD_NUMOF; i++) {
+        if (_readahead[i].owner == 0) {
+            ra = &_readahead[i];
+            ra->owner = fd + 1;
+            ra->len = 0;
+            ra->off = 0;
+            break;
+        }
+    }
+    mutex_unlock(&_readahead_mutex);
+
+    return ra;
+}
+
+static size_t _readahead_size(const vfs_file_t *filp)
+{
+    if ((filp->mp == NULL) || (filp->f_op->lseek == NULL) ||
+        (filp->mp->readahead == VFS_READAHEAD_OFF)) {
+        return 0;
+    }
+    if ((filp->mp->readahead == 0) ||
+        (filp->mp->readahead > CONFIG_VFS_READAHEAD_SIZE)) {
+        return CONFIG_VFS_READAHEAD_SIZE;
+    }
+    return filp->mp->readahead;
+}
+
+static inline void _readahead_release(int fd)
+{
+    _readahead_t *ra = _readahead_get(fd);
+
+    _readahead_seq[fd] = 0;
+    if (ra != NULL) {
+        ra->owner = 0;
+    }
+}
+
+static inline int _readahead_drop(int fd)
+{
+    _readahead_t *ra = _readahead_get(fd);
+    int res = 0;
+
+    _readahead_seq[fd] = 0;
+    if (ra == NULL) {
+        return 0;
+    }
+
+    if (ra->len > ra->off) {
+        vfs_file_t *filp = &_vfs_open_files[fd];
+        off_t pos = filp->f_op->lseek(filp, -(off_t)(ra->len - ra->off), SEEK_CUR);
+        if (pos < 0) {
+            res = pos;
+        }
+    }
+    ra->owner = 0;
+
+    return res;
+}
+
+static ssize_t _readahead_read(int fd, uint8_t *dest, size_t count)
+{
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    _readahead_t *ra = _readahead_get(fd);
+    size_t size = _readahead_size(filp);
+    size_t done = 0;
+    ssize_t res;
+
+    if (ra == NULL) {
+        /* only buffer once small reads turn out to be sequential */
+        if ((count >= size) || (++_readahead_seq[fd] < 2) ||
+            ((ra = _readahead_alloc(fd)) == NULL)) {
+            return filp->f_op->read(filp, dest, count);
+        }
+    }
+
+    /* serve what is buffered */
+    done = MIN(count, (size_t)(ra->len - ra->off));
+    memcpy(dest, &ra->buf[ra->off], done);
+    ra->off += done;
+    if (done == count) {
+        return done;
+    }
+
+    /* the buffer is empty now, large reads bypass it */
+    if (count - done >= size) {
+        res = filp->f_op->read(filp, dest + done, count - done);
+    }
+    else {
+        res = filp->f_op->read(filp, ra->buf, size);
+        if (res > 0) {
+            ra->len = res;
+            ra->off = MIN(count - done, (size_t)res);
+            memcpy(dest + done, ra->buf, ra->off);
+            res = ra->off;
+        }
+        else {
+            ra->len = 0;
+            ra->off = 0;
+        }
+    }
+
+    if (res < 0) {
+        return done ? (ssize_t)done : res;
+    }
+    return done + res;
+}
+#else
+static inline void _readahead_release(int fd)
+{
+    (void)fd;
+}
+
+static inline int _readahead_drop(int fd)
+{
+    (void)fd;
+    return 0;
+}
+#endif
+
 int vfs_close(int fd)
 {
     DEBUG("vfs_close: %d\n", fd);
@@ -247,6 +428,10 @@ off_t vfs_lseek(int fd, off_t off, int whence)
         return res;
     }
     vfs_file_t *filp = &_vfs_open_files[fd];
+    res = _readahead_drop(fd);
+    if (res < 0) {
+        return res;
+    }
     if (filp->f_op->lseek == NULL) {
         /* driver does not implement lseek() */
         /* default seek functionality is naive */
@@ -332,7 +517,29 @@ ssize_t vfs_read(int fd, void *dest, size_t count)
         /* driver does not implement read() */
         return -EINVAL;
     }
+#if IS_USED(MODULE_VFS_READAHEAD)
+    return _readahead_read(fd, dest, count);
+#else
     return filp->f_op->read(filp, dest, count);
+#endif
+}
+
+int vfs_mmap(int fd, const void **addr, size_t *len)
+{
+    DEBUG("vfs_mmap: %d, %p, %p\n", fd, (void *)addr, (void *)len);
+    if ((addr == NULL) || (len == NULL)) {
+        return -EFAULT;
+    }
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->mmap == NULL) {
+        /* driver does not implement mmap() */
+        return -ENOTSUP;
+    }
+    return filp->f_op->mmap(filp, addr, len);
 }
 
 ssize_t vfs_write(int fd, const void *src, size_t count)
@@ -354,23 +561,83 @@ ssize_t vfs_write(int fd, const void *src, size_t count)
         /* driver does not implement write() */
         return -EINVAL;
     }
+    res = _readahead_drop(fd);
+    if (res < 0) {
+        return res;
+    }
     return filp->f_op->write(filp, src, count);
 }
 
-ssize_t vfs_write_iol(int fd, const iolist_t *snips)
+ssize_t vfs_read_iol(int fd, const iolist_t *snips)
 {
-    int res, sum = 0;
-
-    while (snips) {
-        res = vfs_write(fd, snips->iol_base, snips->iol_len);
-        if (res < 0) {
-            return res;
+    DEBUG("vfs_read_iol: %d, %p\n", fd, (void *)snips);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->readv == NULL) {
+        /* driver does not implement readv(), read snip by snip */
+        ssize_t sum = 0;
+        while (snips) {
+            ssize_t len = vfs_read(fd, snips->iol_base, snips->iol_len);
+            if (len < 0) {
+                return sum ? sum : len;
+            }
+            sum += len;
+            if ((size_t)len < snips->iol_len) {
+                /* end of file */
+                break;
+            }
+            snips = snips->iol_next;
         }
-        sum += res;
-        snips = snips->iol_next;
+        return sum;
+    }
+    if (((filp->flags & O_ACCMODE) != O_RDONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for reading */
+        return -EBADF;
     }
+    res = _readahead_drop(fd);
+    if (res < 0) {
+        return res;
+    }
+    return filp->f_op->readv(filp, snips);
+}
 
-    return sum;
+ssize_t vfs_write_iol(int fd, const iolist_t *snips)
+{
+    DEBUG_NOT_STDOUT(fd, "vfs_write_iol: %d, %p\n", fd, (void *)snips);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    if (filp->f_op->writev == NULL) {
+        /* driver does not implement writev(), write snip by snip */
+        ssize_t sum = 0;
+        while (snips) {
+            ssize_t len = vfs_write(fd, snips->iol_base, snips->iol_len);
+            if (len < 0) {
+                return sum ? sum : len;
+            }
+            sum += len;
+            if ((size_t)len < snips->iol_len) {
+                /* volume is full */
+                break;
+            }
+            snips = snips->iol_next;
+        }
+        return sum;
+    }
+    if (((filp->flags & O_ACCMODE) != O_WRONLY) & ((filp->flags & O_ACCMODE) != O_RDWR)) {
+        /* File not open for writing */
+        return -EBADF;
+    }
+    res = _readahead_drop(fd);
+    if (res < 0) {
+        return res;
+    }
+    return filp->f_op->writev(filp, snips);
 }
 
 int vfs_fsync(int fd)
@@ -1020,6 +1287,7 @@ static inline void _free_fd(int fd)
     if (_vfs_open_files[fd].mp != NULL) {
         atomic_fetch_sub(&_vfs_open_files[fd].mp->open_files, 1);
     }
+    _readahead_release(fd);
     _vfs_open_files[fd].pid = KERNEL_PID_UNDEF;
 }
 
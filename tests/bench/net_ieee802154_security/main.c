@@ -0,0 +1,141 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for IEEE 802.15.4 frame security
+ *
+ * Frames are secured with the default security level (ENC-MIC-64) and the
+ * default key, using the software implementation.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/ieee802154_security.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define HEADER_SIZE     (21U)
+#define PAYLOAD_SIZE    (100U)
+
+/* data frame with security enabled and long addresses, the auxiliary
+ * security header is appended */
+static const uint8_t _header[HEADER_SIZE] = {
+    0x49, 0xcc, 0x01, 0x23, 0x00,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+};
+
+#define SRC_ADDRESS     (&_header[13])
+
+/* MIC of the payload counting up from 0 with frame counter 0 */
+static const uint8_t _expected_mic[] = {
+    0xcc, 0x7e, 0x4d, 0xf4, 0x38, 0xa8, 0xb6, 0x42,
+};
+
+static ieee802154_sec_context_t _ctx;
+static uint8_t _frame[HEADER_SIZE + IEEE802154_SEC_MAX_AUX_HDR_LEN +
+                      PAYLOAD_SIZE + IEEE802154_SEC_MAX_MAC_SIZE];
+
+/* returns the size of the frame */
+static uint16_t _encrypt(uint16_t payload_size)
+{
+    uint8_t header_size = HEADER_SIZE;
+    uint8_t mic_size;
+
+    memcpy(_frame, _header, sizeof(_header));
+    /* the auxiliary header is 5 bytes with implicit key mode */
+    uint8_t *payload = &_frame[HEADER_SIZE + 5];
+    ieee802154_sec_encrypt_frame(&_ctx, _frame, &header_size,
+                                 payload, payload_size,
+                                 &payload[payload_size], &mic_size,
+                                 SRC_ADDRESS);
+    return header_size + payload_size + mic_size;
+}
+
+static int _decrypt(uint16_t frame_size)
+{
+    uint8_t header_size = HEADER_SIZE;
+    uint8_t *payload;
+    uint16_t payload_size;
+    uint8_t *mic;
+    uint8_t mic_size;
+
+    return ieee802154_sec_decrypt_frame(&_ctx, frame_size, _frame,
+                                        &header_size, &payload, &payload_size,
+                                        &mic, &mic_size, SRC_ADDRESS);
+}
+
+static void _bench(uint16_t payload_size)
+{
+    unsigned runs = 0;
+    uint16_t frame_size = 0;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        frame_size = _encrypt(payload_size);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_str("encrypt, ");
+    print_u32_dec(payload_size);
+    print_str(" B: ");
+    print_u32_dec((stop - start) / runs);
+    print_str(" us/frame\n");
+
+    /* the decrypted frame is encrypted again, so that the MIC check of every
+     * run succeeds */
+    runs = 0;
+    start = ztimer_now(ZTIMER_USEC);
+    do {
+        _decrypt(frame_size);
+        frame_size = _encrypt(payload_size);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_str("decrypt and encrypt, ");
+    print_u32_dec(payload_size);
+    print_str(" B: ");
+    print_u32_dec((stop - start) / runs);
+    print_str(" us/frame\n");
+}
+
+int main(void)
+{
+    uint8_t *payload = &_frame[HEADER_SIZE + 5];
+
+    ieee802154_sec_init(&_ctx);
+    for (unsigned i = 0; i < PAYLOAD_SIZE; i++) {
+        payload[i] = i;
+    }
+
+    print_str("Verifying MIC and round trip: ");
+    uint16_t frame_size = _encrypt(PAYLOAD_SIZE);
+    int ok = memcmp(&payload[PAYLOAD_SIZE], _expected_mic,
+                    sizeof(_expected_mic)) == 0;
+    ok = ok && (_decrypt(frame_size) == IEEE802154_SEC_OK);
+    for (unsigned i = 0; i < PAYLOAD_SIZE; i++) {
+        ok = ok && (payload[i] == i);
+    }
+    print_str(ok ? "OK\n" : "FAIL\n");
+
+    _bench(16);
+    _bench(PAYLOAD_SIZE);
+
+    print_str("DONE\n");
+    return 0;
+}
+/** @} */
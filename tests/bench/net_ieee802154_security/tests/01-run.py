@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Verifying MIC and round trip: OK\r\n")
+    for size in (16, 100):
+        child.expect(r"encrypt, {} B: [0-9]+ us/frame\r\n".format(size))
+        child.expect(r"decrypt and encrypt, {} B: [0-9]+ us/frame\r\n"
+                     .format(size))
+    child.expect_exact("DONE\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
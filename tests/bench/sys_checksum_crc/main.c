@@ -0,0 +1,126 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the CRC16-CCITT and CRC-32 implementations
+ *
+ * The number of look-up tables is selected with `CRC_FAST_SLICES`, CRC-32
+ * and CRC-32C use the CRC peripheral if the board provides one.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "clk.h"
+#include "container.h"
+#include "fmt.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define LARGE_SIZE      (1024U)
+/* typical size of a frame */
+#define SMALL_SIZE      (64U)
+
+/* one more byte for unaligned input */
+static uint8_t _input[LARGE_SIZE + 1];
+static volatile uint32_t _crc;
+
+typedef uint32_t (*bench_func_t)(const uint8_t *input, size_t len);
+
+static uint32_t _crc16_kermit(const uint8_t *input, size_t len)
+{
+    return crc16_ccitt_kermit_calc(input, len);
+}
+
+static uint32_t _crc16_false(const uint8_t *input, size_t len)
+{
+    return crc16_ccitt_false_calc(input, len);
+}
+
+static uint32_t _crc32(const uint8_t *input, size_t len)
+{
+    return crc32(input, len);
+}
+
+static uint32_t _crc32c(const uint8_t *input, size_t len)
+{
+    return crc32c(input, len);
+}
+
+/* checksums of LARGE_SIZE bytes counting up from 0 modulo 256 */
+static const struct {
+    const char *name;
+    bench_func_t func;
+    uint32_t expected;
+} _algos[] = {
+    { "CRC16-CCITT-KERMIT", _crc16_kermit, 0x0033 },
+    { "CRC16-CCITT-FALSE", _crc16_false, 0x758f },
+    { "CRC-32", _crc32, 0xb70b4c26 },
+    { "CRC-32C", _crc32c, 0x2cdf6e8f },
+};
+
+static void _bench(const char *name, bench_func_t func, const uint8_t *input,
+                   size_t len)
+{
+    unsigned runs = 0;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        _crc = func(input, len);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_str(name);
+    print_str(", ");
+    print_u32_dec(len);
+    print_str(" B");
+    if (input != _input) {
+        print_str(" unaligned");
+    }
+    print_str(": ");
+    print_u64_dec((uint64_t)runs * len * US_PER_SEC / (stop - start));
+    print_str(" B/s, ");
+    /* in tenths of a cycle */
+    uint64_t cycles = (uint64_t)coreclk() * (stop - start) * 10 /
+                      ((uint64_t)runs * len * US_PER_SEC);
+    print_u64_dec(cycles / 10);
+    print_str(".");
+    print_u32_dec(cycles % 10);
+    print_str(" cycles/B\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(_input); i++) {
+        _input[i] = i;
+    }
+
+    print_str("Verifying checksums: ");
+    int ok = 1;
+    for (unsigned i = 0; i < ARRAY_SIZE(_algos); i++) {
+        ok = ok && (_algos[i].func(_input, LARGE_SIZE) == _algos[i].expected);
+    }
+    print_str(ok ? "OK\n" : "FAIL\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_algos); i++) {
+        _bench(_algos[i].name, _algos[i].func, _input, SMALL_SIZE);
+        _bench(_algos[i].name, _algos[i].func, _input, LARGE_SIZE);
+        _bench(_algos[i].name, _algos[i].func, &_input[1], LARGE_SIZE);
+    }
+
+    print_str("DONE\n");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Verifying checksums: OK\r\n")
+    for name in ("CRC16-CCITT-KERMIT", "CRC16-CCITT-FALSE", "CRC-32",
+                 "CRC-32C"):
+        for size, suffix in ((64, ""), (1024, ""), (1024, " unaligned")):
+            child.expect(r"{}, {} B{}: [0-9]+ B/s, [0-9]+\.[0-9] cycles/B\r\n"
+                         .format(name, size, suffix))
+    child.expect_exact("DONE\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
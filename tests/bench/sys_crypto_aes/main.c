@@ -0,0 +1,154 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for AES modes of operation
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "clk.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "fmt.h"
+#include "timex.h"
+#include "ztimer.h"
+
+/* typical IEEE 802.15.4 and DTLS record payload sizes */
+#define SMALL_SIZE      (96U)
+#define LARGE_SIZE      (1024U)
+
+#define MAC_LEN         (8U)
+#define LEN_ENCODING    (2U)
+
+static const uint8_t _key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+static const uint8_t _nonce[13] = { 0 };
+static const uint8_t _adata[16] = { 0 };
+
+static cipher_t _cipher;
+static uint8_t _input[LARGE_SIZE];
+static uint8_t _output[LARGE_SIZE + MAC_LEN];
+static uint8_t _plain[LARGE_SIZE];
+
+typedef void (*bench_func_t)(size_t len);
+
+static void _blockwise(size_t len)
+{
+    for (size_t i = 0; i < len; i += 16) {
+        cipher_encrypt(&_cipher, &_input[i], &_output[i]);
+    }
+}
+
+static void _blocks(size_t len)
+{
+    cipher_encrypt_blocks(&_cipher, _input, _output, len / 16);
+}
+
+static void _ctr(size_t len)
+{
+    uint8_t nonce_counter[16] = { 0 };
+
+    cipher_encrypt_ctr(&_cipher, nonce_counter, 8, _input, len, _output);
+}
+
+static void _cbc_encrypt(size_t len)
+{
+    uint8_t iv[16] = { 0 };
+
+    cipher_encrypt_cbc(&_cipher, iv, _input, len, _output);
+}
+
+static void _cbc_decrypt(size_t len)
+{
+    uint8_t iv[16] = { 0 };
+
+    cipher_decrypt_cbc(&_cipher, iv, _input, len, _output);
+}
+
+static void _ccm_encrypt(size_t len)
+{
+    cipher_encrypt_ccm(&_cipher, _adata, sizeof(_adata), MAC_LEN, LEN_ENCODING,
+                       _nonce, sizeof(_nonce), _input, len, _output);
+}
+
+static void _ccm_decrypt(size_t len)
+{
+    cipher_decrypt_ccm(&_cipher, _adata, sizeof(_adata), MAC_LEN, LEN_ENCODING,
+                       _nonce, sizeof(_nonce), _output, len + MAC_LEN, _plain);
+}
+
+static void _bench(const char *name, bench_func_t func, size_t len)
+{
+    unsigned runs = 0;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        func(len);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_str(name);
+    print_str(", ");
+    print_u32_dec(len);
+    print_str(" B: ");
+    print_u64_dec((uint64_t)runs * len * US_PER_SEC / (stop - start));
+    print_str(" B/s, ");
+    /* in tenths of a cycle */
+    uint64_t cycles = (uint64_t)coreclk() * (stop - start) * 10 /
+                      ((uint64_t)runs * len * US_PER_SEC);
+    print_u64_dec(cycles / 10);
+    print_str(".");
+    print_u32_dec(cycles % 10);
+    print_str(" cycles/B\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(_input); i++) {
+        _input[i] = i;
+    }
+    cipher_init(&_cipher, CIPHER_AES, _key, sizeof(_key));
+
+    print_str("Verifying CCM round trip: ");
+    _ccm_encrypt(LARGE_SIZE);
+    if ((cipher_decrypt_ccm(&_cipher, _adata, sizeof(_adata), MAC_LEN,
+                            LEN_ENCODING, _nonce, sizeof(_nonce), _output,
+                            LARGE_SIZE + MAC_LEN, _plain) == LARGE_SIZE) &&
+        (memcmp(_plain, _input, LARGE_SIZE) == 0)) {
+        print_str("OK\n");
+    }
+    else {
+        print_str("FAIL\n");
+    }
+
+    _bench("AES block by block", _blockwise, LARGE_SIZE);
+    _bench("AES multi-block", _blocks, LARGE_SIZE);
+    _bench("CTR", _ctr, LARGE_SIZE);
+    _bench("CBC encrypt", _cbc_encrypt, LARGE_SIZE);
+    _bench("CBC decrypt", _cbc_decrypt, LARGE_SIZE);
+    _bench("CCM encrypt", _ccm_encrypt, SMALL_SIZE);
+    _bench("CCM encrypt", _ccm_encrypt, LARGE_SIZE);
+    /* decrypt the output of the last encryption to have a valid MAC */
+    _bench("CCM decrypt", _ccm_decrypt, LARGE_SIZE);
+
+    print_str("DONE\n");
+    return 0;
+}
+/** @} */
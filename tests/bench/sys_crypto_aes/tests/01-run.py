@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Verifying CCM round trip: OK\r\n")
+    for name, size in (("AES block by block", 1024), ("AES multi-block", 1024),
+                       ("CTR", 1024), ("CBC encrypt", 1024),
+                       ("CBC decrypt", 1024), ("CCM encrypt", 96),
+                       ("CCM encrypt", 1024), ("CCM decrypt", 1024)):
+        child.expect(r"{}, {} B: [0-9]+ B/s, [0-9]+\.[0-9] cycles/B\r\n".format(name, size))
+    child.expect_exact("DONE\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,128 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for ChaCha20-Poly1305 and Poly1305
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "clk.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/poly1305.h"
+#include "fmt.h"
+#include "timex.h"
+#include "ztimer.h"
+
+/* a DTLS record with a small payload */
+#define SMALL_SIZE      (64U)
+#define LARGE_SIZE      (1024U)
+
+static const uint8_t _nonce[CHACHA20POLY1305_NONCE_BYTES] = { 0 };
+static const uint8_t _aad[16] = { 0 };
+
+/* tag of LARGE_SIZE bytes counting up from 0 modulo 256, with the key
+ * counting up from 0 */
+static const uint8_t _expected_tag[CHACHA20POLY1305_TAG_BYTES] = {
+    0x72, 0xf3, 0x93, 0xf8, 0x54, 0x22, 0x52, 0xea,
+    0x4f, 0x60, 0xc4, 0x52, 0x7a, 0xaa, 0xd3, 0x72,
+};
+
+static uint8_t _key[CHACHA20POLY1305_KEY_BYTES];
+static uint8_t _input[LARGE_SIZE];
+static uint8_t _output[LARGE_SIZE + CHACHA20POLY1305_TAG_BYTES];
+static uint8_t _plain[LARGE_SIZE];
+
+typedef void (*bench_func_t)(size_t len);
+
+static void _poly1305(size_t len)
+{
+    poly1305_auth(_output, _input, len, _key);
+}
+
+static void _encrypt(size_t len)
+{
+    chacha20poly1305_encrypt(_output, _input, len, _aad, sizeof(_aad), _key,
+                             _nonce);
+}
+
+static void _decrypt(size_t len)
+{
+    size_t plain_len;
+
+    chacha20poly1305_decrypt(_output, len + CHACHA20POLY1305_TAG_BYTES,
+                             _plain, &plain_len, _aad, sizeof(_aad), _key,
+                             _nonce);
+}
+
+static void _bench(const char *name, bench_func_t func, size_t len)
+{
+    unsigned runs = 0;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        func(len);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_str(name);
+    print_str(", ");
+    print_u32_dec(len);
+    print_str(" B: ");
+    print_u64_dec((uint64_t)runs * len * US_PER_SEC / (stop - start));
+    print_str(" B/s, ");
+    /* in tenths of a cycle */
+    uint64_t cycles = (uint64_t)coreclk() * (stop - start) * 10 /
+                      ((uint64_t)runs * len * US_PER_SEC);
+    print_u64_dec(cycles / 10);
+    print_str(".");
+    print_u32_dec(cycles % 10);
+    print_str(" cycles/B\n");
+}
+
+int main(void)
+{
+    size_t plain_len;
+
+    for (size_t i = 0; i < sizeof(_key); i++) {
+        _key[i] = i;
+    }
+    for (size_t i = 0; i < sizeof(_input); i++) {
+        _input[i] = i;
+    }
+
+    print_str("Verifying tag and round trip: ");
+    _encrypt(LARGE_SIZE);
+    if ((memcmp(&_output[LARGE_SIZE], _expected_tag,
+                sizeof(_expected_tag)) == 0) &&
+        chacha20poly1305_decrypt(_output, sizeof(_output), _plain, &plain_len,
+                                 _aad, sizeof(_aad), _key, _nonce) &&
+        (memcmp(_input, _plain, LARGE_SIZE) == 0)) {
+        print_str("OK\n");
+    }
+    else {
+        print_str("FAIL\n");
+    }
+
+    _bench("Poly1305", _poly1305, SMALL_SIZE);
+    _bench("Poly1305", _poly1305, LARGE_SIZE);
+    _bench("ChaCha20-Poly1305 encrypt", _encrypt, SMALL_SIZE);
+    _bench("ChaCha20-Poly1305 encrypt", _encrypt, LARGE_SIZE);
+    _bench("ChaCha20-Poly1305 decrypt", _decrypt, LARGE_SIZE);
+
+    print_str("DONE\n");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,118 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for Ed25519 signature verification
+ *
+ * Compares edsign_verify() of the c25519 package to a verification with a
+ * precomputed @ref sys_ed25519_verify context. The size of the context is
+ * selected with `ED25519_VERIFY_TEETH`.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "clk.h"
+#include "ed25519_verify.h"
+#include "edsign.h"
+#include "fmt.h"
+#include "timex.h"
+#include "ztimer.h"
+
+/* e.g. a digest and some metadata */
+#define MSG_SIZE        (64U)
+
+/* public key of RFC 8032, section 7.1, test 1 */
+static const uint8_t _pub1[] = {
+    0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7,
+    0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+    0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25,
+    0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a,
+};
+
+/* signature of MSG_SIZE bytes counting up from 0 */
+static const uint8_t _sig[] = {
+    0x2d, 0xc5, 0x73, 0x6c, 0x51, 0x88, 0xaa, 0x2a,
+    0x61, 0x57, 0x68, 0xc4, 0x65, 0xcf, 0x49, 0x93,
+    0x4f, 0x56, 0x1c, 0xbf, 0xdd, 0xc4, 0xeb, 0xf8,
+    0xcf, 0xb6, 0xcf, 0x32, 0x3e, 0xfc, 0x2e, 0x71,
+    0xc9, 0x1b, 0x48, 0xcb, 0x26, 0xc2, 0x69, 0x9c,
+    0xe2, 0xf5, 0x6e, 0x24, 0xac, 0xe6, 0xdc, 0xc5,
+    0x1f, 0x9c, 0xc7, 0xfb, 0x99, 0x2a, 0x55, 0xc8,
+    0x33, 0xc0, 0x88, 0x91, 0x11, 0xf4, 0xba, 0x03,
+};
+static uint8_t _msg[MSG_SIZE];
+static ed25519_verify_ctx_t _ctx;
+static volatile int _res;
+
+typedef void (*bench_func_t)(void);
+
+static void _edsign_verify(void)
+{
+    _res = edsign_verify(_sig, _pub1, _msg, sizeof(_msg));
+}
+
+static void _ctx_init(void)
+{
+    _res = ed25519_verify_init(&_ctx, _pub1);
+}
+
+static void _ctx_verify(void)
+{
+    _res = ed25519_verify(&_ctx, _sig, _msg, sizeof(_msg));
+}
+
+static void _bench(const char *name, bench_func_t func)
+{
+    unsigned runs = 0;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        func();
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    uint32_t usec = (stop - start) / runs;
+
+    print_str(name);
+    print_str(": ");
+    print_u32_dec(usec);
+    print_str(" us, ");
+    print_u64_dec((uint64_t)coreclk() * usec / US_PER_SEC);
+    print_str(" cycles\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(_msg); i++) {
+        _msg[i] = i;
+    }
+
+    print_str("Verifying signatures: ");
+    int ok = edsign_verify(_sig, _pub1, _msg, sizeof(_msg)) &&
+             (ed25519_verify_init(&_ctx, _pub1) == 0) &&
+             (ed25519_verify(&_ctx, _sig, _msg, sizeof(_msg)) == 0);
+    print_str(ok ? "OK\n" : "FAIL\n");
+
+    print_str("Context size: ");
+    print_u32_dec(sizeof(_ctx));
+    print_str(" B\n");
+
+    _bench("edsign_verify", _edsign_verify);
+    _bench("ed25519_verify_init", _ctx_init);
+    _bench("ed25519_verify", _ctx_verify);
+
+    print_str("DONE\n");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,20 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Verifying signatures: OK\r\n")
+    child.expect(r"Context size: [0-9]+ B\r\n")
+    for name in ("edsign_verify", "ed25519_verify_init", "ed25519_verify"):
+        child.expect(r"{}: [0-9]+ us, [0-9]+ cycles\r\n".format(name))
+    child.expect_exact("DONE\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
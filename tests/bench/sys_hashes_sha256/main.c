@@ -0,0 +1,112 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for SHA-256
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "clk.h"
+#include "fmt.h"
+#include "hashes/sha256.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#define LARGE_SIZE      (4096U)
+/* typical size of chunks received by a firmware update transport */
+#define CHUNK_SIZE      (100U)
+
+/* SHA-256 of 4096 bytes counting up from 0 modulo 256 */
+static const uint8_t _expected[SHA256_DIGEST_LENGTH] = {
+    0xc8, 0xf5, 0xd0, 0x34, 0x1d, 0x54, 0xd9, 0x51,
+    0xa7, 0x1b, 0x13, 0x6e, 0x6e, 0x2a, 0xfc, 0xb1,
+    0x4d, 0x11, 0xed, 0x84, 0x89, 0xa7, 0xae, 0x12,
+    0x6a, 0x8f, 0xee, 0x0d, 0xf6, 0xec, 0xf1, 0x93,
+};
+
+/* one more byte for unaligned input */
+static uint8_t _input[LARGE_SIZE + 1];
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+
+typedef void (*bench_func_t)(const uint8_t *input, size_t len);
+
+static void _oneshot(const uint8_t *input, size_t len)
+{
+    sha256(input, len, _digest);
+}
+
+static void _chunked(const uint8_t *input, size_t len)
+{
+    sha256_context_t ctx;
+
+    sha256_init(&ctx);
+    for (size_t i = 0; i < len; i += CHUNK_SIZE) {
+        sha256_update(&ctx, &input[i],
+                      (len - i < CHUNK_SIZE) ? len - i : CHUNK_SIZE);
+    }
+    sha256_final(&ctx, _digest);
+}
+
+static void _bench(const char *name, bench_func_t func, const uint8_t *input,
+                   size_t len)
+{
+    unsigned runs = 0;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        func(input, len);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_str(name);
+    print_str(", ");
+    print_u32_dec(len);
+    print_str(" B: ");
+    print_u64_dec((uint64_t)runs * len * US_PER_SEC / (stop - start));
+    print_str(" B/s, ");
+    /* in tenths of a cycle */
+    uint64_t cycles = (uint64_t)coreclk() * (stop - start) * 10 /
+                      ((uint64_t)runs * len * US_PER_SEC);
+    print_u64_dec(cycles / 10);
+    print_str(".");
+    print_u32_dec(cycles % 10);
+    print_str(" cycles/B\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(_input); i++) {
+        _input[i] = i;
+    }
+
+    print_str("Verifying digest: ");
+    _chunked(_input, LARGE_SIZE);
+    if (memcmp(_digest, _expected, sizeof(_digest)) == 0) {
+        print_str("OK\n");
+    }
+    else {
+        print_str("FAIL\n");
+    }
+
+    _bench("SHA-256", _oneshot, _input, 64);
+    _bench("SHA-256", _oneshot, _input, LARGE_SIZE);
+    _bench("SHA-256 unaligned", _oneshot, &_input[1], LARGE_SIZE);
+    _bench("SHA-256 chunked", _chunked, _input, LARGE_SIZE);
+
+    print_str("DONE\n");
+    return 0;
+}
+/** @} */
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Verifying digest: OK\r\n")
+    for name, size in (("SHA-256", 64), ("SHA-256", 4096),
+                       ("SHA-256 unaligned", 4096),
+                       ("SHA-256 chunked", 4096)):
+        child.expect(r"{}, {} B: [0-9]+ B/s, [0-9]+\.[0-9] cycles/B\r\n"
+                     .format(name, size))
+    child.expect_exact("DONE\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
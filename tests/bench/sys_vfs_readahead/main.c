@@ -0,0 +1,153 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for sequential reads with VFS read-ahead
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "fs/littlefs2_fs.h"
+#include "mtd_emulated.h"
+#include "timex.h"
+#include "vfs.h"
+#include "ztimer.h"
+
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT    16
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE       128
+#endif
+
+#define FILE_SIZE       (4096U)
+#define FILE_NAME       "/bench/data"
+
+MTD_EMULATED_DEV(0, SECTOR_COUNT, PAGE_PER_SECTOR, PAGE_SIZE);
+
+static littlefs2_desc_t _fs_desc = {
+    .dev = &mtd_emulated_dev0.base,
+};
+
+static vfs_mount_t _mount = {
+    .fs = &littlefs2_file_system,
+    .mount_point = "/bench",
+    .private_data = &_fs_desc,
+};
+
+static uint8_t _buf[FILE_SIZE];
+
+static uint8_t _pattern(size_t i)
+{
+    return (uint8_t)(i * 7 + (i >> 8));
+}
+
+static int _create_file(void)
+{
+    for (size_t i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = _pattern(i);
+    }
+
+    int fd = vfs_open(FILE_NAME, O_CREAT | O_TRUNC | O_WRONLY, 0);
+    if (fd < 0) {
+        return fd;
+    }
+    int res = vfs_write(fd, _buf, sizeof(_buf));
+    vfs_close(fd);
+
+    return (res == sizeof(_buf)) ? 0 : -1;
+}
+
+static int _read_file(size_t chunk, bool verify)
+{
+    size_t total = 0;
+    int fd = vfs_open(FILE_NAME, O_RDONLY, 0);
+
+    if (fd < 0) {
+        return fd;
+    }
+
+    memset(_buf, 0, sizeof(_buf));
+    while (total < FILE_SIZE) {
+        int res = vfs_read(fd, &_buf[total], chunk);
+        if (res <= 0) {
+            break;
+        }
+        total += res;
+    }
+    vfs_close(fd);
+
+    if (total != FILE_SIZE) {
+        return -1;
+    }
+    if (verify) {
+        for (size_t i = 0; i < total; i++) {
+            if (_buf[i] != _pattern(i)) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void _bench(size_t chunk, bool readahead)
+{
+    unsigned runs = 0;
+
+    _mount.readahead = readahead ? 0 : VFS_READAHEAD_OFF;
+
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    uint32_t stop;
+    do {
+        _read_file(chunk, false);
+        runs++;
+        stop = ztimer_now(ZTIMER_USEC);
+    } while (stop - start < US_PER_SEC);
+
+    print_u32_dec(chunk);
+    print_str(" B reads, read-ahead ");
+    print_str(readahead ? "on: " : "off: ");
+    print_u64_dec((uint64_t)runs * FILE_SIZE * US_PER_SEC / (stop - start));
+    print_str(" B/s\n");
+}
+
+int main(void)
+{
+    vfs_format(&_mount);
+    if (vfs_mount(&_mount) < 0 || _create_file() < 0) {
+        print_str("Creating test file failed\n");
+        return 1;
+    }
+
+    print_str("Verifying file content: ");
+    if ((_read_file(64, true) == 0) && (_read_file(FILE_SIZE, true) == 0)) {
+        print_str("OK\n");
+    }
+    else {
+        print_str("FAIL\n");
+    }
+
+    _bench(64, false);
+    _bench(64, true);
+    _bench(FILE_SIZE, false);
+    _bench(FILE_SIZE, true);
+
+    vfs_umount(&_mount, false);
+    print_str("DONE\n");
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("Verifying file content: OK\r\n")
+    for size in (64, 4096):
+        for mode in ("off", "on"):
+            child.expect(r"{} B reads, read-ahead {}: [0-9]+ B/s\r\n"
+                         .format(size, mode))
+    child.expect_exact("DONE\r\n")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
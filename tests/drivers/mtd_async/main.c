@@ -0,0 +1,205 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_async module test
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "event.h"
+#include "mtd.h"
+#include "mtd_async.h"
+#include "mtd_emulated.h"
+
+#define SECTOR_COUNT        (4U)
+#define PAGE_PER_SECTOR     (4U)
+#define PAGE_SIZE           (64U)
+#define SECTOR_SIZE         (PAGE_PER_SECTOR * PAGE_SIZE)
+
+MTD_EMULATED_DEV(0, SECTOR_COUNT, PAGE_PER_SECTOR, PAGE_SIZE);
+
+static mtd_dev_t *_dev = &mtd_emulated_dev0.base;
+
+static event_queue_t _queue;
+static event_t _done;
+static mtd_async_t _op;
+
+static uint8_t _pattern[SECTOR_SIZE];
+static uint8_t _buf[SECTOR_SIZE];
+
+/* block until the completion event of _op was posted */
+static void _wait_done(void)
+{
+    TEST_ASSERT(event_wait(&_queue) == &_done);
+    TEST_ASSERT(!mtd_async_pending(&_op));
+}
+
+static void set_up(void)
+{
+    mtd_async_init(&_op, &_queue, &_done);
+
+    memset(mtd_emulated_dev0.memory, 0xff, mtd_emulated_dev0.size);
+    for (unsigned i = 0; i < sizeof(_pattern); i++) {
+        _pattern[i] = i;
+    }
+    memset(_buf, 0, sizeof(_buf));
+}
+
+static void test_mtd_async_erase(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _pattern, PAGE_PER_SECTOR,
+                                                0, SECTOR_SIZE));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_op, _dev, 1, 1));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&_op));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_read_page(_dev, _buf, PAGE_PER_SECTOR, 0,
+                                           SECTOR_SIZE));
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, _buf[i]);
+    }
+}
+
+static void test_mtd_async_write_raw(void)
+{
+    /* across a page boundary */
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_write_page_raw(&_op, _dev, _pattern, 2,
+                                                      PAGE_SIZE / 2, PAGE_SIZE));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&_op));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_read_page(_dev, _buf, 2, PAGE_SIZE / 2,
+                                           PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, PAGE_SIZE));
+}
+
+static void test_mtd_async_write(void)
+{
+    /* the sector is not erased, mtd_write_page() has to erase it */
+    memset(mtd_emulated_dev0.memory, 0, mtd_emulated_dev0.size);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_write_page(&_op, _dev, _pattern, 0, 16,
+                                                  PAGE_SIZE));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&_op));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_read_page(_dev, _buf, 0, 0, SECTOR_SIZE));
+    for (unsigned i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _buf[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, &_buf[16], PAGE_SIZE));
+}
+
+static void test_mtd_async_read(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _pattern, 4, 0,
+                                                SECTOR_SIZE));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_read_page(&_op, _dev, _buf, 4, 0,
+                                                 SECTOR_SIZE));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&_op));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, SECTOR_SIZE));
+}
+
+static void test_mtd_async_error(void)
+{
+    /* errors of the blocking function are passed on */
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_op, _dev, SECTOR_COUNT - 1,
+                                                    2));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_async_result(&_op));
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_read_page(&_op, _dev, _buf,
+                                                 SECTOR_COUNT * PAGE_PER_SECTOR,
+                                                 0, 1));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_async_result(&_op));
+}
+
+static void test_mtd_async_busy(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_op, _dev, 0, 1));
+
+    /* the operation runs once this thread blocks */
+    TEST_ASSERT(mtd_async_pending(&_op));
+    TEST_ASSERT_EQUAL_INT(-EINPROGRESS, mtd_async_result(&_op));
+
+    TEST_ASSERT_EQUAL_INT(-EBUSY, mtd_async_read_page(&_op, _dev, _buf, 0, 0, 1));
+    TEST_ASSERT_EQUAL_INT(-EBUSY, mtd_async_write_page(&_op, _dev, _pattern, 0,
+                                                       0, 1));
+    TEST_ASSERT_EQUAL_INT(-EBUSY, mtd_async_write_page_raw(&_op, _dev, _pattern,
+                                                           0, 0, 1));
+    TEST_ASSERT_EQUAL_INT(-EBUSY, mtd_async_erase_sector(&_op, _dev, 1, 1));
+
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&_op));
+
+    /* the descriptor can be reused after completion */
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_op, _dev, 1, 1));
+    _wait_done();
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&_op));
+}
+
+static void test_mtd_async_no_done(void)
+{
+    mtd_async_t silent;
+
+    mtd_async_init(&silent, &_queue, NULL);
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_write_page_raw(&silent, _dev, _pattern,
+                                                      0, 0, PAGE_SIZE));
+
+    /* operations are executed in order, the write has completed when _op has */
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_read_page(&_op, _dev, _buf, 0, 0,
+                                                 PAGE_SIZE));
+    _wait_done();
+    TEST_ASSERT(!mtd_async_pending(&silent));
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_result(&silent));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_pattern, _buf, PAGE_SIZE));
+
+    /* no event was posted for the write */
+    TEST_ASSERT(event_get(&_queue) == NULL);
+}
+
+static Test *tests_mtd_async(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_async_erase),
+        new_TestFixture(test_mtd_async_write_raw),
+        new_TestFixture(test_mtd_async_write),
+        new_TestFixture(test_mtd_async_read),
+        new_TestFixture(test_mtd_async_error),
+        new_TestFixture(test_mtd_async_busy),
+        new_TestFixture(test_mtd_async_no_done),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_async_tests, set_up, NULL, fixtures);
+    return (Test *)&mtd_async_tests;
+}
+
+int main(void)
+{
+    event_queue_init(&_queue);
+    mtd_init(_dev);
+
+    TESTS_START();
+    TESTS_RUN(tests_mtd_async());
+    TESTS_END();
+
+    return 0;
+}
+/** @} */
@@ -0,0 +1,378 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_cache module test
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "macros/utils.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+
+/* Test mock object implementing a simple RAM-based mtd with flash semantics */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 8
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 64
+#endif
+#ifndef WRITE_SIZE
+#define WRITE_SIZE 4
+#endif
+
+#define SECTOR_SIZE          (PAGE_PER_SECTOR * PAGE_SIZE)
+
+#define MEMORY_SIZE          (SECTOR_SIZE * SECTOR_COUNT)
+
+#define CHUNK_SIZE           (16)
+
+static uint8_t _dummy_memory[MEMORY_SIZE];
+
+static uint8_t _buffer[SECTOR_SIZE];
+
+static unsigned _erase_count;
+static unsigned _write_count;
+static bool _write_fail;
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *dev, void *buff, uint32_t page, uint32_t offset, uint32_t size)
+{
+    uint32_t addr = page * dev->page_size + offset;
+
+    if (page >= dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+
+    if (offset > dev->page_size) {
+        return -EOVERFLOW;
+    }
+
+    size = MIN(dev->page_size - offset, size);
+
+    memcpy(buff, _dummy_memory + addr, size);
+
+    return size;
+}
+
+static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page, uint32_t offset, uint32_t size)
+{
+    uint32_t addr = page * dev->page_size + offset;
+    const uint8_t *src = buff;
+
+    if (page >= dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+
+    if (offset > dev->page_size) {
+        return -EOVERFLOW;
+    }
+
+    if (_write_fail) {
+        return -EIO;
+    }
+
+    size = MIN(dev->page_size - offset, size);
+
+    /* like flash, writing can only clear bits */
+    for (uint32_t i = 0; i < size; i++) {
+        _dummy_memory[addr + i] &= src[i];
+    }
+    _write_count++;
+
+    return size;
+}
+
+static int _erase_sector(mtd_dev_t *dev, uint32_t sector, uint32_t count)
+{
+    uint32_t addr = sector * dev->page_size * dev->pages_per_sector;
+
+    if (sector + count > dev->sector_count) {
+        return -EOVERFLOW;
+    }
+
+    memset(_dummy_memory + addr, 0xff,
+           count * dev->page_size * dev->pages_per_sector);
+    _erase_count += count;
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    (void)power;
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .power = _power,
+    .read_page    = _read_page,
+    .write_page   = _write_page,
+    .erase_sector = _erase_sector,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+    .write_size = WRITE_SIZE,
+};
+
+static uint8_t _cache_buf[2 * SECTOR_SIZE];
+static mtd_cache_line_t _cache_lines[2];
+
+static mtd_cache_t _cache = MTD_CACHE_INIT(&dev, _cache_lines, _cache_buf);
+
+static mtd_dev_t *_dev = &_cache.base;
+
+static void _test_mem(const uint8_t *buffer, size_t len, uint8_t expected)
+{
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL_INT(expected, buffer[i]);
+    }
+}
+
+static void _write_chunks(uint32_t sector, uint8_t val)
+{
+    uint8_t chunk[CHUNK_SIZE];
+
+    memset(chunk, val, sizeof(chunk));
+    for (uint32_t off = 0; off < SECTOR_SIZE; off += CHUNK_SIZE) {
+        int ret = mtd_write_page(_dev, chunk, sector * PAGE_PER_SECTOR,
+                                 off, sizeof(chunk));
+        TEST_ASSERT_EQUAL_INT(0, ret);
+    }
+}
+
+static void test_mtd_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, _dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, _dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _dev->page_size);
+    TEST_ASSERT_EQUAL_INT(WRITE_SIZE, _dev->write_size);
+}
+
+static void test_mtd_read_uncached(void)
+{
+    int ret = mtd_read_page(_dev, _buffer, PAGE_PER_SECTOR, 0, SECTOR_SIZE);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    _test_mem(_buffer, SECTOR_SIZE, 0x00);
+}
+
+static void test_mtd_write_combined(void)
+{
+    /* many small writes to a sector that is not erased */
+    _write_chunks(1, 0xAA);
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    TEST_ASSERT_EQUAL_INT(0, _write_count);
+
+    /* data is served from the cache */
+    int ret = mtd_read_page(_dev, _buffer, PAGE_PER_SECTOR, 0, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    _test_mem(_buffer, SECTOR_SIZE, 0xAA);
+    _test_mem(_dummy_memory + SECTOR_SIZE, SECTOR_SIZE, 0x00);
+
+    /* a single erase on flush */
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    _test_mem(_dummy_memory + SECTOR_SIZE, SECTOR_SIZE, 0xAA);
+    _test_mem(_dummy_memory, SECTOR_SIZE, 0x00);
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE, SECTOR_SIZE, 0x00);
+
+    /* flushing a clean cache does nothing */
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+}
+
+static void test_mtd_write_erased(void)
+{
+    uint8_t chunk[CHUNK_SIZE];
+
+    int ret = mtd_erase_sector(_dev, 2, 1);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+
+    /* appending to an erased sector does not need another erase */
+    memset(chunk, 0x11, sizeof(chunk));
+    ret = mtd_write_page(_dev, chunk, 2 * PAGE_PER_SECTOR, 0, sizeof(chunk));
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+
+    memset(chunk, 0x22, sizeof(chunk));
+    ret = mtd_write_page(_dev, chunk, 2 * PAGE_PER_SECTOR, CHUNK_SIZE, sizeof(chunk));
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE, CHUNK_SIZE, 0x11);
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE + CHUNK_SIZE, CHUNK_SIZE, 0x22);
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE + 2 * CHUNK_SIZE,
+              SECTOR_SIZE - 2 * CHUNK_SIZE, 0xff);
+
+    /* overwriting data that was written back requires an erase */
+    memset(chunk, 0x33, sizeof(chunk));
+    ret = mtd_write_page(_dev, chunk, 2 * PAGE_PER_SECTOR, 0, sizeof(chunk));
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(2, _erase_count);
+
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE, CHUNK_SIZE, 0x33);
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE + CHUNK_SIZE, CHUNK_SIZE, 0x22);
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE + 2 * CHUNK_SIZE,
+              SECTOR_SIZE - 2 * CHUNK_SIZE, 0xff);
+}
+
+static void test_mtd_evict(void)
+{
+    _write_chunks(0, 0xA0);
+    _write_chunks(1, 0xA1);
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+
+    /* cache is full, sector 0 gets evicted */
+    _write_chunks(2, 0xA2);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    _test_mem(_dummy_memory, SECTOR_SIZE, 0xA0);
+    _test_mem(_dummy_memory + SECTOR_SIZE, SECTOR_SIZE, 0x00);
+
+    /* sector 1 is used more recently than sector 2 now */
+    int ret = mtd_read_page(_dev, _buffer, PAGE_PER_SECTOR, 0, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    _test_mem(_buffer, SECTOR_SIZE, 0xA1);
+
+    _write_chunks(3, 0xA3);
+    TEST_ASSERT_EQUAL_INT(2, _erase_count);
+    _test_mem(_dummy_memory + SECTOR_SIZE, SECTOR_SIZE, 0x00);
+    _test_mem(_dummy_memory + 2 * SECTOR_SIZE, SECTOR_SIZE, 0xA2);
+
+    /* evicted sector is read from the backing device */
+    ret = mtd_read_page(_dev, _buffer, 0, 0, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    _test_mem(_buffer, SECTOR_SIZE, 0xA0);
+}
+
+static void test_mtd_erase_discard(void)
+{
+    _write_chunks(4, 0x55);
+
+    int ret = mtd_erase_sector(_dev, 4, 1);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+
+    ret = mtd_read_page(_dev, _buffer, 4 * PAGE_PER_SECTOR, 0, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    _test_mem(_buffer, SECTOR_SIZE, 0xff);
+
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    TEST_ASSERT_EQUAL_INT(0, _write_count);
+}
+
+static void test_mtd_erase_evict_error(void)
+{
+    _write_chunks(0, 0xB0);
+    _write_chunks(1, 0xB1);
+
+    /* sector 0 gets evicted to keep track of the erased sector, but can't
+     * be written back */
+    _write_fail = true;
+    int ret = mtd_erase_sector(_dev, 2, 1);
+    TEST_ASSERT_EQUAL_INT(-EIO, ret);
+
+    /* the modifications are still cached */
+    _write_fail = false;
+    ret = mtd_cache_flush(&_cache);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    _test_mem(_dummy_memory, SECTOR_SIZE, 0xB0);
+    _test_mem(_dummy_memory + SECTOR_SIZE, SECTOR_SIZE, 0xB1);
+}
+
+static void test_mtd_power_down(void)
+{
+    _write_chunks(5, 0x5A);
+    _test_mem(_dummy_memory + 5 * SECTOR_SIZE, SECTOR_SIZE, 0x00);
+
+    int ret = mtd_power(_dev, MTD_POWER_DOWN);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    _test_mem(_dummy_memory + 5 * SECTOR_SIZE, SECTOR_SIZE, 0x5A);
+
+    ret = mtd_power(_dev, MTD_POWER_UP);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+}
+
+static void set_up(void)
+{
+    /* start with memory that is not erased */
+    memset(_dummy_memory, 0x00, sizeof(_dummy_memory));
+
+    /* initialize once, mtd_init() allocates a work area for the parent */
+    if (_dev->sector_count == 0) {
+        mtd_init(_dev);
+    }
+    /* drop cached sectors of the previous test */
+    for (unsigned i = 0; i < ARRAY_SIZE(_cache_lines); i++) {
+        _cache_lines[i].sector = MTD_CACHE_SECTOR_NONE;
+    }
+    _erase_count = 0;
+    _write_count = 0;
+    _write_fail = false;
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_init),
+        new_TestFixture(test_mtd_read_uncached),
+        new_TestFixture(test_mtd_write_combined),
+        new_TestFixture(test_mtd_write_erased),
+        new_TestFixture(test_mtd_evict),
+        new_TestFixture(test_mtd_erase_discard),
+        new_TestFixture(test_mtd_erase_evict_error),
+        new_TestFixture(test_mtd_power_down),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_cache_tests());
+    TESTS_END();
+    return 0;
+}
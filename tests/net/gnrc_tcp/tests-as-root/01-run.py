@@ -7,12 +7,13 @@
 # directory for more details.
 
 import os
+import subprocess
 import sys
 import random
 import pexpect
 import base64
 
-from scapy.all import Ether, IPv6, TCP, raw, sendp
+from scapy.all import AsyncSniffer, Ether, IPv6, TCP, raw, sendp, srp1
 
 from helpers import Runner, RiotTcpServer, RiotTcpClient, HostTcpServer, HostTcpClient, \
                     generate_port_number, sudo_guard
@@ -216,6 +217,69 @@ def test_gnrc_tcp_garbage_packets_option_parsing(child):
         riot_srv.close()
 
 
+@Runner(timeout=10)
+def test_gnrc_tcp_window_scale_ignored_if_disabled(child):
+    """ This test verifies that a listener with window scaling disabled
+        (the default) neither answers nor applies the window scale option
+        of a peer.
+    """
+    # Setup RIOT as server
+    with RiotTcpServer(child, generate_port_number()) as riot_srv:
+        # Construct HostTcpClient to lookup node properties
+        host_cli = HostTcpClient(riot_srv)
+        port = int(riot_srv.listen_port)
+        ip = Ether(dst=riot_srv.mac) / IPv6(src=host_cli.address, dst=riot_srv.address)
+
+        child.sendline('gnrc_tcp_accept 2000')
+
+        # The host stack does not know the connection and would reset it
+        rst_rule = ['OUTPUT', '-p', 'tcp', '--sport', '2342', '--tcp-flags', 'RST', 'RST',
+                    '-j', 'DROP']
+        subprocess.check_call(['ip6tables', '-A'] + rst_rule)
+        try:
+            _window_scale_ignored(child, riot_srv, host_cli, port, ip)
+        finally:
+            subprocess.check_call(['ip6tables', '-D'] + rst_rule)
+
+
+def _window_scale_ignored(child, riot_srv, host_cli, port, ip):
+    # Announce the largest window scale in the SYN
+    syn_ack = srp1(
+        ip / TCP(dport=port, sport=2342, flags="S", seq=1000, window=4,
+                 options=[('MSS', 1220), ('WScale', 14)]),
+        iface=host_cli.interface, timeout=2, verbose=0
+    )
+    assert syn_ack is not None and TCP in syn_ack
+    assert syn_ack[TCP].flags == "SA"
+    assert 'WScale' not in [opt[0] for opt in syn_ack[TCP].options]
+
+    # Complete the handshake with a window of 4 bytes, which RIOT must not scale
+    sendp(
+        ip / TCP(dport=port, sport=2342, flags="A", seq=1001,
+                 ack=syn_ack[TCP].seq + 1, window=4),
+        iface=host_cli.interface, verbose=0
+    )
+    child.expect_exact('gnrc_tcp_accept: returns 0')
+
+    # Send more data than the window allows and capture the first segment
+    data = '0123456789' * 10
+    assert riot_srv._setup_internal_buffer() >= len(data)
+    riot_srv._write_data_to_internal_buffer(data)
+    sniffer = AsyncSniffer(
+        iface=host_cli.interface, count=1, timeout=2,
+        lfilter=lambda p: TCP in p and p[TCP].sport == port and len(p[TCP].payload) > 0
+    )
+    sniffer.start()
+    child.sendline('gnrc_tcp_send 1000 {}'.format(len(data)))
+    sniffer.join()
+    child.expect(r'gnrc_tcp_send: (sent|returns)')
+
+    assert len(sniffer.results) == 1
+    assert len(sniffer.results[0][TCP].payload) <= 4
+
+    riot_srv.abort()
+
+
 @Runner(timeout=5)
 def test_gnrc_tcp_recv_behavior_on_closed_connection(child):
     """ This test ensures that a gnrc_tcp_recv doesn't block if a connection
@@ -0,0 +1,200 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures GNRC TCP goodput over a lossy loopback link
+ *
+ * A client and a server connect via the IPv6 loopback address. All TCP
+ * segments delivered by IPv6 pass a shim thread that drops a configurable
+ * share of them before they reach GNRC TCP.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/tcp.h"
+#include "random.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#ifndef LOSS_PERCENT
+#define LOSS_PERCENT        (5U)        /**< share of dropped TCP segments */
+#endif
+
+#ifndef TRANSFER_SIZE
+#define TRANSFER_SIZE       (32U * 1024U)   /**< number of bytes to transfer */
+#endif
+
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE          (512U)      /**< bytes per send/recv call */
+#endif
+
+#define SERVER_PORT         (2000U)
+#define SHIM_QUEUE_SIZE     (8U)
+
+static char _shim_stack[THREAD_STACKSIZE_DEFAULT];
+static char _client_stack[THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF];
+static msg_t _shim_queue[SHIM_QUEUE_SIZE];
+
+static kernel_pid_t _tcp_pid;
+static gnrc_netreg_entry_t _shim_entry;
+static unsigned _dropped;
+static unsigned _forwarded;
+
+static gnrc_tcp_tcb_t _client_tcb;
+static gnrc_tcp_tcb_t _server_tcb;
+static gnrc_tcp_tcb_queue_t _queue = GNRC_TCP_TCB_QUEUE_INIT;
+static uint8_t _client_buf[CHUNK_SIZE];
+static uint8_t _server_buf[CHUNK_SIZE];
+
+static void *_shim(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_shim_queue, SHIM_QUEUE_SIZE);
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            continue;
+        }
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+        if (random_uint32_range(0, 100) < LOSS_PERCENT) {
+            _dropped++;
+            gnrc_pktbuf_release(pkt);
+        }
+        else {
+            _forwarded++;
+            gnrc_netapi_receive(_tcp_pid, pkt);
+        }
+    }
+    return NULL;
+}
+
+static int _shim_setup(void)
+{
+    gnrc_netreg_entry_t *tcp_entry;
+
+    gnrc_netreg_acquire_shared();
+    tcp_entry = gnrc_netreg_lookup(GNRC_NETTYPE_TCP, GNRC_NETREG_DEMUX_CTX_ALL);
+    gnrc_netreg_release_shared();
+    if (tcp_entry == NULL) {
+        return -1;
+    }
+    _tcp_pid = tcp_entry->target.pid;
+    gnrc_netreg_unregister(GNRC_NETTYPE_TCP, tcp_entry);
+
+    kernel_pid_t pid = thread_create(_shim_stack, sizeof(_shim_stack),
+                                     THREAD_PRIORITY_MAIN - 2, THREAD_CREATE_STACKTEST,
+                                     _shim, NULL, "loss_shim");
+    gnrc_netreg_entry_init_pid(&_shim_entry, GNRC_NETREG_DEMUX_CTX_ALL, pid);
+    return gnrc_netreg_register(GNRC_NETTYPE_TCP, &_shim_entry);
+}
+
+static void *_client(void *arg)
+{
+    (void)arg;
+    gnrc_tcp_ep_t remote;
+    size_t sent = 0;
+    int res;
+
+    gnrc_tcp_ep_from_str(&remote, "[::1]");
+    remote.port = SERVER_PORT;
+    gnrc_tcp_tcb_init(&_client_tcb);
+
+    res = gnrc_tcp_open(&_client_tcb, &remote, 0);
+    if (res < 0) {
+        printf("client: gnrc_tcp_open: %d\n", res);
+        return NULL;
+    }
+
+    while (sent < TRANSFER_SIZE) {
+        size_t len = TRANSFER_SIZE - sent;
+
+        len = (len < CHUNK_SIZE) ? len : CHUNK_SIZE;
+        for (size_t i = 0; i < len; i++) {
+            _client_buf[i] = (uint8_t)(sent + i);
+        }
+        ssize_t n = gnrc_tcp_send(&_client_tcb, _client_buf, len, GNRC_TCP_NO_TIMEOUT);
+        if (n < 0) {
+            printf("client: gnrc_tcp_send: %d\n", (int)n);
+            break;
+        }
+        sent += n;
+    }
+    gnrc_tcp_close(&_client_tcb);
+    return NULL;
+}
+
+int main(void)
+{
+    gnrc_tcp_ep_t local;
+    gnrc_tcp_tcb_t *tcb;
+    size_t received = 0;
+    uint32_t start;
+    int res;
+
+    if (_shim_setup() < 0) {
+        puts("Unable to setup loss shim");
+        return 1;
+    }
+
+    gnrc_tcp_ep_from_str(&local, "[::]");
+    local.port = SERVER_PORT;
+    gnrc_tcp_tcb_init(&_server_tcb);
+    res = gnrc_tcp_listen(&_queue, &_server_tcb, 1, &local);
+    if (res < 0) {
+        printf("server: gnrc_tcp_listen: %d\n", res);
+        return 1;
+    }
+
+    thread_create(_client_stack, sizeof(_client_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _client, NULL, "client");
+
+    res = gnrc_tcp_accept(&_queue, &tcb, GNRC_TCP_NO_TIMEOUT);
+    if (res < 0) {
+        printf("server: gnrc_tcp_accept: %d\n", res);
+        return 1;
+    }
+
+    start = ztimer_now(ZTIMER_MSEC);
+    while (received < TRANSFER_SIZE) {
+        ssize_t n = gnrc_tcp_recv(tcb, _server_buf, sizeof(_server_buf), GNRC_TCP_NO_TIMEOUT);
+
+        if (n <= 0) {
+            printf("server: gnrc_tcp_recv: %d\n", (int)n);
+            break;
+        }
+        for (ssize_t i = 0; i < n; i++) {
+            if (_server_buf[i] != (uint8_t)(received + i)) {
+                printf("server: data mismatch at %u\n", (unsigned)(received + i));
+                return 1;
+            }
+        }
+        received += n;
+    }
+    uint32_t duration = ztimer_now(ZTIMER_MSEC) - start;
+
+    gnrc_tcp_close(tcb);
+    gnrc_tcp_stop_listen(&_queue);
+
+    printf("received: %u bytes in %" PRIu32 " ms\n", (unsigned)received, duration);
+    printf("goodput: %" PRIu32 " B/s\n",
+           (duration) ? (uint32_t)((uint64_t)received * 1000 / duration) : 0);
+    printf("segments: %u forwarded, %u dropped\n", _forwarded, _dropped);
+    puts((received == TRANSFER_SIZE) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,19 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"received: (\d+) bytes in (\d+) ms", timeout=120)
+    child.expect(r"goodput: (\d+) B/s")
+    print("goodput: {} B/s".format(child.match.group(1)))
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
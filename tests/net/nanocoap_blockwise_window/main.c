@@ -0,0 +1,212 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the end of windowed block-wise GET transfers
+ *
+ * A server thread on the IPv6 loopback address collects each burst of
+ * block requests and answers it in reverse order. Blocks behind the end of
+ * the resource are answered with 4.02 Bad Option, so these errors reach the
+ * client before the last block does.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "embUnit.h"
+#include "macros/utils.h"
+#include "net/ipv6/addr.h"
+#include "net/nanocoap_sock.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "timex.h"
+
+#define SERVER_PORT         (5683U)
+#define BLOCK_SIZE          (16U)
+#define WINDOW              (4U)
+#define BURST_TIMEOUT_US    (20U * US_PER_MS)
+#define NO_FAIL             (UINT32_MAX)
+
+typedef struct {
+    sock_udp_ep_t remote;
+    size_t len;
+    uint8_t buf[CONFIG_NANOCOAP_BLOCK_HEADER_MAX];
+} _request_t;
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static sock_udp_t _server_sock;
+static _request_t _reqs[WINDOW];
+
+static size_t _size;                /* size of the resource served */
+static uint32_t _fail_blk;          /* block answered with an error */
+
+static uint8_t _buf[WINDOW * BLOCK_SIZE];
+static size_t _received;
+static bool _last_seen;
+
+static void _reply(_request_t *req)
+{
+    uint8_t buf[CONFIG_NANOCOAP_BLOCK_HEADER_MAX + BLOCK_SIZE];
+    uint8_t *pos = buf;
+    coap_pkt_t pkt;
+    coap_block1_t block2;
+
+    if (coap_parse(&pkt, req->buf, req->len) < 0 || !coap_get_block2(&pkt, &block2)) {
+        return;
+    }
+
+    size_t offset = block2.blknum * BLOCK_SIZE;
+    bool fail = (offset >= _size) || (block2.blknum == _fail_blk);
+
+    pos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK,
+                          coap_get_token(&pkt), coap_get_token_len(&pkt),
+                          fail ? COAP_CODE_BAD_OPTION : COAP_CODE_CONTENT,
+                          coap_get_id(&pkt));
+    if (!fail) {
+        size_t len = MIN(_size - offset, BLOCK_SIZE);
+        bool more = offset + len < _size;
+
+        pos += coap_opt_put_uint(pos, 0, COAP_OPT_BLOCK2,
+                                 (block2.blknum << 4) | (more << 3) | COAP_BLOCKSIZE_16);
+        *pos++ = 0xFF;
+        for (size_t i = 0; i < len; i++) {
+            *pos++ = (uint8_t)(offset + i);
+        }
+    }
+
+    sock_udp_send(&_server_sock, buf, pos - buf, &req->remote);
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+    sock_udp_ep_t local = { .family = AF_INET6, .port = SERVER_PORT };
+
+    sock_udp_create(&_server_sock, &local, NULL, 0);
+
+    while (1) {
+        unsigned n = 0;
+
+        /* collect a burst of requests to answer it in reverse order */
+        while (n < WINDOW) {
+            ssize_t res = sock_udp_recv(&_server_sock, _reqs[n].buf, sizeof(_reqs[n].buf),
+                                        n ? BURST_TIMEOUT_US : SOCK_NO_TIMEOUT,
+                                        &_reqs[n].remote);
+            if (res <= 0) {
+                break;
+            }
+            _reqs[n++].len = res;
+        }
+
+        while (n--) {
+            _reply(&_reqs[n]);
+        }
+    }
+
+    return NULL;
+}
+
+static int _block_cb(void *arg, size_t offset, uint8_t *buf, size_t len, int more)
+{
+    (void)arg;
+
+    if (offset != _received || _last_seen) {
+        return -EINVAL;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != (uint8_t)(offset + i)) {
+            return -EINVAL;
+        }
+    }
+    _received += len;
+    _last_seen = !more;
+
+    return 0;
+}
+
+static int _get(size_t size, uint32_t fail_blk)
+{
+    nanocoap_sock_t sock;
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+
+    _size = size;
+    _fail_blk = fail_blk;
+    _received = 0;
+    _last_seen = false;
+
+    int res = nanocoap_sock_connect(&sock, NULL, &remote);
+    if (res < 0) {
+        return res;
+    }
+    res = nanocoap_sock_get_blockwise_window(&sock, "/res", COAP_BLOCKSIZE_16,
+                                             _buf, sizeof(_buf), _block_cb, NULL);
+    nanocoap_sock_close(&sock);
+
+    return res;
+}
+
+static void test_window_end_inside(void)
+{
+    /* block 5 is the last one, the errors for blocks 6 to 8 that were
+     * requested along with it arrive first */
+    TEST_ASSERT_EQUAL_INT(0, _get(5 * BLOCK_SIZE + 7, NO_FAIL));
+    TEST_ASSERT_EQUAL_INT(5 * BLOCK_SIZE + 7, _received);
+    TEST_ASSERT(_last_seen);
+}
+
+static void test_window_end_at_edge(void)
+{
+    /* the resource ends with the first window, on a block boundary */
+    TEST_ASSERT_EQUAL_INT(0, _get(5 * BLOCK_SIZE, NO_FAIL));
+    TEST_ASSERT_EQUAL_INT(5 * BLOCK_SIZE, _received);
+    TEST_ASSERT(_last_seen);
+
+    /* same with the second window */
+    TEST_ASSERT_EQUAL_INT(0, _get(9 * BLOCK_SIZE, NO_FAIL));
+    TEST_ASSERT_EQUAL_INT(9 * BLOCK_SIZE, _received);
+    TEST_ASSERT(_last_seen);
+}
+
+static void test_window_error_inside(void)
+{
+    /* block 2 fails, block 1 arrives afterwards with the more flag set */
+    TEST_ASSERT(_get(8 * BLOCK_SIZE, 2) < 0);
+    TEST_ASSERT_EQUAL_INT(BLOCK_SIZE, _received);
+    TEST_ASSERT(!_last_seen);
+}
+
+static Test *tests_nanocoap_blockwise_window(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_window_end_inside),
+        new_TestFixture(test_window_end_at_edge),
+        new_TestFixture(test_window_error_inside),
+    };
+
+    EMB_UNIT_TESTCALLER(nanocoap_blockwise_window_tests, NULL, NULL, fixtures);
+    return (Test *)&nanocoap_blockwise_window_tests;
+}
+
+int main(void)
+{
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "coap_server");
+
+    TESTS_START();
+    TESTS_RUN(tests_nanocoap_blockwise_window());
+    TESTS_END();
+
+    return 0;
+}
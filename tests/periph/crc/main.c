@@ -0,0 +1,124 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``crc`` periph driver
+ *
+ * The peripheral is compared to a bitwise reference implementation for all
+ * alignments and lengths up to @ref MAX_LEN, as the checksum module itself
+ * uses the peripheral. Algorithms or lengths the
+ * peripheral does not support are skipped.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "container.h"
+#include "embUnit.h"
+#include "periph/crc.h"
+
+#define MAX_LEN     (64U)
+
+/* extra bytes to test all alignments */
+static uint8_t _buf[MAX_LEN + sizeof(uint32_t)];
+
+static void _setup(void)
+{
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i * 7 + 1;
+    }
+}
+
+static uint32_t _reference(crc_type_t type, uint32_t crc, const void *buf,
+                           size_t len)
+{
+    const uint32_t poly = (type == CRC_TYPE_CRC32) ? 0xedb88320 : 0x82f63b78;
+    const uint8_t *p = buf;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (unsigned i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+        }
+    }
+    return ~crc;
+}
+
+static void _test_against_reference(crc_type_t type)
+{
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        for (unsigned len = 0; len <= MAX_LEN; len++) {
+            /* continue the checksum of some preceding data */
+            uint32_t crc = _reference(type, 0, "123456789", 9);
+            uint32_t expected = _reference(type, crc, &_buf[offset], len);
+
+            int res = crc_update(type, &crc, &_buf[offset], len);
+            if (res == -ENOTSUP) {
+                continue;
+            }
+            TEST_ASSERT_EQUAL_INT(0, res);
+            TEST_ASSERT_EQUAL_INT(expected, crc);
+        }
+    }
+}
+
+static void test_crc_crc32(void)
+{
+    _test_against_reference(CRC_TYPE_CRC32);
+}
+
+static void test_crc_crc32c(void)
+{
+    _test_against_reference(CRC_TYPE_CRC32C);
+}
+
+static void test_crc_check_value(void)
+{
+    static const uint32_t expected[] = {
+        [CRC_TYPE_CRC32] = 0x4b837ae4,
+        [CRC_TYPE_CRC32C] = 0xa86c53f4,
+    };
+    /* long enough for all peripherals */
+    static const char buf[] = "123456789123456789";
+
+    for (unsigned type = 0; type < ARRAY_SIZE(expected); type++) {
+        uint32_t crc = 0;
+        int res = crc_update(type, &crc, buf, sizeof(buf) - 1);
+        if (res == -ENOTSUP) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(0, res);
+        TEST_ASSERT_EQUAL_INT(expected[type], crc);
+    }
+}
+
+Test *tests_crc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crc_crc32),
+        new_TestFixture(test_crc_crc32c),
+        new_TestFixture(test_crc_check_value),
+    };
+
+    EMB_UNIT_TESTCALLER(crc_tests, _setup, NULL, fixtures);
+
+    return (Test *)&crc_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_crc_tests());
+    TESTS_END();
+    return 0;
+}
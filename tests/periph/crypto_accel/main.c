@@ -0,0 +1,351 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``crypto_accel`` periph driver
+ *
+ * The accelerator is tested directly and through the hash and cipher APIs
+ * that offload to it. Operations the accelerator does not support are
+ * skipped in the direct tests.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "periph/crypto_accel.h"
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "hashes/sha1.h"
+#include "hashes/sha256.h"
+
+/* "abc", padded to one block */
+static const uint8_t abc_block[64] = {
+    'a', 'b', 'c', 0x80, [63] = 0x18,
+};
+
+/* two block message of FIPS 180-2 */
+static const char abc_long[] =
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+static const uint8_t sha1_abc_long[] = {
+    0x84, 0x98, 0x3e, 0x44, 0x1c, 0x3b, 0xd2, 0x6e, 0xba, 0xae,
+    0x4a, 0xa1, 0xf9, 0x51, 0x29, 0xe5, 0xe5, 0x46, 0x70, 0xf1,
+};
+
+static const uint8_t sha256_abc_long[] = {
+    0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8,
+    0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+    0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+    0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+};
+
+/* FIPS 197 C.1 */
+static const uint8_t aes_key[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+static const uint8_t aes_plain[] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+};
+
+static const uint8_t aes_cipher[] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a,
+};
+
+/* NIST SP 800-38A, F.2.1 and F.5.1, four blocks each */
+static const uint8_t modes_key[] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+
+static const uint8_t modes_plain[] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+    0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+    0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+    0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10,
+};
+
+static const uint8_t cbc_iv[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+static const uint8_t cbc_cipher[] = {
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46,
+    0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee,
+    0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+    0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b,
+    0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09,
+    0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7,
+};
+
+static const uint8_t ctr_counter[] = {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+    0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff,
+};
+
+static const uint8_t ctr_cipher[] = {
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+    0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+    0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+    0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+    0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e,
+    0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1,
+    0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee,
+};
+
+#define MODES_BLOCKS    (sizeof(modes_plain) / AES_BLOCK_SIZE)
+
+/* RFC 3610 packet vector #1 */
+static const uint8_t ccm_key[] = {
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+    0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+};
+
+static const uint8_t ccm_nonce[] = {
+    0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+    0xa1, 0xa2, 0xa3, 0xa4, 0xa5,
+};
+
+static const uint8_t ccm_adata[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+};
+
+static const uint8_t ccm_plain[] = {
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e,
+};
+
+static const uint8_t ccm_cipher[] = {
+    0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+    0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+    0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84, 0x17,
+    0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0,
+};
+
+#define CCM_MAC_LEN     (8U)
+
+static void test_crypto_accel_sha1_blocks(void)
+{
+    uint32_t state[] = {
+        0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0,
+    };
+    static const uint32_t expected[] = {
+        0xa9993e36, 0x4706816a, 0xba3e2571, 0x7850c26c, 0x9cd0d89d,
+    };
+
+    int res = crypto_accel_hash_blocks(CRYPTO_ACCEL_SHA1, state, abc_block,
+                                       sizeof(abc_block));
+    if (res == -ENOTSUP) {
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, state, sizeof(expected)));
+}
+
+static void test_crypto_accel_sha256_blocks(void)
+{
+    uint32_t state[] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    static const uint32_t expected[] = {
+        0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223,
+        0xb00361a3, 0x96177a9c, 0xb410ff61, 0xf20015ad,
+    };
+
+    int res = crypto_accel_hash_blocks(CRYPTO_ACCEL_SHA256, state, abc_block,
+                                       sizeof(abc_block));
+    if (res == -ENOTSUP) {
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, state, sizeof(expected)));
+}
+
+static void test_crypto_accel_aes_ecb(void)
+{
+    uint8_t buf[2 * AES_BLOCK_SIZE];
+
+    memcpy(buf, aes_plain, AES_BLOCK_SIZE);
+    memcpy(&buf[AES_BLOCK_SIZE], aes_plain, AES_BLOCK_SIZE);
+
+    int res = crypto_accel_aes_ecb(CRYPTO_ACCEL_AES_ECB_ENCRYPT, aes_key,
+                                   sizeof(aes_key), buf, buf, sizeof(buf));
+    if (res == -ENOTSUP) {
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(aes_cipher, buf, AES_BLOCK_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(aes_cipher, &buf[AES_BLOCK_SIZE],
+                                    AES_BLOCK_SIZE));
+
+    res = crypto_accel_aes_ecb(CRYPTO_ACCEL_AES_ECB_DECRYPT, aes_key,
+                               sizeof(aes_key), buf, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(aes_plain, buf, AES_BLOCK_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(aes_plain, &buf[AES_BLOCK_SIZE],
+                                    AES_BLOCK_SIZE));
+}
+
+static void test_crypto_accel_sha1(void)
+{
+    uint8_t digest[SHA1_DIGEST_LENGTH];
+    sha1_context ctx;
+
+    sha1_init(&ctx);
+    /* split the input so buffered and direct blocks are used */
+    sha1_update(&ctx, abc_long, 3);
+    sha1_update(&ctx, &abc_long[3], strlen(abc_long) - 3);
+    sha1_final(&ctx, digest);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(sha1_abc_long, digest, sizeof(digest)));
+}
+
+static void test_crypto_accel_sha256(void)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+
+    sha256(abc_long, strlen(abc_long), digest);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(sha256_abc_long, digest, sizeof(digest)));
+}
+
+static void test_crypto_accel_cipher(void)
+{
+    uint8_t buf[AES_BLOCK_SIZE];
+    cipher_t cipher;
+
+    TEST_ASSERT_EQUAL_INT(CIPHER_INIT_SUCCESS,
+                          cipher_init(&cipher, CIPHER_AES, aes_key,
+                                      sizeof(aes_key)));
+    TEST_ASSERT_EQUAL_INT(1, cipher_encrypt(&cipher, aes_plain, buf));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(aes_cipher, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, cipher_decrypt(&cipher, buf, buf));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(aes_plain, buf, sizeof(buf)));
+}
+
+static void test_crypto_accel_cipher_blocks(void)
+{
+    uint8_t buf[sizeof(modes_plain)];
+    uint8_t single[sizeof(modes_plain)];
+    uint8_t iv[sizeof(cbc_iv)];
+    uint8_t counter[sizeof(ctr_counter)];
+    cipher_t cipher;
+
+    TEST_ASSERT_EQUAL_INT(CIPHER_INIT_SUCCESS,
+                          cipher_init(&cipher, CIPHER_AES, modes_key,
+                                      sizeof(modes_key)));
+
+    /* all blocks in one call give the same result as one call per block */
+    TEST_ASSERT_EQUAL_INT(1, cipher_encrypt_blocks(&cipher, modes_plain, buf,
+                                                   MODES_BLOCKS));
+    for (unsigned i = 0; i < MODES_BLOCKS; i++) {
+        TEST_ASSERT_EQUAL_INT(1, cipher_encrypt(&cipher,
+                                                &modes_plain[i * AES_BLOCK_SIZE],
+                                                &single[i * AES_BLOCK_SIZE]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(single, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, cipher_decrypt_blocks(&cipher, buf, buf,
+                                                   MODES_BLOCKS));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(modes_plain, buf, sizeof(buf)));
+
+    /* CTR encrypts all counter blocks at once */
+    memcpy(counter, ctr_counter, sizeof(counter));
+    TEST_ASSERT_EQUAL_INT(sizeof(modes_plain),
+                          cipher_encrypt_ctr(&cipher, counter, 0, modes_plain,
+                                             sizeof(modes_plain), buf));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ctr_cipher, buf, sizeof(buf)));
+
+    /* CBC decrypts all blocks at once */
+    memcpy(iv, cbc_iv, sizeof(iv));
+    TEST_ASSERT_EQUAL_INT(sizeof(modes_plain),
+                          cipher_decrypt_cbc(&cipher, iv, cbc_cipher,
+                                             sizeof(cbc_cipher), buf));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(modes_plain, buf, sizeof(buf)));
+}
+
+static void test_crypto_accel_ccm(void)
+{
+    uint8_t buf[sizeof(ccm_cipher)];
+    uint8_t out[sizeof(ccm_cipher)];
+    cipher_t cipher;
+    int res;
+
+    TEST_ASSERT_EQUAL_INT(CIPHER_INIT_SUCCESS,
+                          cipher_init(&cipher, CIPHER_AES, ccm_key,
+                                      sizeof(ccm_key)));
+
+    res = cipher_encrypt_ccm(&cipher, ccm_adata, sizeof(ccm_adata),
+                             CCM_MAC_LEN, 15 - sizeof(ccm_nonce),
+                             ccm_nonce, sizeof(ccm_nonce),
+                             ccm_plain, sizeof(ccm_plain), buf);
+    TEST_ASSERT_EQUAL_INT(sizeof(ccm_cipher), res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ccm_cipher, buf, sizeof(ccm_cipher)));
+
+    res = cipher_decrypt_ccm(&cipher, ccm_adata, sizeof(ccm_adata),
+                             CCM_MAC_LEN, 15 - sizeof(ccm_nonce),
+                             ccm_nonce, sizeof(ccm_nonce),
+                             ccm_cipher, sizeof(ccm_cipher), buf);
+    TEST_ASSERT_EQUAL_INT(sizeof(ccm_plain), res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ccm_plain, buf, sizeof(ccm_plain)));
+
+    /* corrupted MAC */
+    memcpy(buf, ccm_cipher, sizeof(ccm_cipher));
+    buf[sizeof(buf) - 1] ^= 0x01;
+    res = cipher_decrypt_ccm(&cipher, ccm_adata, sizeof(ccm_adata),
+                             CCM_MAC_LEN, 15 - sizeof(ccm_nonce),
+                             ccm_nonce, sizeof(ccm_nonce),
+                             buf, sizeof(buf), out);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_CBC_MAC, res);
+}
+
+Test *tests_crypto_accel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_accel_sha1_blocks),
+        new_TestFixture(test_crypto_accel_sha256_blocks),
+        new_TestFixture(test_crypto_accel_aes_ecb),
+        new_TestFixture(test_crypto_accel_sha1),
+        new_TestFixture(test_crypto_accel_sha256),
+        new_TestFixture(test_crypto_accel_cipher),
+        new_TestFixture(test_crypto_accel_cipher_blocks),
+        new_TestFixture(test_crypto_accel_ccm),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_accel_tests, NULL, NULL, fixtures);
+
+    return (Test *)&crypto_accel_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_crypto_accel_tests());
+    TESTS_END();
+    return 0;
+}
@@ -192,6 +192,25 @@ static void test_rw(void)
     print_test_result("test_rw__read_rwc", (nr == sizeof(test_txt3)) &&
                       (strncmp(buf, test_txt3, sizeof(test_txt3)) == 0));
 
+    /* write and read back scattered buffers */
+    iolist_t iol2 = { .iol_base = (void *)test_txt2, .iol_len = sizeof(test_txt2) };
+    iolist_t iol1 = { .iol_next = &iol2, .iol_base = (void *)test_txt, .iol_len = sizeof(test_txt) };
+    new_pos = vfs_lseek(fd, 0, SEEK_SET);
+    nw = vfs_write_iol(fd, &iol1);
+    print_test_result("test_rw__write_iol", (new_pos == 0) &&
+                      (nw == sizeof(test_txt) + sizeof(test_txt2)));
+
+    memset(buf, 0, sizeof(buf));
+    iolist_t r_iol2 = { .iol_base = &buf[sizeof(test_txt)], .iol_len = sizeof(test_txt2) };
+    iolist_t r_iol1 = { .iol_next = &r_iol2, .iol_base = buf, .iol_len = sizeof(test_txt) };
+    new_pos = vfs_lseek(fd, 0, SEEK_SET);
+    nr = vfs_read_iol(fd, &r_iol1);
+    print_test_result("test_rw__read_iol", (new_pos == 0) &&
+                      (nr == sizeof(test_txt) + sizeof(test_txt2)) &&
+                      (strncmp(buf, test_txt, sizeof(test_txt)) == 0) &&
+                      (strncmp(&buf[sizeof(test_txt)], test_txt2,
+                               sizeof(test_txt2)) == 0));
+
     print_test_result("test_rw__close_rwc", vfs_close(fd) == 0);
     print_test_result("test_rw__umount", vfs_umount(&_test_vfs_mount, false) == 0);
 }
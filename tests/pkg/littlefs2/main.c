@@ -51,6 +51,13 @@ MTD_EMULATED_DEV(0, SECTOR_COUNT, PAGE_PER_SECTOR, PAGE_SIZE);
 
 #endif /* MTD_0 */
 
+#if IS_USED(MODULE_LITTLEFS2_PERSIST_LOOKAHEAD)
+#include "mtd_emulated.h"
+
+/* holds the allocator state saved on unmount */
+MTD_EMULATED_DEV(1, 1, 4, 64);
+#endif
+
 static littlefs2_desc_t littlefs_desc;
 
 static vfs_mount_t _test_littlefs_mount = {
@@ -153,6 +160,38 @@ static void tests_littlefs_write(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void tests_littlefs_write_iol(void)
+{
+    char hdr[] = "HEAD";
+    char payload[] = "PAYLOAD";
+    char r_hdr[sizeof(hdr)];
+    char r_payload[sizeof(payload) + 4];
+
+    iolist_t w_payload = { .iol_base = payload, .iol_len = sizeof(payload) };
+    iolist_t w_iol = { .iol_next = &w_payload, .iol_base = hdr, .iol_len = sizeof(hdr) };
+    iolist_t r_payload_iol = { .iol_base = r_payload, .iol_len = sizeof(r_payload) };
+    iolist_t r_iol = { .iol_next = &r_payload_iol, .iol_base = r_hdr, .iol_len = sizeof(r_hdr) };
+
+    int res;
+    int fd = vfs_open("/test-littlefs/test.txt", O_CREAT | O_RDWR, 0);
+    TEST_ASSERT(fd >= 0);
+
+    res = vfs_write_iol(fd, &w_iol);
+    TEST_ASSERT_EQUAL_INT(sizeof(hdr) + sizeof(payload), res);
+
+    res = vfs_lseek(fd, 0, SEEK_SET);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    /* reading stops at the end of the file */
+    res = vfs_read_iol(fd, &r_iol);
+    TEST_ASSERT_EQUAL_INT(sizeof(hdr) + sizeof(payload), res);
+    TEST_ASSERT_EQUAL_STRING(&hdr[0], &r_hdr[0]);
+    TEST_ASSERT_EQUAL_STRING(&payload[0], &r_payload[0]);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 static void tests_littlefs_unlink(void)
 {
     const char buf[] = "TESTSTRING";
@@ -344,6 +383,92 @@ static void tests_littlefs_statvfs(void)
     TEST_ASSERT(stat1.f_bavail > stat2.f_bavail);
 }
 
+#if IS_USED(MODULE_LITTLEFS2_PERSIST_LOOKAHEAD)
+static void tests_littlefs_persist_lookahead(void)
+{
+    const uint8_t *state = mtd_emulated_dev1.memory;
+    static const char data[] = "persistent allocator state";
+    char buf[sizeof(data)];
+    int res;
+
+    res = vfs_umount(&_test_littlefs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    littlefs_desc.state_dev = &mtd_emulated_dev1.base;
+    res = vfs_mount(&_test_littlefs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    /* allocating blocks fills the lookahead buffer */
+    int fd = vfs_open("/test-littlefs/test0.txt", O_CREAT | O_WRONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), vfs_write(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+
+    /* a clean unmount saves the state */
+    res = vfs_umount(&_test_littlefs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT(state[0] != 0xff);
+
+    /* mounting restores it without traversing the file system, and
+     * invalidates the saved copy */
+    res = vfs_mount(&_test_littlefs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT(littlefs_desc.fs.free.size != 0);
+    TEST_ASSERT_EQUAL_INT(0xff, state[0]);
+
+    /* allocating from the restored state does not corrupt existing files */
+    fd = vfs_open("/test-littlefs/test1.txt", O_CREAT | O_WRONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), vfs_write(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+
+    fd = vfs_open("/test-littlefs/test0.txt", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), vfs_read(fd, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(data, buf);
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+
+    /* a state saved before the last unmount is rejected */
+    static uint8_t old_state[sizeof(_mtd_emulated_memory1)];
+    res = vfs_umount(&_test_littlefs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    memcpy(old_state, state, sizeof(old_state));
+    res = vfs_mount(&_test_littlefs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    vfs_unlink("/test-littlefs/test1.txt");
+    res = vfs_umount(&_test_littlefs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    memcpy(mtd_emulated_dev1.memory, old_state, sizeof(old_state));
+    res = vfs_mount(&_test_littlefs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, littlefs_desc.fs.free.size);
+
+    /* a state is rejected if firmware that does not save the allocator state
+     * modified the file system in between, here in a subdirectory */
+    res = vfs_mkdir("/test-littlefs/a", 0);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_umount(&_test_littlefs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT(state[0] != 0xff);
+    littlefs_desc.state_dev = NULL;
+    res = vfs_mount(&_test_littlefs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    fd = vfs_open("/test-littlefs/a/test2.txt", O_CREAT | O_WRONLY, 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), vfs_write(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+    res = vfs_umount(&_test_littlefs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT(state[0] != 0xff);
+    littlefs_desc.state_dev = &mtd_emulated_dev1.base;
+    res = vfs_mount(&_test_littlefs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(0, littlefs_desc.fs.free.size);
+    TEST_ASSERT_EQUAL_INT(0xff, state[0]);
+
+    littlefs_desc.state_dev = NULL;
+}
+#endif
+
 Test *tests_littlefs(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -351,10 +476,14 @@ Test *tests_littlefs(void)
         new_TestFixture(tests_littlefs_mount_umount),
         new_TestFixture(tests_littlefs_open_close),
         new_TestFixture(tests_littlefs_write),
+        new_TestFixture(tests_littlefs_write_iol),
         new_TestFixture(tests_littlefs_unlink),
         new_TestFixture(tests_littlefs_readdir),
         new_TestFixture(tests_littlefs_rename),
         new_TestFixture(tests_littlefs_statvfs),
+#if IS_USED(MODULE_LITTLEFS2_PERSIST_LOOKAHEAD)
+        new_TestFixture(tests_littlefs_persist_lookahead),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(littlefs_tests, test_littlefs_setup, test_littlefs_teardown, fixtures);
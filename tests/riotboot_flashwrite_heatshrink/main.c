@@ -0,0 +1,172 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compressed riotboot flashwrite test
+ *
+ * Copies the start of the running image to the other slot, once
+ * uncompressed and once compressed with heatshrink, and prints the amount of
+ * data transferred and the time spent writing it.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "hashes/sha256.h"
+#include "heatshrink_encoder.h"
+#include "riotboot/flashwrite.h"
+#include "riotboot/slot.h"
+#include "ztimer.h"
+
+/* size of the chunks the image is transferred in, e.g. CoAP blocks */
+#define CHUNK_SIZE      (64U)
+
+static riotboot_flashwrite_t _writer;
+static heatshrink_encoder _encoder;
+/* heatshrink expands incompressible data by up to 1/8 */
+static uint8_t _compressed[IMAGE_SIZE + IMAGE_SIZE / 8 + 1];
+static size_t _compressed_len;
+static uint8_t _digest[SHA256_DIGEST_LENGTH];
+
+static const uint8_t *_image(void)
+{
+    return (const uint8_t *)riotboot_slot_get_hdr(riotboot_slot_current());
+}
+
+static size_t _compress(const uint8_t *data, size_t len, uint8_t *out,
+                        size_t out_len)
+{
+    size_t pos = 0;
+
+    heatshrink_encoder_reset(&_encoder);
+    while (len) {
+        size_t sunk = 0;
+        heatshrink_encoder_sink(&_encoder, (uint8_t *)data, len, &sunk);
+        data += sunk;
+        len -= sunk;
+
+        HSE_poll_res res;
+        do {
+            size_t written = 0;
+            res = heatshrink_encoder_poll(&_encoder, out + pos, out_len - pos,
+                                          &written);
+            pos += written;
+        } while (res == HSER_POLL_MORE);
+    }
+    while (heatshrink_encoder_finish(&_encoder) == HSER_FINISH_MORE) {
+        size_t written = 0;
+        heatshrink_encoder_poll(&_encoder, out + pos, out_len - pos, &written);
+        pos += written;
+    }
+
+    return pos;
+}
+
+static int _write(const uint8_t *data, size_t len, uint32_t *time)
+{
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+
+    for (size_t pos = 0; pos < len; pos += CHUNK_SIZE) {
+        size_t chunk = (len - pos < CHUNK_SIZE) ? len - pos : CHUNK_SIZE;
+        int res = riotboot_flashwrite_putbytes(&_writer, data + pos, chunk,
+                                               pos + chunk < len);
+        if (res) {
+            return res;
+        }
+    }
+    int res = riotboot_flashwrite_finish(&_writer);
+
+    *time = ztimer_now(ZTIMER_USEC) - start;
+    return res;
+}
+
+static void _check_and_invalidate(void)
+{
+    int slot = riotboot_slot_other();
+
+    TEST_ASSERT_EQUAL_INT(IMAGE_SIZE, _writer.offset);
+    TEST_ASSERT_EQUAL_INT(0, riotboot_flashwrite_verify_sha256(_digest,
+                                                               IMAGE_SIZE,
+                                                               slot));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(riotboot_slot_get_hdr(slot), _image(),
+                                    IMAGE_SIZE));
+    /* the copy is incomplete, keep the bootloader from selecting it */
+    riotboot_flashwrite_invalidate(slot);
+}
+
+static void test_flashwrite_uncompressed(void)
+{
+    uint32_t time;
+
+    riotboot_flashwrite_init(&_writer, riotboot_slot_other());
+
+    TEST_ASSERT_EQUAL_INT(0, _write(_image() + RIOTBOOT_FLASHWRITE_SKIPLEN,
+                                    IMAGE_SIZE - RIOTBOOT_FLASHWRITE_SKIPLEN,
+                                    &time));
+
+    printf("uncompressed: transferred %u bytes, written in %" PRIu32 " us\n",
+           (unsigned)IMAGE_SIZE, time);
+    _check_and_invalidate();
+}
+
+static void test_flashwrite_compressed(void)
+{
+    uint32_t time;
+
+    riotboot_flashwrite_init_compressed(&_writer, riotboot_slot_other());
+    TEST_ASSERT_EQUAL_INT(0, _write(_compressed, _compressed_len, &time));
+
+    printf("compressed: transferred %u bytes (%u%%), written in %" PRIu32 " us\n",
+           (unsigned)_compressed_len,
+           (unsigned)(_compressed_len * 100 / IMAGE_SIZE), time);
+    _check_and_invalidate();
+}
+
+static void test_flashwrite_compressed_invalid(void)
+{
+    /* a truncated stream must not produce the complete image */
+    uint32_t time;
+
+    riotboot_flashwrite_init_compressed(&_writer, riotboot_slot_other());
+    _write(_compressed, _compressed_len / 2, &time);
+    TEST_ASSERT(_writer.offset < IMAGE_SIZE);
+    riotboot_flashwrite_invalidate(riotboot_slot_other());
+}
+
+Test *tests_riotboot_flashwrite_heatshrink(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_flashwrite_uncompressed),
+        new_TestFixture(test_flashwrite_compressed),
+        new_TestFixture(test_flashwrite_compressed_invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(riotboot_flashwrite_heatshrink_tests, NULL, NULL,
+                        fixtures);
+
+    return (Test *)&riotboot_flashwrite_heatshrink_tests;
+}
+
+int main(void)
+{
+    sha256(_image(), IMAGE_SIZE, _digest);
+    _compressed_len = _compress(_image(), IMAGE_SIZE, _compressed,
+                                sizeof(_compressed));
+
+    TESTS_START();
+    TESTS_RUN(tests_riotboot_flashwrite_heatshrink());
+    TESTS_END();
+    return 0;
+}
+/** @} */
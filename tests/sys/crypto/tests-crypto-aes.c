@@ -87,6 +87,35 @@ static void test_crypto_aes_decrypt(void)
                                      AES_BLOCK_SIZE), "wrong plaintext");
 }
 
+static void test_crypto_aes_encrypt_expanded(void)
+{
+    aes_key_schedule_t schedule;
+    int err;
+    uint8_t input[2 * AES_BLOCK_SIZE];
+    uint8_t data[2 * AES_BLOCK_SIZE];
+
+    memcpy(input, TEST_0_INP, AES_BLOCK_SIZE);
+    memcpy(&input[AES_BLOCK_SIZE], TEST_1_INP, AES_BLOCK_SIZE);
+
+    err = aes_expand_key(&schedule, TEST_0_KEY, sizeof(TEST_0_KEY));
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    aes_encrypt_expanded(&schedule, input, data, 1);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_0_ENC, data,
+                                     AES_BLOCK_SIZE), "wrong ciphertext");
+
+    err = aes_expand_key(&schedule, TEST_1_KEY, sizeof(TEST_1_KEY));
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    /* the first block is encrypted with the second key as well */
+    aes_encrypt_expanded(&schedule, input, data, 2);
+    TEST_ASSERT_MESSAGE(1 == compare(TEST_1_ENC, &data[AES_BLOCK_SIZE],
+                                     AES_BLOCK_SIZE), "wrong ciphertext");
+
+    err = aes_expand_key(&schedule, TEST_1_KEY, 8);
+    TEST_ASSERT_EQUAL_INT(CIPHER_ERR_INVALID_KEY_SIZE, err);
+}
+
 static void test_crypto_aes_init_key_length(void)
 {
     cipher_context_t ctx;
@@ -105,6 +134,7 @@ Test *tests_crypto_aes_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_aes_encrypt),
         new_TestFixture(test_crypto_aes_decrypt),
+        new_TestFixture(test_crypto_aes_encrypt_expanded),
         new_TestFixture(test_crypto_aes_init_key_length),
     };
 
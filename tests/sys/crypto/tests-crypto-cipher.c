@@ -60,6 +60,41 @@ static void test_crypto_cipher_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == cmp, "wrong plaintext");
 }
 
+static void test_crypto_cipher_aes_blocks(void)
+{
+    cipher_t cipher;
+    int err;
+    uint8_t input[5 * 16];
+    uint8_t expected[sizeof(input)];
+    uint8_t data[sizeof(input)];
+
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i * 13;
+    }
+
+    err = cipher_init(&cipher, CIPHER_AES, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    for (unsigned i = 0; i < sizeof(input); i += 16) {
+        err = cipher_encrypt(&cipher, input + i, expected + i);
+        TEST_ASSERT_EQUAL_INT(1, err);
+    }
+
+    err = cipher_encrypt_blocks(&cipher, input, data, 5);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_MESSAGE(1 == compare(expected, data, sizeof(data)),
+                        "wrong ciphertext");
+
+    /* in place */
+    err = cipher_decrypt_blocks(&cipher, data, data, 5);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    TEST_ASSERT_MESSAGE(1 == compare(input, data, sizeof(data)),
+                        "wrong plaintext");
+
+    err = cipher_encrypt_blocks(&cipher, input, data, 0);
+    TEST_ASSERT_EQUAL_INT(1, err);
+}
+
 static void test_crypto_cipher_init_aes_key_length(void)
 {
     cipher_t cipher;
@@ -80,6 +115,7 @@ Test *tests_crypto_cipher_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_cipher_aes_encrypt),
         new_TestFixture(test_crypto_cipher_aes_decrypt),
+        new_TestFixture(test_crypto_cipher_aes_blocks),
         new_TestFixture(test_crypto_cipher_init_aes_key_length),
     };
 
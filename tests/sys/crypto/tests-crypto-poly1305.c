@@ -10,6 +10,7 @@
 #include "embUnit/embUnit.h"
 #include "tests-crypto.h"
 
+#include "container.h"
 #include "crypto/poly1305.h"
 
 #include <string.h>
@@ -281,6 +282,24 @@ static void test_crypto_poly1305_11(void)
     _test_poly1305(key_11, msg_11, sizeof(msg_11), tag_11);
 }
 
+static void test_crypto_poly1305_chunked(void)
+{
+    /* chunk sizes that complete, skip and split buffered blocks */
+    static const size_t chunks[] = { 1, 15, 17, 3, 32, 7 };
+    poly1305_ctx_t ctx;
+    uint8_t gen_tag[16];
+    size_t pos = 0;
+
+    poly1305_init(&ctx, key_3);
+    for (unsigned i = 0; i < ARRAY_SIZE(chunks); i++) {
+        poly1305_update(&ctx, &msg_3[pos], chunks[i]);
+        pos += chunks[i];
+    }
+    poly1305_update(&ctx, &msg_3[pos], sizeof(msg_3) - pos);
+    poly1305_finish(&ctx, gen_tag);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(gen_tag, tag_3, sizeof(gen_tag)));
+}
+
 Test *tests_crypto_poly1305_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -295,6 +314,7 @@ Test *tests_crypto_poly1305_tests(void)
         new_TestFixture(test_crypto_poly1305_9),
         new_TestFixture(test_crypto_poly1305_10),
         new_TestFixture(test_crypto_poly1305_11),
+        new_TestFixture(test_crypto_poly1305_chunked),
     };
     EMB_UNIT_TESTCALLER(crypto_poly1305_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_poly1305_tests;
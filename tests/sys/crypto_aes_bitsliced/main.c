@@ -0,0 +1 @@
+../crypto/main.c
\ No newline at end of file
@@ -0,0 +1 @@
+../crypto/tests-crypto-chacha.c
\ No newline at end of file
@@ -0,0 +1 @@
+../crypto/tests-crypto-cipher.c
\ No newline at end of file
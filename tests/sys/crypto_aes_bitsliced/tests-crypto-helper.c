@@ -0,0 +1 @@
+../crypto/tests-crypto-helper.c
\ No newline at end of file
@@ -0,0 +1 @@
+../crypto/tests-crypto-modes-cbc.c
\ No newline at end of file
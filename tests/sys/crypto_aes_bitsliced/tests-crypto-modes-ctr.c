@@ -0,0 +1 @@
+../crypto/tests-crypto-modes-ctr.c
\ No newline at end of file
@@ -0,0 +1 @@
+../crypto/tests-crypto-modes-ecb.c
\ No newline at end of file
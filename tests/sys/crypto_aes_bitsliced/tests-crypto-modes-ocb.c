@@ -0,0 +1 @@
+../crypto/tests-crypto-modes-ocb.c
\ No newline at end of file
@@ -0,0 +1 @@
+../crypto/tests-crypto-poly1305.c
\ No newline at end of file
@@ -0,0 +1 @@
+../crypto/tests-crypto.h
\ No newline at end of file
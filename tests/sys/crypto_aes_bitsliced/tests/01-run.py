@@ -0,0 +1 @@
+../../crypto/tests/01-run.py
\ No newline at end of file
@@ -0,0 +1,232 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for the Ed25519 verification contexts
+ *
+ * Test vectors 1 to 3 are from RFC 8032, section 7.1. The longer messages
+ * are signed with the key of test vector 1.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ed25519_verify.h"
+#include "edsign.h"
+#include "embUnit.h"
+
+#define LONG_MSG_SIZE   (300U)
+
+static const uint8_t _pub1[] = {
+    0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7,
+    0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+    0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25,
+    0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a,
+};
+
+static const uint8_t _sig1[] = {
+    0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72,
+    0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+    0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74,
+    0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+    0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac,
+    0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+    0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24,
+    0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b,
+};
+
+static const uint8_t _pub2[] = {
+    0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a,
+    0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+    0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c,
+    0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c,
+};
+
+static const uint8_t _sig2[] = {
+    0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8,
+    0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+    0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f,
+    0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+    0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e,
+    0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+    0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee,
+    0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00,
+};
+
+static const uint8_t _pub3[] = {
+    0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3,
+    0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+    0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac,
+    0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25,
+};
+
+static const uint8_t _sig3[] = {
+    0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02,
+    0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+    0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44,
+    0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+    0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90,
+    0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+    0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d,
+    0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a,
+};
+
+static const uint8_t _sig1_64[] = {
+    0x2d, 0xc5, 0x73, 0x6c, 0x51, 0x88, 0xaa, 0x2a,
+    0x61, 0x57, 0x68, 0xc4, 0x65, 0xcf, 0x49, 0x93,
+    0x4f, 0x56, 0x1c, 0xbf, 0xdd, 0xc4, 0xeb, 0xf8,
+    0xcf, 0xb6, 0xcf, 0x32, 0x3e, 0xfc, 0x2e, 0x71,
+    0xc9, 0x1b, 0x48, 0xcb, 0x26, 0xc2, 0x69, 0x9c,
+    0xe2, 0xf5, 0x6e, 0x24, 0xac, 0xe6, 0xdc, 0xc5,
+    0x1f, 0x9c, 0xc7, 0xfb, 0x99, 0x2a, 0x55, 0xc8,
+    0x33, 0xc0, 0x88, 0x91, 0x11, 0xf4, 0xba, 0x03,
+};
+
+static const uint8_t _sig1_300[] = {
+    0xb1, 0x7c, 0x42, 0x83, 0x2c, 0x88, 0xfa, 0xcb,
+    0x5f, 0xa3, 0x22, 0xb5, 0x32, 0x93, 0xdb, 0xef,
+    0x80, 0x9d, 0x7f, 0xb0, 0xb4, 0x54, 0x17, 0x5d,
+    0xf9, 0xd6, 0x5e, 0x9a, 0xdb, 0x96, 0x57, 0x90,
+    0x46, 0xc7, 0x5c, 0x05, 0xe5, 0x1f, 0x32, 0x76,
+    0x0c, 0xec, 0x24, 0x75, 0x5c, 0x66, 0xf3, 0x93,
+    0x43, 0x1b, 0xab, 0x29, 0x05, 0xa4, 0xf3, 0x87,
+    0x21, 0x69, 0x76, 0xce, 0xef, 0x57, 0x78, 0x0f,
+};
+
+static const uint8_t _msg2[] = { 0x72 };
+static const uint8_t _msg3[] = { 0xaf, 0x82 };
+
+/* y = 2 is not the y coordinate of a point */
+static const uint8_t _pub_invalid[ED25519_VERIFY_PUBKEY_SIZE] = { 0x02 };
+
+static uint8_t _long_msg[LONG_MSG_SIZE];
+static uint8_t _sig[ED25519_VERIFY_SIGNATURE_SIZE];
+static ed25519_verify_ctx_t _ctx;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < sizeof(_long_msg); i++) {
+        _long_msg[i] = i;
+    }
+}
+
+static void test_ed25519_verify_rfc8032(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub1));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig1, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub2));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig2, _msg2, sizeof(_msg2)));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub3));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig3, _msg3, sizeof(_msg3)));
+}
+
+static void test_ed25519_verify_long(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub1));
+    /* the message ends the first hash block */
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig1_64, _long_msg, 64));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig1_300, _long_msg,
+                                            sizeof(_long_msg)));
+    /* the same key verifies other messages */
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig1, NULL, 0));
+}
+
+static void test_ed25519_verify_invalid(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub1));
+
+    /* wrong message */
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig1_300, _long_msg,
+                                                   sizeof(_long_msg) - 1));
+    _long_msg[100] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig1_300, _long_msg,
+                                                   sizeof(_long_msg)));
+
+    /* wrong key */
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig2, _msg2, sizeof(_msg2)));
+
+    /* modified R */
+    memcpy(_sig, _sig1, sizeof(_sig));
+    _sig[0] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig, NULL, 0));
+
+    /* modified s */
+    memcpy(_sig, _sig1, sizeof(_sig));
+    _sig[32] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig, NULL, 0));
+}
+
+static void test_ed25519_verify_unreduced(void)
+{
+    /* s + l is the same scalar, but is rejected as non-canonical */
+    static const uint8_t order[] = {
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+        0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+    };
+    unsigned carry = 0;
+
+    memcpy(_sig, _sig1, sizeof(_sig));
+    for (unsigned i = 0; i < sizeof(order); i++) {
+        carry += _sig[32 + i] + order[i];
+        _sig[32 + i] = carry;
+        carry >>= 8;
+    }
+    TEST_ASSERT_EQUAL_INT(0, carry);
+
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub1));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig, NULL, 0));
+}
+
+static void test_ed25519_verify_init_invalid(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ed25519_verify_init(&_ctx, _pub_invalid));
+}
+
+static void test_ed25519_verify_edsign(void)
+{
+    /* both implementations agree */
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify_init(&_ctx, _pub1));
+    TEST_ASSERT(edsign_verify(_sig1_300, _pub1, _long_msg, sizeof(_long_msg)));
+    TEST_ASSERT_EQUAL_INT(0, ed25519_verify(&_ctx, _sig1_300, _long_msg,
+                                            sizeof(_long_msg)));
+    _long_msg[0] ^= 0x80;
+    TEST_ASSERT(!edsign_verify(_sig1_300, _pub1, _long_msg, sizeof(_long_msg)));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, ed25519_verify(&_ctx, _sig1_300, _long_msg,
+                                                   sizeof(_long_msg)));
+}
+
+static Test *tests_ed25519_verify(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ed25519_verify_rfc8032),
+        new_TestFixture(test_ed25519_verify_long),
+        new_TestFixture(test_ed25519_verify_invalid),
+        new_TestFixture(test_ed25519_verify_unreduced),
+        new_TestFixture(test_ed25519_verify_init_invalid),
+        new_TestFixture(test_ed25519_verify_edsign),
+    };
+
+    EMB_UNIT_TESTCALLER(ed25519_verify_tests, set_up, NULL, fixtures);
+    return (Test *)&ed25519_verify_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_ed25519_verify());
+    TESTS_END();
+
+    return 0;
+}
@@ -82,10 +82,34 @@ static void test_prng_sha256prng_seed2_u8(void)
     }
 }
 
+static void test_prng_sha256prng_reseed(void)
+{
+    uint32_t test32[ARRAY_SIZE(seq_seed1)];
+    uint8_t byte;
+
+    /* leave output of the previous seed in the buffer */
+    random_init(11799121);
+    random_bytes(&byte, sizeof(byte));
+
+    /* reseeding must discard it */
+    random_init(1);
+    for (unsigned i = 0; i < ARRAY_SIZE(seq_seed1); i++) {
+        test32[i] = random_uint32();
+    }
+
+    if (!(memcmp(test32, seq_seed1, sizeof(seq_seed1)))) {
+        printf("%s:SUCCESS\n", __func__);
+    }
+    else {
+        printf("%s:FAILURE\n", __func__);
+    }
+}
+
 int main(void)
 {
     test_prng_sha256prng_seed1_u32();
     test_prng_sha256prng_seed2_u8();
+    test_prng_sha256prng_reseed();
 
     return 0;
 }
@@ -13,6 +13,7 @@ from testrunner import run
 def testfunc(child):
     child.expect("test_prng_sha256prng_seed1_u32:SUCCESS\r\n")
     child.expect("test_prng_sha256prng_seed2_u8:SUCCESS\r\n")
+    child.expect("test_prng_sha256prng_reseed:SUCCESS\r\n")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,141 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SUIT delta payload test
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "suit.h"
+#include "suit/delta.h"
+#include "suit/storage.h"
+
+#include "blob/source.bin.h"
+#include "blob/target.bin.h"
+#include "blob/delta.bin.h"
+
+#define SOURCE_LOCATION ".ram.0"
+#define TARGET_LOCATION ".ram.1"
+
+static suit_manifest_t _manifest;
+static suit_delta_t _delta;
+static suit_storage_t *_storage;
+
+static void setup(void)
+{
+    _storage = suit_storage_find_by_id(SOURCE_LOCATION);
+    TEST_ASSERT_NOT_NULL(_storage);
+    suit_storage_init(_storage);
+
+    suit_storage_set_active_location(_storage, SOURCE_LOCATION);
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_storage_start(_storage, &_manifest,
+                                                      source_bin_len));
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_storage_write(_storage, &_manifest,
+                                                      source_bin, 0,
+                                                      source_bin_len));
+    suit_storage_finish(_storage, &_manifest);
+
+    suit_storage_set_active_location(_storage, TARGET_LOCATION);
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_storage_start(_storage, &_manifest,
+                                                      target_bin_len));
+}
+
+static int _apply(size_t chunk, size_t len, size_t target_size)
+{
+    int res = suit_delta_start(&_delta, &_manifest, _storage, SOURCE_LOCATION,
+                               _storage, TARGET_LOCATION, target_size);
+
+    for (size_t pos = 0; (res == SUIT_OK) && (pos < len); pos += chunk) {
+        res = suit_delta_write(&_delta, &delta_bin[pos],
+                               (len - pos < chunk) ? len - pos : chunk);
+    }
+    if (res == SUIT_OK) {
+        res = suit_delta_finish(&_delta);
+    }
+    return res;
+}
+
+static void _check_target(void)
+{
+    uint8_t buf[sizeof(target_bin)];
+
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_storage_read(_storage, buf, 0,
+                                                     sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, target_bin, sizeof(buf)));
+}
+
+static void test_suit_delta_apply(void)
+{
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, _apply(delta_bin_len, delta_bin_len,
+                                          target_bin_len));
+    _check_target();
+}
+
+static void test_suit_delta_apply_chunked(void)
+{
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, _apply(1, delta_bin_len, target_bin_len));
+    _check_target();
+
+    setup();
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, _apply(7, delta_bin_len, target_bin_len));
+    _check_target();
+}
+
+static void test_suit_delta_truncated(void)
+{
+    TEST_ASSERT(_apply(delta_bin_len, delta_bin_len - 1, target_bin_len)
+                != SUIT_OK);
+}
+
+static void test_suit_delta_exceeds_size(void)
+{
+    TEST_ASSERT(_apply(delta_bin_len, delta_bin_len, target_bin_len - 1)
+                != SUIT_OK);
+    setup();
+    TEST_ASSERT(_apply(delta_bin_len, delta_bin_len, target_bin_len + 1)
+                != SUIT_OK);
+}
+
+static void test_suit_delta_installed(void)
+{
+    /* the RAM storage has no notion of an installed payload */
+    TEST_ASSERT_EQUAL_INT(SUIT_ERR_UNSUPPORTED,
+                          suit_delta_start(&_delta, &_manifest, _storage, NULL,
+                                           _storage, TARGET_LOCATION,
+                                           target_bin_len));
+}
+
+Test *tests_suit_delta(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_suit_delta_apply),
+        new_TestFixture(test_suit_delta_apply_chunked),
+        new_TestFixture(test_suit_delta_truncated),
+        new_TestFixture(test_suit_delta_exceeds_size),
+        new_TestFixture(test_suit_delta_installed),
+    };
+
+    EMB_UNIT_TESTCALLER(suit_delta_tests, setup, NULL, fixtures);
+
+    return (Test *)&suit_delta_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_suit_delta());
+    TESTS_END();
+    return 0;
+}
+/** @} */
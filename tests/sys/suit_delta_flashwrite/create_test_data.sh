@@ -0,0 +1,32 @@
+#!/bin/sh
+
+set -e
+
+python3 gen_delta.py "${MANIFEST_DIR}/target.bin" "${MANIFEST_DIR}/delta.bin"
+
+# the sequence number is newer than any APP_VER of the running image
+"${RIOTBASE}/dist/tools/suit/gen_manifest.py" \
+  --urlroot "test://test" \
+  --seqnr "$((0xffffffff))" \
+  --uuid-vendor "riot-os.org" \
+  --uuid-class "${BOARD}" \
+  -o "${MANIFEST_DIR}/manifest.json" \
+  "${MANIFEST_DIR}/target.bin"
+
+# the payload is a delta against the installed firmware
+python3 - "${MANIFEST_DIR}/manifest.json" <<PYTHON
+import json
+import sys
+
+with open(sys.argv[1]) as f:
+    manifest = json.load(f)
+component = manifest["components"][0]
+component["source-component"] = component["install-id"]
+with open(sys.argv[1], "w") as f:
+    json.dump(manifest, f, indent=4)
+PYTHON
+
+"${SUIT_TOOL}" create -f suit -i "${MANIFEST_DIR}/manifest.json" \
+  -o "${MANIFEST_DIR}/manifest.bin.unsigned"
+"${SUIT_TOOL}" sign -k "${SUIT_SEC}" -m "${MANIFEST_DIR}/manifest.bin.unsigned" \
+  -o "${MANIFEST_DIR}/manifest.bin"
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Assemble a VCDIFF delta that builds its target mostly from copies of
+itself.
+
+The target starts with 16 literal bytes. Each following COPY doubles it by
+copying everything written so far, so every COPY reads back data that was
+just written to the target storage.
+"""
+
+import argparse
+
+# The riotboot flashwrite backend expects the magic number at the start
+PATTERN = b"RIOT" + bytes(range(0x10, 0x1c))
+COPIES = 9
+
+VCD_SOURCE = 0x01
+# instruction codes of the default code table with the size in a varint
+ADD = 0x01
+COPY_SELF = 0x13
+
+
+def varint(value):
+    out = [value & 0x7f]
+    value >>= 7
+    while value:
+        out.insert(0, 0x80 | (value & 0x7f))
+        value >>= 7
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("target", help="decoded payload output path")
+    parser.add_argument("delta", help="VCDIFF delta output path")
+    args = parser.parse_args()
+
+    target = PATTERN
+    # a single byte of source is declared but never copied, target
+    # addresses follow it
+    source_len = 1
+    inst = bytes([ADD]) + varint(len(PATTERN)) + PATTERN
+    for _ in range(COPIES):
+        inst += bytes([COPY_SELF]) + varint(len(target)) + varint(source_len)
+        target += target
+
+    # interleaved format: data and addresses are part of the instructions
+    body = varint(len(target)) + bytes([0]) + varint(0) + varint(len(inst)) + \
+        varint(0) + inst
+    window = bytes([VCD_SOURCE]) + varint(source_len) + varint(0) + \
+        varint(len(body)) + body
+    delta = b"\xd6\xc3\xc4\x53\x00" + window
+
+    with open(args.target, "wb") as f:
+        f.write(target)
+    with open(args.delta, "wb") as f:
+        f.write(delta)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SUIT delta payload test on the riotboot flashwrite backend
+ *
+ * Processes a manifest whose payload is a VCDIFF delta against the running
+ * firmware. The delta builds the payload mostly from copies of data it
+ * wrote before, so it reads back data that may not have reached the flash
+ * yet.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "riotboot/flashwrite.h"
+#include "riotboot/slot.h"
+#include "suit.h"
+#include "suit/storage.h"
+#include "suit/transport/mock.h"
+
+#define TEST_MANIFEST_INCLUDE(file) <blob/bin/BOARD_NAME_UNQ/manifests/file>
+
+/* cppcheck-suppress preprocessorErrorDirective
+ * (reason: board-dependent include paths) */
+#include TEST_MANIFEST_INCLUDE(manifest.bin.h)
+#include TEST_MANIFEST_INCLUDE(delta.bin.h)
+
+const suit_transport_mock_payload_t payloads[] = {
+    {
+        .buf = delta_bin,
+        .len = sizeof(delta_bin),
+    },
+};
+
+const size_t num_payloads = ARRAY_SIZE(payloads);
+
+static void test_suit_delta_flashwrite_target_copy(void)
+{
+    char url[CONFIG_SOCK_URLPATH_MAXLEN];
+    suit_manifest_t manifest;
+
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.urlbuf = url;
+    manifest.urlbuf_len = sizeof(url);
+
+    /* the image match condition fails if a copy read stale flash */
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_parse(&manifest, manifest_bin,
+                                              sizeof(manifest_bin)));
+
+    /* the payload is no firmware, keep the bootloader from selecting it */
+    riotboot_flashwrite_invalidate(riotboot_slot_other());
+}
+
+Test *tests_suit_delta_flashwrite(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_suit_delta_flashwrite_target_copy),
+    };
+
+    EMB_UNIT_TESTCALLER(suit_delta_flashwrite_tests, NULL, NULL, fixtures);
+
+    return (Test *)&suit_delta_flashwrite_tests;
+}
+
+int main(void)
+{
+    suit_storage_init_all();
+
+    TESTS_START();
+    TESTS_RUN(tests_suit_delta_flashwrite());
+    TESTS_END();
+    return 0;
+}
+/** @} */
@@ -16,6 +16,7 @@
  * @author     Kaspar Schleiser <kaspar@schleiser.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "kernel_defines.h"
@@ -25,6 +26,7 @@
 #include "suit/storage.h"
 #include "suit/transport/mock.h"
 #include "embUnit.h"
+#include "ztimer.h"
 
 #define TEST_MANIFEST_INCLUDE(file) <blob/bin/BOARD_NAME_UNQ/manifests/file>
 
@@ -95,9 +97,12 @@ static void test_suit_manifest_01_manifests(void)
     suit_storage_set_seq_no_all(1);
     for (unsigned i = 0; i < manifest_blobs_numof; i++) {
         printf("\n--- testing manifest %u\n", i);
+        uint32_t start = ztimer_now(ZTIMER_USEC);
         int res = \
             test_suit_manifest(manifest_blobs[i].data, manifest_blobs[i].len);
-        printf("---- res=%i (expected=%i)\n", res, manifest_blobs[i].expected);
+        uint32_t duration = ztimer_now(ZTIMER_USEC) - start;
+        printf("---- res=%i (expected=%i) in %" PRIu32 " us\n", res,
+               manifest_blobs[i].expected, duration);
         TEST_ASSERT_EQUAL_INT(manifest_blobs[i].expected, res);
     }
 }
@@ -0,0 +1,98 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SUIT flashwrite storage test
+ *
+ * Writes the start of the running image to the other slot and checks the
+ * digest computed while writing, as the image match condition of the install
+ * and the validate sequence of a manifest does.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "hashes/sha256.h"
+#include "riotboot/flashwrite.h"
+#include "riotboot/slot.h"
+#include "suit.h"
+#include "suit/storage.h"
+
+/* size of the chunks the image is transferred in, e.g. CoAP blocks */
+#define CHUNK_SIZE      (64U)
+
+static suit_storage_t *_storage;
+static uint8_t _expected[SHA256_DIGEST_LENGTH];
+
+static const uint8_t *_image(void)
+{
+    return (const uint8_t *)riotboot_slot_get_hdr(riotboot_slot_current());
+}
+
+static void _check_digest(void)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    size_t len = 0;
+
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_storage_get_digest(_storage, digest,
+                                                           &len));
+    TEST_ASSERT_EQUAL_INT(IMAGE_SIZE, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(digest, _expected, sizeof(digest)));
+}
+
+static void test_suit_storage_flashwrite_digest(void)
+{
+    TEST_ASSERT(suit_storage_has_digest(_storage));
+    TEST_ASSERT_EQUAL_INT(0, suit_storage_start(_storage, NULL, IMAGE_SIZE));
+    for (size_t pos = 0; pos < IMAGE_SIZE; pos += CHUNK_SIZE) {
+        size_t chunk = (IMAGE_SIZE - pos < CHUNK_SIZE) ? IMAGE_SIZE - pos
+                                                       : CHUNK_SIZE;
+        TEST_ASSERT_EQUAL_INT(0, suit_storage_write(_storage, NULL,
+                                                    _image() + pos, pos,
+                                                    chunk));
+    }
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_storage_finish(_storage, NULL));
+
+    /* install sequence */
+    _check_digest();
+    TEST_ASSERT_EQUAL_INT(0, suit_storage_install(_storage, NULL));
+    /* validate sequence */
+    _check_digest();
+    _check_digest();
+
+    /* the copy is incomplete, keep the bootloader from selecting it */
+    riotboot_flashwrite_invalidate(riotboot_slot_other());
+}
+
+Test *tests_suit_storage_flashwrite(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_suit_storage_flashwrite_digest),
+    };
+
+    EMB_UNIT_TESTCALLER(suit_storage_flashwrite_tests, NULL, NULL, fixtures);
+
+    return (Test *)&suit_storage_flashwrite_tests;
+}
+
+int main(void)
+{
+    sha256(_image(), IMAGE_SIZE, _expected);
+    suit_storage_init_all();
+    _storage = suit_storage_find_by_id("");
+
+    TESTS_START();
+    TESTS_RUN(tests_suit_storage_flashwrite());
+    TESTS_END();
+    return 0;
+}
+/** @} */
@@ -0,0 +1,273 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Time-series log test
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "mtd_emulated.h"
+#include "tslog.h"
+
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT    4
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 2
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE       64
+#endif
+
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+
+/* record layout in flash: 8 byte header + payload */
+#define SAMPLE_SIZE     (8U)
+#define RECORD_SIZE     (8U + SAMPLE_SIZE)
+
+MTD_EMULATED_DEV(0, SECTOR_COUNT, PAGE_PER_SECTOR, PAGE_SIZE);
+
+static mtd_dev_t *_dev = &mtd_emulated_dev0.base;
+static tslog_t _log;
+
+static void _sample(uint32_t ts, uint8_t *buf)
+{
+    for (unsigned i = 0; i < SAMPLE_SIZE; i++) {
+        buf[i] = ts * 3 + i;
+    }
+}
+
+static void _append_range(uint32_t first, uint32_t last)
+{
+    uint8_t buf[SAMPLE_SIZE];
+
+    for (uint32_t ts = first; ts <= last; ts++) {
+        _sample(ts, buf);
+        TEST_ASSERT_EQUAL_INT(0, tslog_append(&_log, ts, buf, sizeof(buf)));
+    }
+}
+
+/* checks that the range contains consecutive records, returns the first one */
+static int _check_range(uint32_t from, uint32_t to, uint32_t *first, unsigned *numof)
+{
+    tslog_iter_t it;
+    uint8_t buf[SAMPLE_SIZE];
+    uint8_t expected[SAMPLE_SIZE];
+    uint32_t ts;
+    int res;
+
+    *numof = 0;
+    if (tslog_iter_init(&_log, &it, from, to)) {
+        return -1;
+    }
+    while ((res = tslog_iter_next(&it, &ts, buf, sizeof(buf))) > 0) {
+        if (res != SAMPLE_SIZE || ts < from || ts > to) {
+            return -1;
+        }
+        if (*numof == 0) {
+            *first = ts;
+        }
+        else if (ts != *first + *numof) {
+            return -1;
+        }
+        _sample(ts, expected);
+        if (memcmp(buf, expected, sizeof(buf))) {
+            return -1;
+        }
+        (*numof)++;
+    }
+    return res;
+}
+
+static void setup(void)
+{
+    _dev->write_size = 1;
+    tslog_init(&_log, _dev);
+    tslog_erase(&_log);
+}
+
+static void test_tslog_empty(void)
+{
+    uint32_t first;
+    unsigned numof;
+
+    TEST_ASSERT_EQUAL_INT(0, _check_range(0, UINT32_MAX, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(0, numof);
+}
+
+static void test_tslog_append_read(void)
+{
+    uint32_t first;
+    unsigned numof;
+
+    _append_range(100, 110);
+    TEST_ASSERT_EQUAL_INT(0, _check_range(0, UINT32_MAX, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(100, first);
+    TEST_ASSERT_EQUAL_INT(11, numof);
+}
+
+static void test_tslog_invalid(void)
+{
+    uint8_t buf[SECTOR_SIZE] = { 0 };
+
+    TEST_ASSERT_EQUAL_INT(0, tslog_append(&_log, 10, buf, 1));
+    TEST_ASSERT_EQUAL_INT(0, tslog_append(&_log, 10, buf, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, tslog_append(&_log, 9, buf, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, tslog_append(&_log, 11, buf, 0));
+    TEST_ASSERT_EQUAL_INT(-EFBIG, tslog_append(&_log, 11, buf,
+                                               tslog_record_size_max(&_log) + 1));
+    TEST_ASSERT_EQUAL_INT(0, tslog_append(&_log, 11, buf,
+                                          tslog_record_size_max(&_log)));
+
+    tslog_iter_t it;
+    tslog_iter_init(&_log, &it, 11, 11);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, tslog_iter_next(&it, NULL, buf, 1));
+    TEST_ASSERT_EQUAL_INT(0, tslog_iter_next(&it, NULL, buf, sizeof(buf)));
+}
+
+static void test_tslog_range(void)
+{
+    uint32_t first;
+    unsigned numof;
+
+    /* spans multiple sectors */
+    _append_range(0, 15);
+    TEST_ASSERT_EQUAL_INT(0, _check_range(5, 12, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(5, first);
+    TEST_ASSERT_EQUAL_INT(8, numof);
+
+    /* first record of a sector */
+    const uint32_t per_sector = (SECTOR_SIZE - 16) / RECORD_SIZE;
+    TEST_ASSERT_EQUAL_INT(0, _check_range(per_sector, per_sector, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(per_sector, first);
+    TEST_ASSERT_EQUAL_INT(1, numof);
+
+    TEST_ASSERT_EQUAL_INT(0, _check_range(16, 100, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(0, numof);
+}
+
+static void test_tslog_wrap(void)
+{
+    const uint32_t per_sector = (SECTOR_SIZE - 16) / RECORD_SIZE;
+    const uint32_t last = 10 * per_sector * SECTOR_COUNT;
+    uint32_t first;
+    unsigned numof;
+
+    _append_range(1, last);
+    TEST_ASSERT_EQUAL_INT(0, _check_range(0, UINT32_MAX, &first, &numof));
+    /* the oldest sector is erased when the ring is full */
+    TEST_ASSERT(numof > (SECTOR_COUNT - 1) * per_sector);
+    TEST_ASSERT(numof <= SECTOR_COUNT * per_sector);
+    TEST_ASSERT_EQUAL_INT(last, first + numof - 1);
+
+    /* iterators skip sectors that are overwritten, only records of the
+     * previously newest sector may remain */
+    tslog_iter_t it;
+    uint8_t buf[SAMPLE_SIZE];
+    uint32_t ts;
+    tslog_iter_init(&_log, &it, 0, UINT32_MAX);
+    _append_range(last + 1, last + SECTOR_COUNT * per_sector);
+    TEST_ASSERT_EQUAL_INT(SAMPLE_SIZE, tslog_iter_next(&it, &ts, buf, sizeof(buf)));
+    TEST_ASSERT(ts > last - per_sector);
+}
+
+static void test_tslog_recover(void)
+{
+    uint32_t first;
+    unsigned numof;
+
+    _append_range(1, 10);
+    TEST_ASSERT_EQUAL_INT(0, tslog_init(&_log, _dev));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, tslog_append(&_log, 9, "x", 1));
+    _append_range(11, 20);
+    TEST_ASSERT_EQUAL_INT(0, _check_range(0, UINT32_MAX, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(1, first);
+    TEST_ASSERT_EQUAL_INT(20, numof);
+}
+
+static void test_tslog_recover_torn(void)
+{
+    uint32_t first;
+    unsigned numof;
+
+    /* one record in the second sector */
+    const uint32_t per_sector = (SECTOR_SIZE - 16) / RECORD_SIZE;
+    _append_range(1, per_sector + 1);
+
+    /* corrupt the payload of the last record */
+    mtd_emulated_dev0.memory[SECTOR_SIZE + 16 + 8] ^= 0x01;
+
+    TEST_ASSERT_EQUAL_INT(0, tslog_init(&_log, _dev));
+    TEST_ASSERT_EQUAL_INT(0, _check_range(0, UINT32_MAX, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(1, first);
+    TEST_ASSERT_EQUAL_INT(per_sector, numof);
+
+    /* new records go to the next sector */
+    _append_range(per_sector + 2, per_sector + 2);
+    TEST_ASSERT_EQUAL_INT(0, _check_range(per_sector + 1, UINT32_MAX, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(per_sector + 2, first);
+    TEST_ASSERT_EQUAL_INT(1, numof);
+}
+
+static void test_tslog_write_size(void)
+{
+    uint32_t first;
+    unsigned numof;
+
+    _dev->write_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, tslog_init(&_log, _dev));
+    TEST_ASSERT_EQUAL_INT(0, tslog_erase(&_log));
+
+    _append_range(1, 20);
+    TEST_ASSERT_EQUAL_INT(0, tslog_append(&_log, 21, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(0, tslog_init(&_log, _dev));
+    TEST_ASSERT_EQUAL_INT(0, _check_range(0, 20, &first, &numof));
+    TEST_ASSERT_EQUAL_INT(1, first);
+    TEST_ASSERT_EQUAL_INT(20, numof);
+
+    /* records are padded to the write size */
+    TEST_ASSERT_EQUAL_INT(0, _log.offset % 16);
+
+    _dev->write_size = CONFIG_TSLOG_WRITE_SIZE_MAX * 2;
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, tslog_init(&_log, _dev));
+}
+
+Test *tests_tslog(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tslog_empty),
+        new_TestFixture(test_tslog_append_read),
+        new_TestFixture(test_tslog_invalid),
+        new_TestFixture(test_tslog_range),
+        new_TestFixture(test_tslog_wrap),
+        new_TestFixture(test_tslog_recover),
+        new_TestFixture(test_tslog_recover_torn),
+        new_TestFixture(test_tslog_write_size),
+    };
+
+    EMB_UNIT_TESTCALLER(tslog_tests, setup, NULL, fixtures);
+
+    return (Test *)&tslog_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_tslog());
+    TESTS_END();
+    return 0;
+}
+/** @} */
@@ -56,6 +56,19 @@ static void test_checksum_crc32_sequence_4bytes(void)
     TEST_ASSERT_EQUAL_INT(expect, crc32(buf, sizeof(buf)));
 }
 
+static void test_checksum_crc32_update(void)
+{
+    unsigned char buf[] = "123456789";
+    uint32_t expect = 0xcbf43926;
+
+    /* split at every offset, unaligned and across the sliced blocks */
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        uint32_t crc = crc32_update(0, buf, i);
+        TEST_ASSERT_EQUAL_INT(expect,
+                              crc32_update(crc, &buf[i], sizeof(buf) - 1 - i));
+    }
+}
+
 Test *tests_checksum_crc32_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -64,6 +77,7 @@ Test *tests_checksum_crc32_tests(void)
         new_TestFixture(test_checksum_crc32_sequence_256a),
         new_TestFixture(test_checksum_crc32_sequence_1to9),
         new_TestFixture(test_checksum_crc32_sequence_4bytes),
+        new_TestFixture(test_checksum_crc32_update),
     };
 
     EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
@@ -0,0 +1,89 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "checksum/crc32.h"
+#include "tests-checksum.h"
+
+static void test_checksum_crc32c_sequence_empty(void)
+{
+    unsigned char buf[] = "";
+    uint32_t expect = 0x0;
+
+    TEST_ASSERT_EQUAL_INT(expect, crc32c(buf, sizeof(buf) - 1));
+}
+
+static void test_checksum_crc32c_sequence_1a(void)
+{
+    unsigned char buf[] = "A";
+    uint32_t expect = 0xe16dcdee;
+
+    TEST_ASSERT_EQUAL_INT(expect, crc32c(buf, sizeof(buf) - 1));
+}
+
+static void test_checksum_crc32c_sequence_256a(void)
+{
+    unsigned char buf[256];
+    uint32_t expect = 0xfc55f5e7;
+
+    memset(buf, 'A', sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(expect, crc32c(buf, sizeof(buf)));
+}
+
+static void test_checksum_crc32c_sequence_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+    uint32_t expect = 0xe3069283;
+
+    TEST_ASSERT_EQUAL_INT(expect, crc32c(buf, sizeof(buf) - 1));
+}
+
+/* RFC 3720, B.4 */
+static void test_checksum_crc32c_rfc3720(void)
+{
+    unsigned char buf[32];
+
+    memset(buf, 0x00, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0x8a9136aa, crc32c(buf, sizeof(buf)));
+
+    memset(buf, 0xff, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0x62a8ab43, crc32c(buf, sizeof(buf)));
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i;
+    }
+    TEST_ASSERT_EQUAL_INT(0x46dd794e, crc32c(buf, sizeof(buf)));
+}
+
+static void test_checksum_crc32c_update(void)
+{
+    unsigned char buf[] = "123456789";
+    uint32_t expect = 0xe3069283;
+
+    /* split at every offset, unaligned and across the sliced blocks */
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        uint32_t crc = crc32c_update(0, buf, i);
+        TEST_ASSERT_EQUAL_INT(expect,
+                              crc32c_update(crc, &buf[i], sizeof(buf) - 1 - i));
+    }
+}
+
+Test *tests_checksum_crc32c_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_checksum_crc32c_sequence_empty),
+        new_TestFixture(test_checksum_crc32c_sequence_1a),
+        new_TestFixture(test_checksum_crc32c_sequence_256a),
+        new_TestFixture(test_checksum_crc32c_sequence_1to9),
+        new_TestFixture(test_checksum_crc32c_rfc3720),
+        new_TestFixture(test_checksum_crc32c_update),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32c_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32c_tests;
+}
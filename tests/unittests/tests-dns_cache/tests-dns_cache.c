@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <string.h>
 #include "net/af.h"
+#include "net/ipv4/addr.h"
 #include "net/ipv6.h"
 #include "ztimer.h"
 
@@ -51,11 +52,71 @@ static void test_dns_cache_add_ttl0(void)
     TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.com", &addr_out, AF_INET6));
 }
 
+static void test_dns_cache_a_aaaa(void)
+{
+    ipv6_addr_t addr6_in = IPV6_ADDR_ALL_NODES_IF_LOCAL;
+    ipv4_addr_t addr4_in = { .u8 = { 192, 0, 2, 1 } };
+    ipv6_addr_t addr_out;
+
+    /* A and AAAA records of the same name expire independently */
+    dns_cache_add("example.com", &addr4_in, sizeof(addr4_in), 1);
+    dns_cache_add("example.com", &addr6_in, sizeof(addr6_in), 3);
+    TEST_ASSERT_EQUAL_INT(sizeof(addr4_in), dns_cache_query("example.com", &addr_out, AF_INET));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&addr4_in, &addr_out, sizeof(addr4_in)));
+    TEST_ASSERT_EQUAL_INT(sizeof(addr6_in), dns_cache_query("example.com", &addr_out, AF_INET6));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&addr6_in, &addr_out, sizeof(addr6_in)));
+
+    ztimer_sleep(ZTIMER_USEC, 2000000);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.com", &addr_out, AF_INET));
+    TEST_ASSERT_EQUAL_INT(sizeof(addr6_in), dns_cache_query("example.com", &addr_out, AF_UNSPEC));
+
+    dns_cache_add("example.com", &addr6_in, sizeof(addr6_in), 0);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query("example.com", &addr_out, AF_UNSPEC));
+}
+
+static void test_dns_cache_evict(void)
+{
+    char name[] = "host0.example.com";
+    ipv6_addr_t addr_in = IPV6_ADDR_ALL_NODES_IF_LOCAL;
+    ipv6_addr_t addr_out;
+
+    /* fill the cache, host0 is the first entry to expire */
+    for (unsigned i = 0; i < CONFIG_DNS_CACHE_SIZE; ++i) {
+        name[4] = '0' + i;
+        dns_cache_add(name, &addr_in, sizeof(addr_in), 10 + i);
+    }
+
+    /* a name that expires before all cached ones is not added */
+    name[4] = '0' + CONFIG_DNS_CACHE_SIZE;
+    dns_cache_add(name, &addr_in, sizeof(addr_in), 5);
+    TEST_ASSERT_EQUAL_INT(0, dns_cache_query(name, &addr_out, AF_INET6));
+    name[4] = '0';
+    TEST_ASSERT_EQUAL_INT(sizeof(addr_out), dns_cache_query(name, &addr_out, AF_INET6));
+
+    /* adding one that outlives host0 evicts host0 */
+    name[4] = '0' + CONFIG_DNS_CACHE_SIZE;
+    dns_cache_add(name, &addr_in, sizeof(addr_in), 20);
+
+    for (unsigned i = 0; i <= CONFIG_DNS_CACHE_SIZE; ++i) {
+        name[4] = '0' + i;
+        TEST_ASSERT_EQUAL_INT(i ? sizeof(addr_out) : 0,
+                              dns_cache_query(name, &addr_out, AF_INET6));
+    }
+
+    /* clean up */
+    for (unsigned i = 0; i <= CONFIG_DNS_CACHE_SIZE; ++i) {
+        name[4] = '0' + i;
+        dns_cache_add(name, &addr_in, sizeof(addr_in), 0);
+    }
+}
+
 Test *tests_dns_cache_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_dns_cache_add),
         new_TestFixture(test_dns_cache_add_ttl0),
+        new_TestFixture(test_dns_cache_a_aaaa),
+        new_TestFixture(test_dns_cache_evict),
     };
 
     EMB_UNIT_TESTCALLER(dns_cache_tests, NULL, NULL, fixtures);
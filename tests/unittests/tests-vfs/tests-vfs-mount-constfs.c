@@ -173,6 +173,36 @@ static void test_vfs_constfs_read_lseek(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void test_vfs_constfs_mmap(void)
+{
+    int res;
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    const void *addr = NULL;
+    size_t len = 0;
+    res = vfs_mmap(fd, &addr, &len);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    /* the content is provided in place */
+    TEST_ASSERT(addr == bin_data);
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data), len);
+
+    res = vfs_mmap(fd, NULL, &len);
+    TEST_ASSERT_EQUAL_INT(-EFAULT, res);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_mmap(fd, &addr, &len);
+    TEST_ASSERT_EQUAL_INT(-EBADF, res);
+
+    res = vfs_umount(&_test_vfs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
 #if MODULE_NEWLIB || MODULE_PICOLIBC || defined(BOARD_NATIVE)
 static void test_vfs_constfs__posix(void)
 {
@@ -212,6 +242,7 @@ Test *tests_vfs_mount_constfs_tests(void)
         new_TestFixture(test_vfs_umount__invalid_mount),
         new_TestFixture(test_vfs_constfs_open),
         new_TestFixture(test_vfs_constfs_read_lseek),
+        new_TestFixture(test_vfs_constfs_mmap),
 #if MODULE_NEWLIB || MODULE_PICOLIBC || defined(BOARD_NATIVE)
         new_TestFixture(test_vfs_constfs__posix),
 #endif
@@ -0,0 +1,139 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for RomFS
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#include "embUnit/embUnit.h"
+
+#include "vfs.h"
+#include "fs/romfs.h"
+
+#include "tests-vfs.h"
+
+/* created with dist/tools/romfs/mkromfs.py from a.txt ("hello") and
+ * b.bin ("xyz123") */
+static const uint32_t _image[] = {
+    0x53464d52, 0x00000002, 0x00000020, 0x0000002c,
+    0x00000005, 0x00000026, 0x00000034, 0x00000006,
+    0x78742e61, 0x2e620074, 0x006e6962, 0x6c6c6568,
+    0xffffff6f, 0x317a7978, 0x00003332,
+};
+#define IMAGE_SIZE  (0x3a)
+
+static romfs_desc_t _fs_desc;
+
+static vfs_mount_t _test_vfs_mount = {
+    .mount_point = "/test",
+    .fs = &romfs_file_system,
+    .private_data = &_fs_desc,
+};
+
+static void setup(void)
+{
+    _fs_desc = (romfs_desc_t) {
+        .image = _image,
+        .size = IMAGE_SIZE,
+    };
+}
+
+static void test_vfs_romfs_mount__invalid(void)
+{
+    /* image truncated in the middle of file data */
+    _fs_desc.size = IMAGE_SIZE - 1;
+    int res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(-EIO, res);
+
+    /* not a RomFS image */
+    _fs_desc.image = &_image[1];
+    res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(-ENODEV, res);
+}
+
+static void test_vfs_romfs_read_mmap(void)
+{
+    int res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    int fd = vfs_open("/test/notfound", O_RDONLY, 0);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, fd);
+    fd = vfs_open("/test/a.txt", O_RDWR, 0);
+    TEST_ASSERT_EQUAL_INT(-EROFS, fd);
+
+    fd = vfs_open("/test/b.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    char buf[8];
+    memset(buf, '\0', sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(2, vfs_lseek(fd, 2, SEEK_SET));
+    TEST_ASSERT_EQUAL_INT(4, vfs_read(fd, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("z123", buf);
+
+    const void *addr;
+    size_t len;
+    res = vfs_mmap(fd, &addr, &len);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT(addr == (const uint8_t *)_image + 0x34);
+    TEST_ASSERT_EQUAL_INT(6, len);
+
+    struct stat st;
+    res = vfs_fstat(fd, &st);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    TEST_ASSERT_EQUAL_INT(6, st.st_size);
+
+    res = vfs_close(fd);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    res = vfs_umount(&_test_vfs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+static void test_vfs_romfs_readdir(void)
+{
+    int res = vfs_mount(&_test_vfs_mount);
+    TEST_ASSERT_EQUAL_INT(0, res);
+
+    vfs_DIR dir;
+    vfs_dirent_t entry;
+    res = vfs_opendir(&dir, "/test");
+    TEST_ASSERT_EQUAL_INT(0, res);
+    res = vfs_readdir(&dir, &entry);
+    TEST_ASSERT_EQUAL_INT(1, res);
+    TEST_ASSERT_EQUAL_STRING("a.txt", entry.d_name);
+    res = vfs_readdir(&dir, &entry);
+    TEST_ASSERT_EQUAL_INT(1, res);
+    TEST_ASSERT_EQUAL_STRING("b.bin", entry.d_name);
+    res = vfs_readdir(&dir, &entry);
+    TEST_ASSERT_EQUAL_INT(0, res);
+    vfs_closedir(&dir);
+
+    res = vfs_umount(&_test_vfs_mount, false);
+    TEST_ASSERT_EQUAL_INT(0, res);
+}
+
+Test *tests_vfs_mount_romfs_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vfs_romfs_mount__invalid),
+        new_TestFixture(test_vfs_romfs_read_mmap),
+        new_TestFixture(test_vfs_romfs_readdir),
+    };
+
+    EMB_UNIT_TESTCALLER(vfs_romfs_tests, setup, NULL, fixtures);
+
+    return (Test *)&vfs_romfs_tests;
+}
+
+/** @} */